@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+set -e
+
+# 네이티브(g++/clang++)로 벤치마크를 빌드하고 실행한다. (CMakeLists.txt, WASM 빌드는 build.sh)
+# 기준 측정 결과는 build-native/bench_suite.json / .csv에도 저장한다.
+# 인자는 bench_suite에 그대로 넘긴다. (예: ./bench.sh --quick --threads 4)
+OUT_DIR=build-native
+
+cmake -S . -B ${OUT_DIR} -DCMAKE_BUILD_TYPE=Release
+cmake --build ${OUT_DIR} -j"$(nproc 2>/dev/null || echo 4)"
+
+${OUT_DIR}/bench_noise
+${OUT_DIR}/bench_threads
+${OUT_DIR}/bench_normals
+${OUT_DIR}/bench_suite --json ${OUT_DIR}/bench_suite.json --csv ${OUT_DIR}/bench_suite.csv "$@"
+
+# 같은 메쉬에서 지금의 JS 경로(Three.js computeVertexNormals)
+# WASM(web/planet.js) / 네이티브 / js_planet.js 배치 변형 비교 (결과가 다르면 실패)
+if command -v node >/dev/null 2>&1; then
+  node bench/bench_normals.mjs
+  node bench/bench_wasm.mjs --native ${OUT_DIR}/bench_displace --json ${OUT_DIR}/bench_wasm.json
+fi
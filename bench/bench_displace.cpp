@@ -0,0 +1,85 @@
+// bench_displace.cpp
+// -------------------------------------------------------------
+// bench_wasm.mjs(Node)가 부르는 네이티브 쪽 측정 도구.
+//
+// 파일에서 정점 버퍼([x, y, z, ...] float32)를 읽어
+// C API init_planet + apply_displacement_batch(WASM과 같은 함수)를 repeats번 돌리고,
+//   - 결과 버퍼를 out 파일에 쓰고 (WASM / JS 결과와 비교용)
+//   - 가장 빠른 한 번의 시간(ms)을 JSON 한 줄로 출력한다.
+// 버퍼를 원래 값으로 되돌리는 시간은 재지 않는다.
+//
+// 사용법: bench_displace <seed> <scale> <radius> <in.f32> <out.f32> [repeats] [threads]
+//   threads : apply_displacement_batch가 쓸 스레드 수 (기본 1, 0이면 하드웨어 스레드 수)
+//
+// 빌드: CMake (build-native/bench_displace), 실행: node bench/bench_wasm.mjs
+// -------------------------------------------------------------
+
+#include "../cpp/planet.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+bool readFloats(const char* path, std::vector<float>& out) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+    std::fseek(f, 0, SEEK_END);
+    long bytes = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    out.resize(static_cast<size_t>(bytes) / sizeof(float));
+    size_t read = std::fread(out.data(), sizeof(float), out.size(), f);
+    std::fclose(f);
+    return read == out.size();
+}
+
+bool writeFloats(const char* path, const std::vector<float>& data) {
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    size_t written = std::fwrite(data.data(), sizeof(float), data.size(), f);
+    std::fclose(f);
+    return written == data.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 6) {
+        std::fprintf(stderr, "usage: %s <seed> <scale> <radius> <in.f32> <out.f32> [repeats] [threads]\n", argv[0]);
+        return 2;
+    }
+    const int seed = std::atoi(argv[1]);
+    const float scale = static_cast<float>(std::atof(argv[2]));
+    const float radius = static_cast<float>(std::atof(argv[3]));
+    const int repeats = argc > 6 ? std::max(1, std::atoi(argv[6])) : 5;
+    const int threads = argc > 7 ? std::atoi(argv[7]) : 1;
+
+    std::vector<float> input;
+    if (!readFloats(argv[4], input) || input.size() % 3 != 0) {
+        std::fprintf(stderr, "cannot read %s\n", argv[4]);
+        return 1;
+    }
+    const int vertexCount = static_cast<int>(input.size() / 3);
+
+    set_thread_count(threads);
+    init_planet(seed, scale, radius);
+
+    std::vector<float> buffer;
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        buffer = input;
+        auto t0 = std::chrono::steady_clock::now();
+        apply_displacement_batch(buffer.data(), vertexCount);
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+
+    if (!writeFloats(argv[5], buffer)) {
+        std::fprintf(stderr, "cannot write %s\n", argv[5]);
+        return 1;
+    }
+    std::printf("{\"vertices\": %d, \"threads\": %d, \"ms\": %.4f}\n", vertexCount, get_thread_count(), best);
+    return 0;
+}
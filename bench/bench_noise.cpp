@@ -0,0 +1,343 @@
+// bench_noise.cpp
+// -------------------------------------------------------------
+// 노이즈 속도 비교.
+//
+// 1) 방식(Table / Hashed)별: 같은 점 묶음에 대해
+//      - perlin   (한 점씩)
+//      - perlin_batch
+//      - fbm      (한 점씩, 5 옥타브)
+//      - fbm_batch (5 옥타브)
+// 2) 종류(Perlin / Simplex)별: generateNoiseParams가 만드는 옥타브 수
+//    (fbm 2~5, ridged 1~3)에서 한 점씩 계산한 fbm / ridged_fbm
+// 3) 지형 세 층: 층마다 따로(fbm / fbm / ridged_fbm, 한 점씩) vs
+//    합쳐진 커널(terrain_layers, 한 점씩) vs 배치(terrain_layers_batch), 여러 seed
+//
+// 여러 번 돌려서 점 하나당 걸린 시간(ns)을 출력한다.
+//
+// --check: 속도 대신 값을 확인한다. (ctest의 terrain_layers_match)
+//   지형 세 층을 fbm / fbm / ridged_fbm으로 따로 계산한 값을 기준으로
+//   terrain_layers / terrain_layers_batch가
+//   층마다 1e-6 안에 드는지 seed 여러 개 x 방식(Table / Hashed) x 종류 조합에서 본다.
+//   같은 조합에서 층 캐시를 채우는 fbm_d_batch / ridged_fbm_d_batch도
+//   한 점씩 부른 fbm_d / ridged_fbm_d와 값 / 기울기가 같은지 본다. (기울기는 1보다 크면 상대 오차)
+//   하나라도 벗어나면 0이 아닌 값으로 끝난다.
+//   PLANET_SIMD로 고른 커널을 이 CPU가 지원하지 않으면 확인하지 않고 77(ctest의 건너뜀)로 끝난다.
+//
+// 빌드/실행: ./bench.sh
+// -------------------------------------------------------------
+
+#include "../cpp/noise.hpp"
+#include "../cpp/noise_params.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kPoints = 1 << 16;
+constexpr int kRepeats = 20;
+constexpr int kOctaves = 5;
+
+// 결과가 최적화로 사라지지 않도록 모아 두는 곳
+volatile float g_sink = 0.0f;
+
+// fn을 kRepeats번 실행하고 가장 빠른 한 번의 점당 시간(ns)을 돌려준다.
+template <class F>
+double measure(F fn) {
+    double best = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        best = std::min(best, ns / kPoints);
+    }
+    return best;
+}
+
+struct Points {
+    std::vector<float> xs, ys, zs;
+};
+
+// 행성 표면 근처 좌표 (get_height에 들어가는 값과 비슷한 범위)
+Points makePoints() {
+    Points p;
+    p.xs.resize(kPoints); p.ys.resize(kPoints); p.zs.resize(kPoints);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-8.0f, 8.0f);
+    for (size_t i = 0; i < kPoints; ++i) {
+        p.xs[i] = dist(rng); p.ys[i] = dist(rng); p.zs[i] = dist(rng);
+    }
+    return p;
+}
+
+void runBackend(const char* name, NoiseBackend backend, const Points& p) {
+    NoiseTable table;
+    initNoiseTable(table, 42u, backend);
+    std::vector<float> out(kPoints);
+
+    double perlinScalar = measure([&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < kPoints; ++i) s += perlin(table, p.xs[i], p.ys[i], p.zs[i]);
+        g_sink = s;
+    });
+    double perlinBatch = measure([&] {
+        perlin_batch(table, p.xs.data(), p.ys.data(), p.zs.data(), out.data(), kPoints);
+        g_sink = out[kPoints / 2];
+    });
+    double fbmScalar = measure([&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < kPoints; ++i) s += fbm(table, p.xs[i], p.ys[i], p.zs[i], kOctaves, 2.0f, 0.5f);
+        g_sink = s;
+    });
+    double fbmBatch = measure([&] {
+        fbm_batch(table, p.xs.data(), p.ys.data(), p.zs.data(), out.data(), kPoints, kOctaves, 2.0f, 0.5f);
+        g_sink = out[kPoints / 2];
+    });
+
+    std::printf("%-8s %12.2f %12.2f %12.2f %12.2f\n",
+                name, perlinScalar, perlinBatch, fbmScalar, fbmBatch);
+}
+
+// 종류(basis)별 fbm / ridged_fbm (한 점씩, Table 방식)
+void runBasis(const Points& p) {
+    NoiseTable table;
+    initNoiseTable(table, 42u);
+
+    std::printf("\n%-8s %-8s %12s %12s %8s\n", "layer", "octaves", "perlin", "simplex", "ratio");
+    for (int ridged = 0; ridged < 2; ++ridged) {
+        const int minOct = ridged ? 1 : 2;
+        const int maxOct = ridged ? 3 : 5;
+        for (int oct = minOct; oct <= maxOct; ++oct) {
+            double ns[2];
+            for (int b = 0; b < 2; ++b) {
+                NoiseBasis basis = b ? NoiseBasis::Simplex : NoiseBasis::Perlin;
+                ns[b] = measure([&] {
+                    float s = 0.0f;
+                    for (size_t i = 0; i < kPoints; ++i) {
+                        s += ridged ? ridged_fbm(table, p.xs[i], p.ys[i], p.zs[i], oct, 2.0f, 0.5f, basis)
+                                    : fbm(table, p.xs[i], p.ys[i], p.zs[i], oct, 2.0f, 0.5f, basis);
+                    }
+                    g_sink = s;
+                });
+            }
+            std::printf("%-8s %-8d %12.2f %12.2f %8.2f\n",
+                        ridged ? "ridged" : "fbm", oct, ns[0], ns[1], ns[0] / ns[1]);
+        }
+    }
+}
+
+// 층을 하나씩 따로 계산한 기준 값 (합치기 전 get_height와 같은 식)
+TerrainLayers separateLayers(const NoiseTable& table, const NoiseParams& p, float x, float y, float z) {
+    TerrainLayers l;
+    l.macro = fbm(table, x * p.macroFreq, y * p.macroFreq, z * p.macroFreq,
+                  p.macroOctaves, p.lacunarity, p.gain, p.macroBasis) * p.macroAmp;
+    l.micro = fbm(table, x * p.microFreq, y * p.microFreq, z * p.microFreq,
+                  p.microOctaves, p.lacunarity, p.gain, p.microBasis) * p.microAmp;
+    l.ridge = ridged_fbm(table, x * p.ridgeFreq, y * p.ridgeFreq, z * p.ridgeFreq,
+                         p.ridgeOctaves, p.lacunarity, p.gain, p.ridgeBasis) * p.ridgeAmp;
+    return l;
+}
+
+// 지형 세 층: 층마다 따로 vs 합쳐진 커널 vs 배치 (Table 방식)
+void runTerrainLayers(const Points& p) {
+    NoiseTable table;
+    initNoiseTable(table, 42u);
+
+    // 점 좌표를 단위 구 위로 옮긴다. (get_height 입력과 같은 범위)
+    std::vector<float> nx(kPoints), ny(kPoints), nz(kPoints);
+    for (size_t i = 0; i < kPoints; ++i) {
+        float len = std::sqrt(p.xs[i] * p.xs[i] + p.ys[i] * p.ys[i] + p.zs[i] * p.zs[i]);
+        nx[i] = p.xs[i] / len; ny[i] = p.ys[i] / len; nz[i] = p.zs[i] / len;
+    }
+    std::vector<float> macro(kPoints), micro(kPoints), ridge(kPoints);
+
+    std::printf("\n%-6s %-10s %12s %12s %12s %8s %8s\n",
+                "seed", "octaves", "separate", "fused", "batch", "sep/fus", "sep/bat");
+    for (uint32_t seed : { 1u, 7u, 42u, 1234u }) {
+        NoiseParams params = generateNoiseParams(seed);
+
+        double separate = measure([&] {
+            float s = 0.0f;
+            for (size_t i = 0; i < kPoints; ++i) {
+                TerrainLayers l = separateLayers(table, params, nx[i], ny[i], nz[i]);
+                s += l.macro + l.micro + l.ridge;
+            }
+            g_sink = s;
+        });
+        double fused = measure([&] {
+            float s = 0.0f;
+            for (size_t i = 0; i < kPoints; ++i) {
+                TerrainLayers l = terrain_layers(table, params, nx[i], ny[i], nz[i]);
+                s += l.macro + l.micro + l.ridge;
+            }
+            g_sink = s;
+        });
+        double batch = measure([&] {
+            terrain_layers_batch(table, params, nx.data(), ny.data(), nz.data(),
+                                 macro.data(), micro.data(), ridge.data(), kPoints);
+            g_sink = macro[kPoints / 2] + micro[kPoints / 2] + ridge[kPoints / 2];
+        });
+
+        char oct[16];
+        std::snprintf(oct, sizeof(oct), "%d/%d/%d", params.macroOctaves, params.microOctaves, params.ridgeOctaves);
+        std::printf("%-6u %-10s %12.2f %12.2f %12.2f %8.2f %8.2f\n",
+                    seed, oct, separate, fused, batch, separate / fused, separate / batch);
+    }
+}
+
+// ---------------- --check ----------------
+
+constexpr float kLayerTolerance = 1e-6f;
+
+// ctest의 SKIP_RETURN_CODE와 같은 값
+constexpr int kSkipped = 77;
+
+struct LayerDiff {
+    float macro = 0.0f, micro = 0.0f, ridge = 0.0f;
+
+    void add(const TerrainLayers& a, const TerrainLayers& b) {
+        macro = std::max(macro, std::fabs(a.macro - b.macro));
+        micro = std::max(micro, std::fabs(a.micro - b.micro));
+        ridge = std::max(ridge, std::fabs(a.ridge - b.ridge));
+    }
+    float max() const { return std::max(macro, std::max(micro, ridge)); }
+};
+
+// 층 하나를 fbm_d_batch / ridged_fbm_d_batch로 계산해서 fbm_d / ridged_fbm_d와의 최대 차이를 돌려준다.
+float derivDiff(const NoiseTable& table, const NoiseParams& params, float freq, int octaves, NoiseBasis basis,
+                bool ridged, const std::vector<float>& nx, const std::vector<float>& ny,
+                const std::vector<float>& nz) {
+    const size_t n = nx.size();
+    std::vector<float> sx(n), sy(n), sz(n), v(n), dx(n), dy(n), dz(n);
+    for (size_t i = 0; i < n; ++i) { sx[i] = nx[i] * freq; sy[i] = ny[i] * freq; sz[i] = nz[i] * freq; }
+    if (ridged) {
+        ridged_fbm_d_batch(table, sx.data(), sy.data(), sz.data(), v.data(), dx.data(), dy.data(), dz.data(), n,
+                           octaves, params.lacunarity, params.gain, basis);
+    } else {
+        fbm_d_batch(table, sx.data(), sy.data(), sz.data(), v.data(), dx.data(), dy.data(), dz.data(), n,
+                    octaves, params.lacunarity, params.gain, basis);
+    }
+
+    float diff = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        NoiseGrad ref = ridged ? ridged_fbm_d(table, sx[i], sy[i], sz[i], octaves, params.lacunarity, params.gain, basis)
+                               : fbm_d(table, sx[i], sy[i], sz[i], octaves, params.lacunarity, params.gain, basis);
+        const float got[4] = { v[i], dx[i], dy[i], dz[i] };
+        const float want[4] = { ref.value, ref.dx, ref.dy, ref.dz };
+        for (int k = 0; k < 4; ++k) {
+            diff = std::max(diff, std::fabs(got[k] - want[k]) / std::max(1.0f, std::fabs(want[k])));
+        }
+    }
+    return diff;
+}
+
+// 한 조합(table, params)에서 두 커널을 기준 값과 비교하고 한 줄 출력한다.
+bool checkCase(const char* backend, const char* basis, uint32_t seed, const NoiseTable& table,
+               const NoiseParams& params, const std::vector<float>& nx, const std::vector<float>& ny,
+               const std::vector<float>& nz) {
+    const size_t n = nx.size();
+    std::vector<float> macro(n), micro(n), ridge(n);
+    terrain_layers_batch(table, params, nx.data(), ny.data(), nz.data(), macro.data(), micro.data(), ridge.data(), n);
+
+    LayerDiff fused, batch;
+    for (size_t i = 0; i < n; ++i) {
+        TerrainLayers ref = separateLayers(table, params, nx[i], ny[i], nz[i]);
+        fused.add(terrain_layers(table, params, nx[i], ny[i], nz[i]), ref);
+        batch.add({ macro[i], micro[i], ridge[i] }, ref);
+    }
+
+    float deriv = derivDiff(table, params, params.macroFreq, params.macroOctaves, params.macroBasis, false, nx, ny, nz);
+    deriv = std::max(deriv, derivDiff(table, params, params.microFreq, params.microOctaves, params.microBasis, false,
+                                      nx, ny, nz));
+    deriv = std::max(deriv, derivDiff(table, params, params.ridgeFreq, params.ridgeOctaves, params.ridgeBasis, true,
+                                      nx, ny, nz));
+
+    const bool ok = fused.max() <= kLayerTolerance && batch.max() <= kLayerTolerance && deriv <= kLayerTolerance;
+    char oct[16];
+    std::snprintf(oct, sizeof(oct), "%d/%d/%d", params.macroOctaves, params.microOctaves, params.ridgeOctaves);
+    std::printf("%-7s %-8s %-6u %-8s %10.1e %10.1e %10.1e %s\n",
+                backend, basis, seed, oct, fused.max(), batch.max(), deriv, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+// terrain_layers 등이 층을 따로 계산한 값과 같은지 확인한다. (모두 맞으면 true)
+bool runCheck(const Points& p) {
+    constexpr size_t kCheckPoints = 4096;
+    std::vector<float> nx(kCheckPoints), ny(kCheckPoints), nz(kCheckPoints);
+    for (size_t i = 0; i < kCheckPoints; ++i) {
+        float len = std::sqrt(p.xs[i] * p.xs[i] + p.ys[i] * p.ys[i] + p.zs[i] * p.zs[i]);
+        nx[i] = p.xs[i] / len; ny[i] = p.ys[i] / len; nz[i] = p.zs[i] / len;
+    }
+
+    struct BasisSet {
+        const char* name;
+        NoiseBasis macro, micro, ridge;
+    };
+    const BasisSet bases[] = {
+        { "perlin", NoiseBasis::Perlin, NoiseBasis::Perlin, NoiseBasis::Perlin },
+        { "simplex", NoiseBasis::Simplex, NoiseBasis::Simplex, NoiseBasis::Simplex },
+        { "mixed", NoiseBasis::Perlin, NoiseBasis::Simplex, NoiseBasis::Perlin },
+    };
+
+    std::printf("max |layer - separate fbm/ridged_fbm|, tolerance %.0e, points %zu\n",
+                kLayerTolerance, kCheckPoints);
+    std::printf("%-7s %-8s %-6s %-8s %10s %10s %10s\n", "backend", "basis", "seed", "octaves",
+                "fused", "batch", "deriv");
+    bool ok = true;
+    for (int b = 0; b < 2; ++b) {
+        const NoiseBackend backend = b ? NoiseBackend::Hashed : NoiseBackend::Table;
+        for (uint32_t seed : { 1u, 7u, 42u, 1234u, 98765u }) {
+            NoiseTable table;
+            initNoiseTable(table, seed, backend);
+            for (const BasisSet& basis : bases) {
+                NoiseParams params = generateNoiseParams(seed);
+                params.macroBasis = basis.macro;
+                params.microBasis = basis.micro;
+                params.ridgeBasis = basis.ridge;
+                ok &= checkCase(b ? "hashed" : "table", basis.name, seed, table, params, nx, ny, nz);
+            }
+        }
+        // generateNoiseParams가 만들지 않는 옥타브 수와 층마다 크게 다른 옥타브 수
+        NoiseTable table;
+        initNoiseTable(table, 42u, backend);
+        NoiseParams params = generateNoiseParams(42u);
+        params.macroOctaves = 8;
+        params.microOctaves = 1;
+        params.ridgeOctaves = 6;
+        ok &= checkCase(b ? "hashed" : "table", "perlin", 42u, table, params, nx, ny, nz);
+    }
+    std::printf("%s\n", ok ? "all layers match" : "layer mismatch");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Points p = makePoints();
+
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) {
+        const char* forced = std::getenv("PLANET_SIMD");
+        if (forced && std::strcmp(forced, perlin_batch_kernel_name()) != 0) {
+            std::printf("PLANET_SIMD=%s: not supported here (kernel %s), skipped\n",
+                        forced, perlin_batch_kernel_name());
+            return kSkipped;
+        }
+        std::printf("kernel: %s\n", perlin_batch_kernel_name());
+        return runCheck(p) ? 0 : 1;
+    }
+
+    std::printf("kernel: %s, points: %zu, fbm octaves: %d (ns / point, best of %d)\n",
+                perlin_batch_kernel_name(), kPoints, kOctaves, kRepeats);
+    std::printf("%-8s %12s %12s %12s %12s\n", "backend", "perlin", "perlin_batch", "fbm", "fbm_batch");
+    runBackend("table", NoiseBackend::Table, p);
+    runBackend("hashed", NoiseBackend::Hashed, p);
+    runBasis(p);
+    runTerrainLayers(p);
+    return 0;
+}
@@ -0,0 +1,124 @@
+// bench_normals.cpp
+// -------------------------------------------------------------
+// 정점 법선 계산(computeVertexNormals) 측정.
+//
+// Three.js SphereGeometry와 같은 배치의 UV 구(정점 40k / 1M개)를 울퉁불퉁하게 만든 뒤
+//   - scatter : 삼각형마다 꼭짓점 세 개에 더하는 한 스레드 버전 (WASM 기본 경로)
+//   - gather  : VertexAdjacency로 정점마다 모으는 버전, 스레드 1, 2, 4, 8, 16개
+// 를 돌려 걸린 시간(ms)과 scatter 대비 속도를 출력한다.
+// gather 결과는 scatter 결과와 바이트 단위로 비교한다.
+//
+// 같은 메쉬에 대한 지금의 JS 경로(Three.js computeVertexNormals)는
+// bench/bench_normals.mjs가 Node로 측정한다.
+//
+// 빌드/실행: ./bench.sh
+// -------------------------------------------------------------
+
+#include "../cpp/mesh_normals.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const unsigned kThreadCounts[] = { 1, 2, 4, 8, 16 };
+const int kSegments[] = { 200, 1000 }; // (200 + 1)^2 = 40k, (1000 + 1)^2 = 1M 정점
+
+struct Mesh {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    size_t vertexCount() const { return positions.size() / 3; }
+};
+
+// Three.js SphereGeometry(1, segments, segments)와 같은 정점 / 삼각형 순서.
+// 높이는 bench_normals.mjs와 같은 식으로 흔들어서 변형된 행성처럼 만든다.
+Mesh makeSphere(int segments) {
+    const float pi = 3.14159265358979f;
+    Mesh mesh;
+    for (int iy = 0; iy <= segments; ++iy) {
+        float v = float(iy) / float(segments);
+        for (int ix = 0; ix <= segments; ++ix) {
+            float u = float(ix) / float(segments);
+            float x = -std::cos(u * 2.0f * pi) * std::sin(v * pi);
+            float y = std::cos(v * pi);
+            float z = std::sin(u * 2.0f * pi) * std::sin(v * pi);
+            float r = 1.0f + 0.05f * std::sin(7.0f * x) * std::sin(5.0f * y) * std::sin(3.0f * z);
+            mesh.positions.push_back(x * r);
+            mesh.positions.push_back(y * r);
+            mesh.positions.push_back(z * r);
+        }
+    }
+
+    const uint32_t row = uint32_t(segments) + 1;
+    for (int iy = 0; iy < segments; ++iy) {
+        for (int ix = 0; ix < segments; ++ix) {
+            uint32_t a = iy * row + ix + 1;
+            uint32_t b = iy * row + ix;
+            uint32_t c = (iy + 1) * row + ix;
+            uint32_t d = (iy + 1) * row + ix + 1;
+            if (iy != 0) mesh.indices.insert(mesh.indices.end(), { a, b, d });
+            if (iy != segments - 1) mesh.indices.insert(mesh.indices.end(), { b, c, d });
+        }
+    }
+    return mesh;
+}
+
+int repeatsFor(size_t n) {
+    return n <= 100000 ? 50 : 5;
+}
+
+template <typename Fn>
+double bestOf(int repeats, Fn&& fn) {
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    ThreadPool pool(1);
+    std::printf("hardware threads: %u\n\n", ThreadPool::hardwareThreads());
+    std::printf("%10s %-10s %8s %10s %8s %6s\n", "vertices", "method", "threads", "ms", "speedup", "same");
+
+    for (int segments : kSegments) {
+        const Mesh mesh = makeSphere(segments);
+        const size_t n = mesh.vertexCount();
+        const int repeats = repeatsFor(n);
+        std::vector<float> reference(n * 3);
+        std::vector<float> normals(n * 3);
+
+        double base = bestOf(repeats, [&] {
+            computeVertexNormals(mesh.positions.data(), n, mesh.indices.data(), mesh.indices.size(),
+                                 reference.data());
+        });
+        std::printf("%10zu %-10s %8u %10.2f %7.2fx %6s\n", n, "scatter", 1u, base, 1.0, "-");
+
+        VertexAdjacency adjacency;
+        double build = bestOf(repeats, [&] {
+            adjacency.build(mesh.indices.data(), mesh.indices.size(), n);
+        });
+        std::printf("%10zu %-10s %8u %10.2f %8s %6s\n", n, "adjacency", 1u, build, "-", "-");
+
+        for (unsigned threads : kThreadCounts) {
+            pool.resize(threads);
+            double best = bestOf(repeats, [&] {
+                computeVertexNormals(mesh.positions.data(), n, mesh.indices.data(), mesh.indices.size(),
+                                     adjacency, normals.data(), pool);
+            });
+            bool same = std::memcmp(normals.data(), reference.data(), normals.size() * sizeof(float)) == 0;
+            std::printf("%10zu %-10s %8u %10.2f %7.2fx %6s\n",
+                        n, "gather", threads, best, base / best, same ? "yes" : "NO");
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
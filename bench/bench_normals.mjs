@@ -0,0 +1,117 @@
+// bench_normals.mjs
+// -------------------------------------------------------------
+// 지금의 JS 경로(Three.js BufferGeometry.computeVertexNormals, index 있는 경우) 측정.
+// bench_normals.cpp와 같은 UV 구(정점 40k / 1M개)에서 걸린 시간(ms)을 출력한다.
+//
+// Node에는 three 패키지가 없으므로 computeVertexNormals의 index 경로를
+// 그대로 옮긴 코드(Vector3 + BufferAttribute 읽기/쓰기)로 측정한다.
+//
+// 실행: node bench/bench_normals.mjs (./bench.sh가 node가 있으면 같이 실행)
+// -------------------------------------------------------------
+
+const SEGMENTS = [200, 1000];
+
+class Vector3 {
+  constructor(x = 0, y = 0, z = 0) { this.x = x; this.y = y; this.z = z; }
+  set(x, y, z) { this.x = x; this.y = y; this.z = z; return this; }
+  fromArray(a, i) { return this.set(a[i * 3], a[i * 3 + 1], a[i * 3 + 2]); }
+  add(v) { this.x += v.x; this.y += v.y; this.z += v.z; return this; }
+  subVectors(a, b) { return this.set(a.x - b.x, a.y - b.y, a.z - b.z); }
+  cross(v) {
+    const ax = this.x, ay = this.y, az = this.z;
+    return this.set(ay * v.z - az * v.y, az * v.x - ax * v.z, ax * v.y - ay * v.x);
+  }
+  length() { return Math.sqrt(this.x * this.x + this.y * this.y + this.z * this.z); }
+  normalize() {
+    const len = this.length() || 1;
+    return this.set(this.x / len, this.y / len, this.z / len);
+  }
+}
+
+// Three.js SphereGeometry(1, segments, segments)와 같은 정점 / 삼각형 순서
+function makeSphere(segments) {
+  const positions = new Float32Array((segments + 1) * (segments + 1) * 3);
+  let p = 0;
+  for (let iy = 0; iy <= segments; iy++) {
+    const v = iy / segments;
+    for (let ix = 0; ix <= segments; ix++) {
+      const u = ix / segments;
+      const x = -Math.cos(u * 2 * Math.PI) * Math.sin(v * Math.PI);
+      const y = Math.cos(v * Math.PI);
+      const z = Math.sin(u * 2 * Math.PI) * Math.sin(v * Math.PI);
+      const r = 1 + 0.05 * Math.sin(7 * x) * Math.sin(5 * y) * Math.sin(3 * z);
+      positions[p++] = x * r;
+      positions[p++] = y * r;
+      positions[p++] = z * r;
+    }
+  }
+
+  const indices = [];
+  const row = segments + 1;
+  for (let iy = 0; iy < segments; iy++) {
+    for (let ix = 0; ix < segments; ix++) {
+      const a = iy * row + ix + 1;
+      const b = iy * row + ix;
+      const c = (iy + 1) * row + ix;
+      const d = (iy + 1) * row + ix + 1;
+      if (iy !== 0) indices.push(a, b, d);
+      if (iy !== segments - 1) indices.push(b, c, d);
+    }
+  }
+  return { positions, indices: new Uint32Array(indices) };
+}
+
+// BufferAttribute.setXYZ
+function setXYZ(array, index, v) {
+  array[index * 3] = v.x;
+  array[index * 3 + 1] = v.y;
+  array[index * 3 + 2] = v.z;
+}
+
+// BufferGeometry.computeVertexNormals (index 경로)
+function computeVertexNormals(positions, indices, normals) {
+  const pA = new Vector3(), pB = new Vector3(), pC = new Vector3();
+  const nA = new Vector3(), nB = new Vector3(), nC = new Vector3();
+  const cb = new Vector3(), ab = new Vector3();
+
+  normals.fill(0);
+  for (let i = 0, il = indices.length; i < il; i += 3) {
+    const vA = indices[i], vB = indices[i + 1], vC = indices[i + 2];
+    pA.fromArray(positions, vA);
+    pB.fromArray(positions, vB);
+    pC.fromArray(positions, vC);
+
+    cb.subVectors(pC, pB);
+    ab.subVectors(pA, pB);
+    cb.cross(ab);
+
+    nA.fromArray(normals, vA).add(cb);
+    nB.fromArray(normals, vB).add(cb);
+    nC.fromArray(normals, vC).add(cb);
+    setXYZ(normals, vA, nA);
+    setXYZ(normals, vB, nB);
+    setXYZ(normals, vC, nC);
+  }
+
+  // normalizeNormals
+  const n = new Vector3();
+  for (let i = 0, il = normals.length / 3; i < il; i++) {
+    setXYZ(normals, i, n.fromArray(normals, i).normalize());
+  }
+}
+
+console.log(`${'vertices'.padStart(10)} ${'method'.padEnd(10)} ${'ms'.padStart(10)}`);
+for (const segments of SEGMENTS) {
+  const { positions, indices } = makeSphere(segments);
+  const count = positions.length / 3;
+  const normals = new Float32Array(positions.length);
+  const repeats = count <= 100000 ? 50 : 5;
+
+  let best = Infinity;
+  for (let r = 0; r < repeats; r++) {
+    const t0 = performance.now();
+    computeVertexNormals(positions, indices, normals);
+    best = Math.min(best, performance.now() - t0);
+  }
+  console.log(`${String(count).padStart(10)} ${'js'.padEnd(10)} ${best.toFixed(2).padStart(10)}`);
+}
@@ -0,0 +1,377 @@
+// bench_suite.cpp
+// -------------------------------------------------------------
+// 기준(baseline) 벤치마크: 최적화 전후를 같은 조건으로 비교하기 위한 측정 묶음.
+//
+// seed 여러 개 x 버퍼 크기 여러 개에 대해 점 하나당 시간(ns / sample)을 잰다.
+//   perlin                   : perlin(table, ...) 한 점씩
+//   fbm                      : fbm(table, ...) 한 점씩 (seed의 micro 층 주파수 / 옥타브)
+//   ridged_fbm               : ridged_fbm(table, ...) 한 점씩 (seed의 ridge 층 주파수 / 옥타브)
+//   get_height               : C API get_height (JS가 부르는 것과 같은 함수)
+//   apply_displacement_batch : C API apply_displacement_batch (공유 스레드 풀 사용)
+//   mesh_displace            : C API mesh_displace, 층 캐시를 비운 상태에서 (세 층 노이즈 + 기울기,
+//                              위치 / 법선 / 색까지 계산하므로 apply_displacement_batch보다 하는 일이 많다)
+// 점은 단위 구 위의 피보나치 점이다. (get_height 입력과 같은 범위)
+//
+// 측정마다 여러 번 돌려 가장 빠른 값(min)과 가운데 값(median)을 쓴다.
+// 결과는 표로 출력하고, 원하면 JSON / CSV 파일로도 쓴다. ('-'이면 표 대신 표준 출력)
+//
+// PLANET_PERF_COUNTERS=ON으로 빌드했으면 측정마다 get_perf_counters를 읽어서
+// 측정 종류별 계수기(점 하나당)와 단계별 시간 비율을 표 아래에 출력하고,
+// JSON에는 결과마다 "perf"(get_perf_counters 값 22개, 반복 전체 합계)를 넣는다.
+// 계수기를 켜면 시간이 느려지므로 ns 값은 꺼진 빌드끼리만 비교한다.
+//
+// 사용법: bench_suite [--quick] [--threads N] [--json FILE] [--csv FILE]
+//   --quick     : 작은 버퍼 두 개와 적은 반복 (빠른 확인용)
+//   --threads N : apply_displacement_batch가 쓸 스레드 수 (기본 1, 0이면 하드웨어 스레드 수)
+//
+// 빌드/실행: ./bench.sh (CMake, build-native/bench_suite)
+// -------------------------------------------------------------
+
+#include "../cpp/noise.hpp"
+#include "../cpp/noise_params.hpp"
+#include "../cpp/perf_counters.hpp"
+#include "../cpp/planet.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint32_t kSeeds[] = { 1u, 42u, 1234u, 98765u };
+const size_t kSizes[] = { 1024, 16384, 262144, 1048576 };
+const size_t kQuickSizes[] = { 1024, 16384 };
+
+// 결과가 최적화로 사라지지 않도록 모아 두는 곳
+volatile float g_sink = 0.0f;
+
+struct Options {
+    bool quick = false;
+    int threads = 1;
+    const char* json = nullptr;
+    const char* csv = nullptr;
+};
+
+struct Result {
+    std::string bench;
+    uint32_t seed;
+    size_t samples;
+    int octaves;     // fbm / ridged_fbm의 옥타브 수 (나머지는 0)
+    int repeats;
+    double nsMin;    // 점 하나당 ns (가장 빠른 한 번)
+    double nsMedian; // 점 하나당 ns (가운데 값)
+    std::vector<double> perf; // get_perf_counters 값 (반복 전체 합계, 꺼진 빌드면 비어 있음)
+};
+
+// 단위 구 위의 점 n개 (피보나치 구), SoA
+struct Points {
+    std::vector<float> xs, ys, zs;
+};
+
+Points makeSphere(size_t n) {
+    Points p;
+    p.xs.resize(n); p.ys.resize(n); p.zs.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        float t = (float(i) + 0.5f) / float(n);
+        float y = 1.0f - 2.0f * t;
+        float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float a = 2.39996323f * float(i);
+        p.xs[i] = r * std::cos(a);
+        p.ys[i] = y;
+        p.zs[i] = r * std::sin(a);
+    }
+    return p;
+}
+
+// 한 번에 최소 이 시간(초)만큼은 돌리고, 반복 횟수는 [minRepeats, maxRepeats]로 맞춘다.
+struct Budget {
+    double seconds;
+    int minRepeats;
+    int maxRepeats;
+};
+
+// fn을 여러 번 실행해 점 하나당 ns의 min / median을 result에 쓴다.
+// prepare는 시간에 넣지 않는다. (버퍼를 원래 값으로 되돌리는 등)
+template <class Prepare, class F>
+void measure(const Budget& budget, size_t samples, Prepare prepare, F fn, Result& result) {
+    std::vector<double> runs;
+    double total = 0.0;
+    reset_perf_counters();
+    while (static_cast<int>(runs.size()) < budget.maxRepeats &&
+           (static_cast<int>(runs.size()) < budget.minRepeats || total < budget.seconds)) {
+        prepare();
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double s = std::chrono::duration<double>(t1 - t0).count();
+        total += s;
+        runs.push_back(s * 1e9 / static_cast<double>(samples));
+    }
+    std::sort(runs.begin(), runs.end());
+    result.repeats = static_cast<int>(runs.size());
+    result.nsMin = runs.front();
+    result.nsMedian = runs[runs.size() / 2];
+
+    double perf[kPerfValueCount];
+    const int count = get_perf_counters(perf);
+    result.perf.assign(perf, perf + count);
+}
+
+template <class F>
+void measure(const Budget& budget, size_t samples, F fn, Result& result) {
+    measure(budget, samples, [] {}, fn, result);
+}
+
+void runSeed(uint32_t seed, size_t n, const Points& p, const Budget& budget, std::vector<Result>& results) {
+    NoiseTable table;
+    initNoiseTable(table, seed);
+    const NoiseParams params = generateNoiseParams(seed);
+
+    // 층 주파수를 곱한 좌표 (PlanetGenerator가 노이즈에 넘기는 값과 같은 범위)
+    std::vector<float> mx(n), my(n), mz(n), rx(n), ry(n), rz(n);
+    for (size_t i = 0; i < n; ++i) {
+        mx[i] = p.xs[i] * params.microFreq; my[i] = p.ys[i] * params.microFreq; mz[i] = p.zs[i] * params.microFreq;
+        rx[i] = p.xs[i] * params.ridgeFreq; ry[i] = p.ys[i] * params.ridgeFreq; rz[i] = p.zs[i] * params.ridgeFreq;
+    }
+
+    Result r{ "perlin", seed, n, 0, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < n; ++i) s += perlin(table, mx[i], my[i], mz[i]);
+        g_sink = s;
+    }, r);
+    results.push_back(r);
+
+    r = { "fbm", seed, n, params.microOctaves, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < n; ++i)
+            s += fbm(table, mx[i], my[i], mz[i], params.microOctaves, params.lacunarity, params.gain);
+        g_sink = s;
+    }, r);
+    results.push_back(r);
+
+    r = { "ridged_fbm", seed, n, params.ridgeOctaves, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < n; ++i)
+            s += ridged_fbm(table, rx[i], ry[i], rz[i], params.ridgeOctaves, params.lacunarity, params.gain);
+        g_sink = s;
+    }, r);
+    results.push_back(r);
+
+    // C API (전역 생성기)
+    init_planet(static_cast<int>(seed), 0.5f, 1.0f);
+
+    r = { "get_height", seed, n, 0, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        float s = 0.0f;
+        for (size_t i = 0; i < n; ++i) s += get_height(p.xs[i], p.ys[i], p.zs[i]);
+        g_sink = s;
+    }, r);
+    results.push_back(r);
+
+    std::vector<float> buffer(n * 3);
+    r = { "apply_displacement_batch", seed, n, 0, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i * 3] = p.xs[i];
+            buffer[i * 3 + 1] = p.ys[i];
+            buffer[i * 3 + 2] = p.zs[i];
+        }
+    }, [&] {
+        apply_displacement_batch(buffer.data(), static_cast<int>(n));
+        g_sink = buffer[n / 2];
+    }, r);
+    results.push_back(r);
+
+    // 방향을 다시 저장하면 층 캐시가 비므로 매번 세 층을 모두 새로 계산한다.
+    mesh_resize(static_cast<int>(n));
+    r = { "mesh_displace", seed, n, 0, 0, 0.0, 0.0, {} };
+    measure(budget, n, [&] {
+        float* positions = mesh_positions();
+        for (size_t i = 0; i < n; ++i) {
+            positions[i * 3] = p.xs[i];
+            positions[i * 3 + 1] = p.ys[i];
+            positions[i * 3 + 2] = p.zs[i];
+        }
+        mesh_capture_directions();
+    }, [&] {
+        g_sink = static_cast<float>(mesh_displace());
+    }, r);
+    results.push_back(r);
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(a, "--quick") == 0) opt.quick = true;
+        else if (std::strcmp(a, "--threads") == 0 && hasValue) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(a, "--json") == 0 && hasValue) opt.json = argv[++i];
+        else if (std::strcmp(a, "--csv") == 0 && hasValue) opt.csv = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: %s [--quick] [--threads N] [--json FILE] [--csv FILE]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+const char* buildType() {
+#ifdef NDEBUG
+    return "release";
+#else
+    return "debug";
+#endif
+}
+
+// path가 "-"이면 표준 출력
+FILE* openOutput(const char* path) {
+    if (std::strcmp(path, "-") == 0) return stdout;
+    FILE* f = std::fopen(path, "w");
+    if (!f) std::fprintf(stderr, "cannot open %s\n", path);
+    return f;
+}
+
+void closeOutput(FILE* f) {
+    if (f && f != stdout) std::fclose(f);
+}
+
+void writeJson(FILE* f, const std::vector<Result>& results, int threads) {
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"compiler\": \"%s\",\n", compilerName());
+    std::fprintf(f, "  \"build\": \"%s\",\n", buildType());
+    std::fprintf(f, "  \"batch_kernel\": \"%s\",\n", perlin_batch_kernel_name());
+    std::fprintf(f, "  \"threads\": %d,\n", threads);
+    std::fprintf(f, "  \"hardware_threads\": %u,\n", ThreadPool::hardwareThreads());
+    std::fprintf(f, "  \"perf_counters\": %s,\n", PLANET_PERF_COUNTERS ? "true" : "false");
+    std::fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "    {\"bench\": \"%s\", \"seed\": %u, \"samples\": %zu, \"octaves\": %d, "
+                        "\"repeats\": %d, \"ns_per_sample\": %.4f, \"ns_per_sample_median\": %.4f",
+                     r.bench.c_str(), r.seed, r.samples, r.octaves, r.repeats, r.nsMin, r.nsMedian);
+        if (!r.perf.empty()) {
+            std::fprintf(f, ", \"perf\": [");
+            for (size_t k = 0; k < r.perf.size(); ++k) std::fprintf(f, "%s%.0f", k ? ", " : "", r.perf[k]);
+            std::fprintf(f, "]");
+        }
+        std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+
+void writeCsv(FILE* f, const std::vector<Result>& results) {
+    std::fprintf(f, "bench,seed,samples,octaves,repeats,ns_per_sample,ns_per_sample_median\n");
+    for (const Result& r : results) {
+        std::fprintf(f, "%s,%u,%zu,%d,%d,%.4f,%.4f\n",
+                     r.bench.c_str(), r.seed, r.samples, r.octaves, r.repeats, r.nsMin, r.nsMedian);
+    }
+}
+
+void writeTable(const std::vector<Result>& results, int threads) {
+    std::printf("%s, %s, batch kernel: %s, threads: %d (ns / sample)\n",
+                compilerName(), buildType(), perlin_batch_kernel_name(), threads);
+    std::printf("%-26s %8s %9s %4s %7s %10s %10s\n", "bench", "seed", "samples", "oct", "repeats", "min", "median");
+    for (const Result& r : results) {
+        std::printf("%-26s %8u %9zu %4d %7d %10.2f %10.2f\n",
+                    r.bench.c_str(), r.seed, r.samples, r.octaves, r.repeats, r.nsMin, r.nsMedian);
+    }
+}
+
+// 측정 종류별 계수기 / 단계 시간 (PLANET_PERF_COUNTERS 빌드에서만 값이 있다)
+// 계수기는 점 하나당 평균(seed / 버퍼 크기 / 반복 전체), 단계는 단계 시간 합에서 차지하는 비율(%)
+void writePerfTable(const std::vector<Result>& results) {
+    static const char* const kCounterNames[kPerfCounterCount] = {
+        "noise", "macro", "micro", "ridge", "verts", "height",
+    };
+    static const char* const kStageNames[kPerfStageCount] = {
+        "norm%", "macro%", "micro%", "ridge%", "layers%", "comb%", "write%", "mask%",
+    };
+
+    std::vector<std::string> benches;
+    for (const Result& r : results) {
+        if (!r.perf.empty() && std::find(benches.begin(), benches.end(), r.bench) == benches.end())
+            benches.push_back(r.bench);
+    }
+    if (benches.empty()) return;
+
+    std::printf("\nperf counters (per sample) / stage time (%% of timed stages)\n%-26s", "bench");
+    for (const char* name : kCounterNames) std::printf(" %7s", name);
+    for (const char* name : kStageNames) std::printf(" %7s", name);
+    std::printf("\n");
+
+    for (const std::string& bench : benches) {
+        double sum[kPerfValueCount] = {};
+        double samples = 0.0;
+        for (const Result& r : results) {
+            if (r.bench != bench || r.perf.empty()) continue;
+            for (int k = 0; k < kPerfValueCount; ++k) sum[k] += r.perf[k];
+            samples += static_cast<double>(r.samples) * r.repeats;
+        }
+        const double* stageNs = sum + kPerfCounterCount;
+        double stageTotal = 0.0;
+        for (int k = 0; k < kPerfStageCount; ++k) stageTotal += stageNs[k];
+
+        std::printf("%-26s", bench.c_str());
+        for (int k = 0; k < kPerfCounterCount; ++k) std::printf(" %7.2f", sum[k] / samples);
+        for (int k = 0; k < kPerfStageCount; ++k)
+            std::printf(" %7.1f", stageTotal > 0.0 ? 100.0 * stageNs[k] / stageTotal : 0.0);
+        std::printf("\n");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    set_thread_count(opt.threads);
+    const int threads = get_thread_count();
+
+    const Budget budget = opt.quick ? Budget{ 0.02, 2, 5 } : Budget{ 0.25, 5, 50 };
+    std::vector<size_t> sizes = opt.quick ? std::vector<size_t>(std::begin(kQuickSizes), std::end(kQuickSizes))
+                                          : std::vector<size_t>(std::begin(kSizes), std::end(kSizes));
+
+    std::vector<Result> results;
+    for (size_t n : sizes) {
+        const Points p = makeSphere(n);
+        for (uint32_t seed : kSeeds) runSeed(seed, n, p, budget, results);
+    }
+
+    const bool jsonToStdout = opt.json && std::strcmp(opt.json, "-") == 0;
+    const bool csvToStdout = opt.csv && std::strcmp(opt.csv, "-") == 0;
+    if (!jsonToStdout && !csvToStdout) {
+        writeTable(results, threads);
+        writePerfTable(results);
+    }
+
+    int status = 0;
+    if (opt.json) {
+        FILE* f = openOutput(opt.json);
+        if (f) writeJson(f, results, threads); else status = 1;
+        closeOutput(f);
+    }
+    if (opt.csv) {
+        FILE* f = openOutput(opt.csv);
+        if (f) writeCsv(f, results); else status = 1;
+        closeOutput(f);
+    }
+    return status;
+}
@@ -0,0 +1,88 @@
+// bench_threads.cpp
+// -------------------------------------------------------------
+// applyDisplacement 멀티스레드 확장성(scaling) 측정.
+//
+// 정점 40k / 1M / 16M개 버퍼에 대해 스레드 1, 2, 4, 8, 16개로
+// PlanetGenerator::applyDisplacement(buffer, n, pool)을 돌려
+//   - 걸린 시간(ms), 초당 정점 수(M/s), 1스레드 대비 속도
+// 를 출력한다.
+// 모든 결과 버퍼를 1스레드 결과와 바이트 단위로 비교해서 결정성(determinism)도 확인한다.
+//
+// 빌드/실행: ./bench.sh
+// -------------------------------------------------------------
+
+#include "../cpp/planet.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const unsigned kThreadCounts[] = { 1, 2, 4, 8, 16 };
+const size_t kVertexCounts[] = { 40000, 1000000, 16000000 };
+
+// 단위 구 위의 점 n개 (피보나치 구)
+std::vector<float> makeSphere(size_t n) {
+    std::vector<float> v(n * 3);
+    for (size_t i = 0; i < n; ++i) {
+        float t = (float(i) + 0.5f) / float(n);
+        float y = 1.0f - 2.0f * t;
+        float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float a = 2.39996323f * float(i);
+        v[i * 3] = r * std::cos(a);
+        v[i * 3 + 1] = y;
+        v[i * 3 + 2] = r * std::sin(a);
+    }
+    return v;
+}
+
+// 큰 버퍼는 반복 횟수를 줄인다. (가장 빠른 한 번을 쓴다)
+int repeatsFor(size_t n) {
+    if (n <= 100000) return 20;
+    if (n <= 2000000) return 5;
+    return 2;
+}
+
+} // namespace
+
+int main() {
+    PlanetGenerator planet(42, 0.5f, 1.0f);
+    ThreadPool pool(1);
+
+    std::printf("hardware threads: %u\n\n", ThreadPool::hardwareThreads());
+    std::printf("%10s %8s %10s %10s %8s %6s\n", "vertices", "threads", "ms", "Mvert/s", "speedup", "same");
+
+    for (size_t n : kVertexCounts) {
+        const std::vector<float> sphere = makeSphere(n);
+        std::vector<float> buffer(sphere.size());
+        std::vector<float> reference;
+        double base = 0.0;
+
+        for (unsigned threads : kThreadCounts) {
+            pool.resize(threads);
+
+            double best = 1e30;
+            for (int r = 0; r < repeatsFor(n); ++r) {
+                buffer = sphere;
+                auto t0 = std::chrono::steady_clock::now();
+                planet.applyDisplacement(buffer.data(), n, pool);
+                auto t1 = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double, std::milli>(t1 - t0).count());
+            }
+
+            if (reference.empty()) {
+                reference = buffer;
+                base = best;
+            }
+            bool same = std::memcmp(buffer.data(), reference.data(), buffer.size() * sizeof(float)) == 0;
+
+            std::printf("%10zu %8u %10.2f %10.2f %7.2fx %6s\n",
+                        n, threads, best, n / best / 1000.0, base / best, same ? "yes" : "NO");
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
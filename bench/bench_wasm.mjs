@@ -0,0 +1,255 @@
+// bench_wasm.mjs
+// -------------------------------------------------------------
+// 브라우저 없이(Node) WASM / 네이티브 / 순수 JS(js_planet.js)의 배치 변형을 비교한다.
+// main.js의 measureLatency(주석 처리됨)를 대신한다.
+//
+// seed 여러 개 x 정점 수 여러 개에 대해 같은 입력 버퍼(피보나치 구)로
+//   wasm   : emscripten 모듈의 _init_planet + _apply_displacement_batch
+//            (HEAPF32로 복사하는 시간은 재지 않는다)
+//            기본은 web/ 아래 빌드 변형 전부(WASM_VARIANTS), 없는 파일은 건너뛰고 표 위에 알린다.
+//            첫 번째 모듈이 기준이고, 나머지는 기준 대비 속도(x)와 위치 차이를 같이 출력한다.
+//            pthread 모듈(_set_thread_count가 있음)은 코어 수만큼(최대 4) 스레드를 쓴다.
+//   native : build-native/bench_displace (같은 C API, 있으면)
+//   js     : js_planet.js의 PlanetGeneratorJS.applyDisplacementBatch
+// 를 여러 번 돌려 가장 빠른 시간(ms)과 초당 정점 수를 출력한다.
+// 결과 위치는 기준 WASM 결과와 비교해서 최대 차이가 tolerance보다 크면 실패(exit 1)로 끝난다.
+//
+// 사용법: node bench/bench_wasm.mjs [--quick] [--wasm FILE]... [--native FILE] [--json FILE]
+//   --wasm   : emscripten 모듈 (여러 번 줄 수 있음, 처음 것이 기준. 주면 WASM_VARIANTS 대신 이것만 잰다)
+//   --native : bench_displace 실행 파일 (기본 build-native/bench_displace, 없으면 건너뜀)
+//   --json   : 결과를 JSON 파일로도 쓴다 ('-'이면 표 대신 표준 출력)
+// -------------------------------------------------------------
+
+import { execFileSync } from 'node:child_process';
+import { existsSync, mkdtempSync, readFileSync, rmSync, writeFileSync } from 'node:fs';
+import { availableParallelism, tmpdir } from 'node:os';
+import { basename, dirname, join, resolve } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+import { PlanetGeneratorJS } from '../js_planet.js';
+
+const ROOT = resolve(dirname(fileURLToPath(import.meta.url)), '..');
+
+const SEEDS = [1, 42, 1234, 98765];
+const VERTEX_COUNTS = [1024, 16384, 262144, 1048576];
+const QUICK_VERTEX_COUNTS = [1024, 16384];
+const SCALE = 0.5;
+const RADIUS = 1.0;
+const TOLERANCE = 1e-4; // float(C++) vs double(JS) 위치 차이 허용값
+
+// build.sh가 만드는 빌드 변형 (처음 것이 기준, main.js의 loadWasmModule과 같은 파일)
+const WASM_VARIANTS = ['web/planet.js', 'web/planet_simd.js', 'web/planet_mt.js'];
+
+function parseArgs(argv) {
+  const opt = {
+    quick: false,
+    wasm: [],
+    native: join(ROOT, 'build-native/bench_displace'),
+    json: null
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const a = argv[i];
+    if (a === '--quick') opt.quick = true;
+    else if (a === '--wasm' && i + 1 < argv.length) opt.wasm.push(resolve(argv[++i]));
+    else if (a === '--native' && i + 1 < argv.length) opt.native = resolve(argv[++i]);
+    else if (a === '--json' && i + 1 < argv.length) opt.json = argv[++i];
+    else {
+      console.error('usage: node bench/bench_wasm.mjs [--quick] [--wasm FILE]... [--native FILE] [--json FILE]');
+      process.exit(2);
+    }
+  }
+  if (opt.wasm.length === 0) opt.wasm = WASM_VARIANTS.map((file) => join(ROOT, file));
+  return opt;
+}
+
+// 있는 모듈만 불러온다. 없는 파일은 missing에 모아 두고 알린다. (기준 모듈이 없으면 실패)
+async function loadVariants(files) {
+  const variants = [];
+  const missing = [];
+  for (const file of files) {
+    if (!existsSync(file)) {
+      missing.push(file);
+      continue;
+    }
+    const { default: createModule } = await import(pathToFileURL(file).href);
+    const module = await createModule();
+    let threads = 1;
+    if (typeof module._set_thread_count === 'function') {
+      // Node 20에는 navigator가 없어 build.sh의 PTHREAD_POOL_SIZE가 4가 된다.
+      // 미리 만든 Worker보다 많이 쓰면 메인 스레드가 기다리는 동안 새 Worker를 띄우지 못해 멈춘다.
+      module._set_thread_count(Math.min(availableParallelism(), 4));
+      threads = module._get_thread_count();
+    }
+    variants.push({ name: basename(file, '.js'), file, module, threads });
+  }
+  if (variants.length === 0 || !existsSync(files[0])) {
+    console.error(`reference module not found: ${files[0]} (run ./build.sh)`);
+    process.exit(1);
+  }
+  return { variants, missing };
+}
+
+// 단위 구 위의 점 n개 (피보나치 구, bench_suite.cpp와 같은 배치)
+function makeSphere(n) {
+  const v = new Float32Array(n * 3);
+  for (let i = 0; i < n; i++) {
+    const t = (i + 0.5) / n;
+    const y = 1 - 2 * t;
+    const r = Math.sqrt(Math.max(0, 1 - y * y));
+    const a = 2.39996323 * i;
+    v[i * 3] = r * Math.cos(a);
+    v[i * 3 + 1] = y;
+    v[i * 3 + 2] = r * Math.sin(a);
+  }
+  return v;
+}
+
+// 큰 버퍼는 반복 횟수를 줄인다. (가장 빠른 한 번을 쓴다)
+function repeatsFor(n, quick) {
+  if (quick) return 2;
+  if (n <= 20000) return 20;
+  if (n <= 300000) return 5;
+  return 3;
+}
+
+// prepare(시간에 넣지 않음) 뒤 run을 repeats번 돌려 가장 빠른 ms
+function best(repeats, prepare, run) {
+  let ms = Infinity;
+  for (let r = 0; r < repeats; r++) {
+    prepare();
+    const t0 = performance.now();
+    run();
+    ms = Math.min(ms, performance.now() - t0);
+  }
+  return ms;
+}
+
+function maxDiff(a, b) {
+  let d = 0;
+  for (let i = 0; i < a.length; i++) d = Math.max(d, Math.abs(a[i] - b[i]));
+  return d;
+}
+
+function runWasm(module, input, seed, repeats) {
+  const n = input.length / 3;
+  const ptr = module._malloc(input.byteLength);
+  module._init_planet(seed, SCALE, RADIUS);
+  const ms = best(repeats,
+    () => module.HEAPF32.set(input, ptr >> 2),
+    () => module._apply_displacement_batch(ptr, n));
+  const out = module.HEAPF32.slice(ptr >> 2, (ptr >> 2) + input.length);
+  module._free(ptr);
+  return { ms, out };
+}
+
+function runJs(generator, input, seed, repeats) {
+  const n = input.length / 3;
+  const out = new Float32Array(input.length);
+  generator.init(seed);
+  const ms = best(repeats,
+    () => out.set(input),
+    () => generator.applyDisplacementBatch(out, n, SCALE, RADIUS));
+  return { ms, out };
+}
+
+function runNative(exe, dir, input, seed, repeats) {
+  const inPath = join(dir, 'in.f32');
+  const outPath = join(dir, 'out.f32');
+  writeFileSync(inPath, input);
+  const stdout = execFileSync(exe, [String(seed), String(SCALE), String(RADIUS), inPath, outPath, String(repeats)],
+                              { encoding: 'utf8' });
+  const bytes = readFileSync(outPath);
+  const out = new Float32Array(bytes.buffer, bytes.byteOffset, bytes.byteLength / 4);
+  return { ms: JSON.parse(stdout).ms, out };
+}
+
+const opt = parseArgs(process.argv.slice(2));
+const { variants, missing } = await loadVariants(opt.wasm);
+const [reference, ...others] = variants;
+const generator = new PlanetGeneratorJS();
+const hasNative = existsSync(opt.native);
+const tempDir = hasNative ? mkdtempSync(join(tmpdir(), 'bench-wasm-')) : null;
+
+const results = [];
+let failed = false;
+for (const n of opt.quick ? QUICK_VERTEX_COUNTS : VERTEX_COUNTS) {
+  const input = makeSphere(n);
+  const repeats = repeatsFor(n, opt.quick);
+  for (const seed of SEEDS) {
+    const wasm = runWasm(reference.module, input, seed, repeats);
+    const extra = others.map((v) => runWasm(v.module, input, seed, repeats));
+    const js = runJs(generator, input, seed, repeats);
+    const native = hasNative ? runNative(opt.native, tempDir, input, seed, repeats) : null;
+
+    const row = {
+      vertices: n,
+      seed,
+      wasm_ms: wasm.ms,
+      js_ms: js.ms,
+      native_ms: native ? native.ms : null,
+      js_max_diff: maxDiff(js.out, wasm.out),
+      native_max_diff: native ? maxDiff(native.out, wasm.out) : null,
+      variants: Object.fromEntries(others.map((v, i) => [v.name, {
+        ms: extra[i].ms,
+        max_diff: maxDiff(extra[i].out, wasm.out)
+      }]))
+    };
+    row.ok = row.js_max_diff <= TOLERANCE && (!native || row.native_max_diff <= TOLERANCE) &&
+             Object.values(row.variants).every((v) => v.max_diff <= TOLERANCE);
+    failed ||= !row.ok;
+    results.push(row);
+  }
+}
+if (tempDir) rmSync(tempDir, { recursive: true, force: true });
+
+const mvps = (n, ms) => (ms == null ? '-' : (n / ms / 1000).toFixed(2));
+const fmt = (v, digits) => (v == null ? '-' : v.toFixed(digits));
+
+if (opt.json !== '-') {
+  console.log(`wasm: ${reference.file}`);
+  for (const v of others) console.log(`${v.name}: ${v.file}${v.threads > 1 ? ` (${v.threads} threads)` : ''}`);
+  for (const file of missing) console.log(`${basename(file, '.js')}: not built (${file}, run ./build.sh)`);
+  console.log(`native: ${hasNative ? opt.native : '(none)'}`);
+  console.log(`scale ${SCALE}, radius ${RADIUS}, ms = best run, Mv/s = million vertices / s, diff = max |pos - wasm|, ` +
+              `x = wasm ms / variant ms`);
+  const variantHeader = others.map((v) => `${(v.name + ' ms').padStart(16)} ${'x'.padStart(5)} `).join('');
+  console.log(`${'vertices'.padStart(9)} ${'seed'.padStart(6)} ${'wasm ms'.padStart(9)} ${'Mv/s'.padStart(6)} ` +
+              variantHeader +
+              `${'native ms'.padStart(9)} ${'Mv/s'.padStart(6)} ${'js ms'.padStart(9)} ${'Mv/s'.padStart(6)} ` +
+              `${'js/wasm'.padStart(7)} ${'js diff'.padStart(8)} ${'nat diff'.padStart(8)} ok`);
+  for (const r of results) {
+    const variantCells = others.map((v) => {
+      const c = r.variants[v.name];
+      return `${fmt(c.ms, 2).padStart(16)} ${(r.wasm_ms / c.ms).toFixed(2).padStart(5)} `;
+    }).join('');
+    console.log(`${String(r.vertices).padStart(9)} ${String(r.seed).padStart(6)} ` +
+                `${fmt(r.wasm_ms, 2).padStart(9)} ${mvps(r.vertices, r.wasm_ms).padStart(6)} ` +
+                variantCells +
+                `${fmt(r.native_ms, 2).padStart(9)} ${mvps(r.vertices, r.native_ms).padStart(6)} ` +
+                `${fmt(r.js_ms, 2).padStart(9)} ${mvps(r.vertices, r.js_ms).padStart(6)} ` +
+                `${(r.js_ms / r.wasm_ms).toFixed(2).padStart(7)} ` +
+                `${r.js_max_diff.toExponential(1).padStart(8)} ` +
+                `${(r.native_max_diff == null ? '-' : r.native_max_diff.toExponential(1)).padStart(8)} ` +
+                `${r.ok ? 'yes' : 'NO'}`);
+  }
+}
+
+if (opt.json) {
+  const report = JSON.stringify({
+    node: process.version,
+    wasm: reference.file,
+    variants: others.map((v) => ({ name: v.name, file: v.file, threads: v.threads })),
+    missing,
+    native: hasNative ? opt.native : null,
+    scale: SCALE,
+    radius: RADIUS,
+    tolerance: TOLERANCE,
+    results
+  }, null, 2);
+  if (opt.json === '-') console.log(report);
+  else writeFileSync(opt.json, report + '\n');
+}
+
+if (failed) {
+  console.error(`output mismatch (tolerance ${TOLERANCE})`);
+  process.exit(1);
+}
@@ -0,0 +1,57 @@
+// compare_suite.mjs
+// -------------------------------------------------------------
+// bench_suite --json 결과 여러 개를 나란히 비교한다. (pgo.sh가 빌드 프로파일 비교에 쓴다)
+//
+// 측정(bench)과 버퍼 크기마다 seed 전체의 ns / sample(min)을 기하 평균으로 묶고,
+// 첫 번째 결과 대비 속도 향상(x)을 출력한다.
+//
+// 사용법: node bench/compare_suite.mjs 이름=FILE [이름=FILE ...]
+//   예: node bench/compare_suite.mjs base=build-native/bench_suite.json lto=build-lto/bench_suite.json
+// -------------------------------------------------------------
+
+import { readFileSync } from 'node:fs';
+
+const inputs = process.argv.slice(2).map((arg) => {
+  const eq = arg.indexOf('=');
+  if (eq <= 0) {
+    console.error('usage: node bench/compare_suite.mjs NAME=FILE [NAME=FILE ...]');
+    process.exit(2);
+  }
+  return { name: arg.slice(0, eq), report: JSON.parse(readFileSync(arg.slice(eq + 1), 'utf8')) };
+});
+if (inputs.length === 0) {
+  console.error('usage: node bench/compare_suite.mjs NAME=FILE [NAME=FILE ...]');
+  process.exit(2);
+}
+
+// "bench/samples" → seed별 ns의 기하 평균
+function summarize(report) {
+  const groups = new Map();
+  for (const r of report.results) {
+    const key = `${r.bench}/${r.samples}`;
+    if (!groups.has(key)) groups.set(key, []);
+    groups.get(key).push(r.ns_per_sample);
+  }
+  const out = new Map();
+  for (const [key, values] of groups) {
+    out.set(key, Math.exp(values.reduce((s, v) => s + Math.log(v), 0) / values.length));
+  }
+  return out;
+}
+
+const summaries = inputs.map((input) => summarize(input.report));
+const base = summaries[0];
+
+for (const input of inputs) console.log(`${input.name}: ${input.report.compiler}, threads ${input.report.threads}`);
+console.log('ns / sample (min, geometric mean over seeds), (x) = speedup vs ' + inputs[0].name);
+console.log(`${'bench'.padEnd(26)} ${'samples'.padStart(8)} ` +
+            inputs.map((input, i) => (i === 0 ? input.name.padStart(9) : `${input.name.padStart(9)} ${''.padStart(7)}`)).join(' '));
+for (const [key, ns0] of base) {
+  const [bench, samples] = key.split('/');
+  const cells = summaries.map((s, i) => {
+    const ns = s.get(key);
+    if (ns == null) return i === 0 ? '-'.padStart(9) : `${'-'.padStart(9)} ${''.padStart(7)}`;
+    return i === 0 ? ns.toFixed(2).padStart(9) : `${ns.toFixed(2).padStart(9)} ${`(${(ns0 / ns).toFixed(2)}x)`.padStart(7)}`;
+  });
+  console.log(`${bench.padEnd(26)} ${samples.padStart(8)} ${cells.join(' ')}`);
+}
@@ -4,20 +4,101 @@ set -e
 SRC1=cpp/noise.cpp
 SRC2=cpp/noise_params.cpp
 SRC3=cpp/planet.cpp
+SRC4=cpp/noise_simd.cpp
+SRC5=cpp/noise_volume.cpp
+SRC6=cpp/thread_pool.cpp
+SRC7=cpp/mesh_buffers.cpp
+SRC8=cpp/mesh_normals.cpp
+SRC9=cpp/sphere_mesh.cpp
+SRC10=cpp/terrain_lod.cpp
+SRC11=cpp/perf_counters.cpp
+
+# PLANET_PERF_COUNTERS=1 ./build.sh 로 빌드하면 계수기 / 단계별 타이머가 켜진다. (get_perf_counters)
+PERF_FLAGS=""
+if [ "${PLANET_PERF_COUNTERS:-0}" = "1" ]; then
+  PERF_FLAGS="-DPLANET_PERF_COUNTERS=1"
+fi
+
+# BUILD_PROFILE=release ./build.sh 로 빌드하면 배포용 모듈을 만든다.
+#   dev     (기본) : -O2, ASSERTIONS=1 (오류 메시지가 자세함)
+#   release        : -O3 + LTO(-flto), ASSERTIONS=0
+#                    noise.cpp / noise_params.cpp / planet.cpp 등 모든 번역 단위를 링크 때 함께 최적화해
+#                    perlin → fbm → get_height가 파일을 넘어 인라인될 수 있다.
+# PGO는 emscripten에 프로파일을 파일로 남기는 런타임이 없어 네이티브 빌드에서만 한다. (pgo.sh)
+BUILD_PROFILE=${BUILD_PROFILE:-dev}
+case "${BUILD_PROFILE}" in
+  dev)     OPT_FLAGS="-O2 -s ASSERTIONS=1" ;;
+  release) OPT_FLAGS="-O3 -flto -s ASSERTIONS=0" ;;
+  *) echo "BUILD_PROFILE must be dev or release (got ${BUILD_PROFILE})" >&2; exit 1 ;;
+esac
 
 OUT_DIR=web
 mkdir -p ${OUT_DIR}
 
-emcc \
-  ${SRC1} ${SRC2} ${SRC3} \
-  -O2 -std=c++17 \
-  -s WASM=1 \
-  -s ALLOW_MEMORY_GROWTH=1 \
-  -s MODULARIZE=1 \
-  -s EXPORT_ES6=1 \
-  -s EXPORTED_FUNCTIONS="['_init_planet','_get_height','_apply_displacement_batch', '_malloc', '_free']" \
-  -s EXPORTED_RUNTIME_METHODS="['cwrap','getValue', 'HEAPF32']" \
-  -s ASSERTIONS=1 \
-  -o ${OUT_DIR}/planet.js
-
-echo "Build complete"
+# build_module <출력 파일 이름> [추가 emcc 옵션...]
+build_module() {
+  local OUT=$1
+  shift
+
+  emcc \
+    ${SRC1} ${SRC2} ${SRC3} ${SRC4} ${SRC5} ${SRC6} ${SRC7} ${SRC8} ${SRC9} ${SRC10} ${SRC11} \
+    ${OPT_FLAGS} -std=c++17 ${PERF_FLAGS} \
+    "$@" \
+    -s WASM=1 \
+    -s ALLOW_MEMORY_GROWTH=1 \
+    -s MODULARIZE=1 \
+    -s EXPORT_ES6=1 \
+    -s EXPORTED_FUNCTIONS="['_init_planet','_get_height','_apply_displacement_batch', \
+                            '_get_height_and_normal','_apply_displacement_normals_batch', \
+                            '_apply_displacement_soa','_apply_displacement_soa_to', \
+                            '_mesh_resize','_mesh_vertex_count','_mesh_directions','_mesh_positions', \
+                            '_mesh_normals','_mesh_colors','_mesh_capture_directions','_mesh_displace', \
+                            '_mesh_generate_sphere','_mesh_index_count','_mesh_indices', \
+                            '_mesh_tile_count','_mesh_tile_offsets', \
+                            '_lod_configure','_lod_frustum','_lod_update','_lod_regenerate', \
+                            '_lod_visible_count','_lod_visible','_lod_created_count','_lod_created', \
+                            '_lod_released_count','_lod_released','_lod_resident_count', \
+                            '_lod_patch_vertex_count','_lod_index_count','_lod_indices', \
+                            '_lod_patch_positions','_lod_patch_normals','_lod_patch_colors', \
+                            '_set_vertex_palette','_classify_vertex_colors','_compute_vertex_normals', \
+                            '_set_preview_mode','_get_preview_error', \
+                            '_set_thread_count','_get_thread_count', \
+                            '_get_perf_counters','_reset_perf_counters', \
+                            '_planet_create','_planet_destroy','_planet_init', \
+                            '_planet_get_height','_planet_apply_displacement_batch', \
+                            '_planet_get_height_and_normal','_planet_apply_displacement_normals_batch', \
+                            '_planet_apply_displacement_soa','_planet_apply_displacement_soa_to', \
+                            '_planet_set_noise_backend','_planet_set_layer_basis', \
+                            '_planet_set_preview_mode','_planet_get_preview_error', \
+                            '_set_noise_param','_get_noise_param','_clear_noise_params', \
+                            '_planet_set_noise_param','_planet_get_noise_param','_planet_clear_noise_params', \
+                            '_malloc', '_free']" \
+    -s EXPORTED_RUNTIME_METHODS="['cwrap','getValue', 'HEAPF32', 'HEAPU8', 'HEAPU32']" \
+    -o ${OUT_DIR}/${OUT}
+}
+
+# 1) 기본(스칼라) 모듈: 모든 브라우저에서 동작
+build_module planet.js
+
+# 2) WASM SIMD128 모듈: 노이즈 커널이 4개씩 계산됨
+#    (main.js가 브라우저 지원 여부를 확인하고 이쪽을 우선 사용)
+build_module planet_simd.js -msimd128
+
+# 3) WASM SIMD128 + pthread 모듈: 배치 함수가 Worker 여러 개에 정점을 나눠 계산함
+#    SharedArrayBuffer가 필요하므로 페이지가 cross-origin isolated
+#    (COOP: same-origin / COEP: require-corp 헤더)일 때만 main.js가 이쪽을 쓰고,
+#    아니면 위의 한 스레드 모듈로 돌아간다.
+#    - PTHREAD_POOL_SIZE : 시작할 때 Worker를 미리 만들어 둔다. (최대 16, main.js의 CONFIG.threads와 맞춤)
+#                          메인 스레드가 계산을 기다리는 동안에는 새 Worker를 띄울 수 없기 때문
+#                          navigator가 없는 Node 20(bench/bench_wasm.mjs)에서는 4개로 시작한다.
+#    - INITIAL_MEMORY    : pthread + 메모리 증가는 느려서 처음부터 넉넉하게 잡는다. (1M 정점 위치+법선 = 24MB)
+build_module planet_mt.js -msimd128 -pthread \
+  -s PTHREAD_POOL_SIZE='Math.min((typeof navigator!=="undefined"&&navigator.hardwareConcurrency)||4,16)' \
+  -s INITIAL_MEMORY=268435456
+
+# 4) 만든 모듈에 main.js가 부르는 export(REQUIRED_EXPORTS)가 모두 있는지 확인
+#    (EXPORTED_FUNCTIONS에서 빠진 것이 있으면 여기서 실패한다)
+node tools/check_wasm_exports.mjs \
+  ${OUT_DIR}/planet.js ${OUT_DIR}/planet_simd.js ${OUT_DIR}/planet_mt.js
+
+echo "Build complete (${BUILD_PROFILE})"
@@ -0,0 +1,39 @@
+#include "mesh_buffers.hpp"
+#include "util.hpp"
+#include <utility>
+
+void MeshBuffers::resize(size_t count) {
+    count_ = count;
+    directions_.assign(count * 3, 0.0f);
+    positions_.assign(count * 3, 0.0f);
+    normals_.assign(count * 3, 0.0f);
+    colors_.assign(count, 0u);
+    indices_.clear();
+    tileOffsets_.clear();
+    layerCache_.resize(count);
+}
+
+void MeshBuffers::captureDirections() {
+    float* xs = directions_.data();
+    float* ys = xs + count_;
+    float* zs = ys + count_;
+    layerCache_.invalidate();
+
+    for (size_t i = 0; i < count_; ++i) {
+        Vec3 n = normalize(Vec3(positions_[i * 3], positions_[i * 3 + 1], positions_[i * 3 + 2]));
+        xs[i] = n.x;
+        ys[i] = n.y;
+        zs[i] = n.z;
+    }
+}
+
+void MeshBuffers::generateSphere(SphereMeshKind kind, size_t targetVertices, int tilesPerEdge) {
+    SphereMesh mesh;
+    buildSphereMesh(kind, targetVertices, tilesPerEdge, mesh);
+
+    resize(mesh.vertexCount());
+    positions_ = std::move(mesh.positions);
+    indices_ = std::move(mesh.indices);
+    tileOffsets_ = std::move(mesh.tileOffsets);
+    captureDirections();
+}
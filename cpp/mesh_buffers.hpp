@@ -0,0 +1,64 @@
+#pragma once
+#include "planet.hpp"
+#include "sphere_mesh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// mesh_buffers.hpp
+// -------------------------------------------------------------
+// MeshBuffers: 현재 행성 메쉬의 정점 데이터를 모듈(WASM 메모리) 안에 계속 들고 있는 버퍼 묶음.
+//
+// 예전에는 재생성할 때마다 JS가
+//   _malloc → 위치 배열을 HEAPF32로 복사 → 배치 함수 → subarray + set으로 다시 복사 → _free
+// 를 했다. 이제 버퍼는 모듈이 갖고 있고, JS(Three.js BufferAttribute)는
+// HEAPF32 / HEAPU8에서 바로 잘라 낸 뷰(view)를 그대로 쓴다. → 복사와 할당이 없다.
+//
+//   directions : 단위 방향 (SoA: xs | ys | zs, 각 count개)
+//   positions  : 표면 위치 [x, y, z, ...]
+//   normals    : 법선 [nx, ny, nz, ...]
+//   colors     : 정점 색 RGBA8 (정점마다 uint32 하나, 메모리 순서 R, G, B, A)
+//   indices    : 삼각형 [a, b, c, ...] (generateSphere로 만든 경우, 타일 순서)
+//   tileOffsets: 타일마다 indices 시작 위치 (타일 수 + 1개)
+//   layerCache : directions의 층별 지형 캐시 (TerrainLayerCache, mesh_displace가 바뀐 층만 다시 계산)
+//
+// resize를 부르면 버퍼 주소가 바뀔 수 있으므로 JS는 포인터를 다시 받아야 한다.
+// -------------------------------------------------------------
+class MeshBuffers {
+public:
+    // 정점 count개를 담을 수 있게 버퍼를 다시 만든다. (내용은 0으로 채우고 indices는 비움)
+    void resize(size_t count);
+
+    // 지금 positions에 들어 있는 좌표를 정규화해서 directions에 저장한다.
+    // (변형 전 구 메쉬의 위치를 넣은 뒤 한 번 부른다)
+    void captureDirections();
+
+    // 단위 구 메쉬(sphere_mesh.hpp)를 만들어 positions / directions / indices / tileOffsets를 채운다.
+    // 정점 수는 targetVertices 이하에서 가장 촘촘하게 정해진다.
+    void generateSphere(SphereMeshKind kind, size_t targetVertices, int tilesPerEdge);
+
+    size_t vertexCount() const { return count_; }
+
+    float* directions() { return directions_.data(); }
+    float* positions() { return positions_.data(); }
+    float* normals() { return normals_.data(); }
+    uint32_t* colors() { return colors_.data(); }
+
+    size_t indexCount() const { return indices_.size(); }
+    uint32_t* indices() { return indices_.data(); }
+    size_t tileCount() const { return tileOffsets_.empty() ? 0 : tileOffsets_.size() - 1; }
+    uint32_t* tileOffsets() { return tileOffsets_.data(); }
+
+    // resize / captureDirections / generateSphere는 방향이 바뀌므로 캐시를 비운다.
+    TerrainLayerCache& layerCache() { return layerCache_; }
+
+private:
+    size_t count_ = 0;
+    std::vector<float> directions_;
+    std::vector<float> positions_;
+    std::vector<float> normals_;
+    std::vector<uint32_t> colors_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> tileOffsets_;
+    TerrainLayerCache layerCache_;
+};
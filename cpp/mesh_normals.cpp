@@ -0,0 +1,133 @@
+#include "mesh_normals.hpp"
+#include <cmath>
+
+namespace {
+
+// 스레드 하나가 한 번에 가져가는 삼각형 / 정점 수
+constexpr size_t kNormalChunk = 4096;
+
+inline bool validFace(const uint32_t* tri, size_t vertexCount) {
+    return tri[0] < vertexCount && tri[1] < vertexCount && tri[2] < vertexCount;
+}
+
+// (C - B) x (A - B) : Three.js와 같은 순서로 계산 (scatter / gather 두 버전이 같이 쓴다)
+inline void faceNormal(const float* positions, const uint32_t* tri, float& nx, float& ny, float& nz) {
+    const float* a = positions + tri[0] * 3;
+    const float* b = positions + tri[1] * 3;
+    const float* c = positions + tri[2] * 3;
+
+    float cbx = c[0] - b[0], cby = c[1] - b[1], cbz = c[2] - b[2];
+    float abx = a[0] - b[0], aby = a[1] - b[1], abz = a[2] - b[2];
+
+    nx = cby * abz - cbz * aby;
+    ny = cbz * abx - cbx * abz;
+    nz = cbx * aby - cby * abx;
+}
+
+// 길이로 나눠 단위 벡터로 (길이가 0이면 그대로 둔다 = Three.js normalize)
+inline void normalizeInPlace(float* n) {
+    float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (len == 0.0f) len = 1.0f;
+    n[0] /= len;
+    n[1] /= len;
+    n[2] /= len;
+}
+
+} // namespace
+
+// --------------------------------------------------------------
+// VertexAdjacency::build
+// --------------------------------------------------------------
+// 정점마다 포함된 삼각형 수를 세고(counting sort) 누적 합으로 offsets를 만든 뒤
+// 삼각형 번호 순서대로 채운다. → 정점마다 삼각형 번호가 오름차순으로 들어간다.
+// 범위를 벗어난 번호가 있는 삼각형은 법선 계산과 똑같이 건너뛴다.
+// --------------------------------------------------------------
+void VertexAdjacency::build(const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    size_t faceCount = indexCount / 3;
+    offsets.assign(vertexCount + 1, 0u);
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        const uint32_t* tri = indices + f * 3;
+        if (!validFace(tri, vertexCount)) continue;
+        ++offsets[tri[0] + 1];
+        ++offsets[tri[1] + 1];
+        ++offsets[tri[2] + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+
+    faces.resize(offsets[vertexCount]);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t f = 0; f < faceCount; ++f) {
+        const uint32_t* tri = indices + f * 3;
+        if (!validFace(tri, vertexCount)) continue;
+        faces[cursor[tri[0]]++] = static_cast<uint32_t>(f);
+        faces[cursor[tri[1]]++] = static_cast<uint32_t>(f);
+        faces[cursor[tri[2]]++] = static_cast<uint32_t>(f);
+    }
+}
+
+void computeVertexNormals(const float* positions, size_t vertexCount,
+                          const uint32_t* indices, size_t indexCount, float* normals) {
+    size_t faceCount = indexCount / 3;
+    for (size_t i = 0; i < vertexCount * 3; ++i) normals[i] = 0.0f;
+
+    for (size_t f = 0; f < faceCount; ++f) {
+        const uint32_t* tri = indices + f * 3;
+        if (!validFace(tri, vertexCount)) continue;
+
+        float nx, ny, nz;
+        faceNormal(positions, tri, nx, ny, nz);
+        for (int k = 0; k < 3; ++k) {
+            float* n = normals + tri[k] * 3;
+            n[0] += nx;
+            n[1] += ny;
+            n[2] += nz;
+        }
+    }
+
+    for (size_t v = 0; v < vertexCount; ++v) normalizeInPlace(normals + v * 3);
+}
+
+// --------------------------------------------------------------
+// computeVertexNormals (adjacency + pool)
+// --------------------------------------------------------------
+// 1) 삼각형 법선을 SoA(fx | fy | fz)로 계산 : 삼각형마다 자기 자리에만 쓴다.
+// 2) 정점마다 adjacency의 삼각형들을 차례로 더하고 정규화 : 정점마다 자기 자리에만 쓴다.
+// scatter 버전과 더하는 순서가 같으므로 결과도 같다.
+// --------------------------------------------------------------
+void computeVertexNormals(const float* positions, size_t vertexCount,
+                          const uint32_t* indices, size_t indexCount,
+                          const VertexAdjacency& adjacency, float* normals, ThreadPool& pool) {
+    size_t faceCount = indexCount / 3;
+    std::vector<float> faceNormals(faceCount * 3);
+    float* fx = faceNormals.data();
+    float* fy = fx + faceCount;
+    float* fz = fy + faceCount;
+
+    pool.parallelFor(faceCount, kNormalChunk, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            const uint32_t* tri = indices + f * 3;
+            if (!validFace(tri, vertexCount)) continue;
+            faceNormal(positions, tri, fx[f], fy[f], fz[f]);
+        }
+    });
+
+    const uint32_t* offsets = adjacency.offsets.data();
+    const uint32_t* faces = adjacency.faces.data();
+    pool.parallelFor(vertexCount, kNormalChunk, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+            for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+                uint32_t f = faces[k];
+                nx += fx[f];
+                ny += fy[f];
+                nz += fz[f];
+            }
+            float* n = normals + v * 3;
+            n[0] = nx;
+            n[1] = ny;
+            n[2] = nz;
+            normalizeInPlace(n);
+        }
+    });
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// mesh_normals.hpp
+// -------------------------------------------------------------
+// 삼각형 메쉬의 정점 법선 (Three.js BufferGeometry.computeVertexNormals와 같은 방식)
+//
+//   1) 삼각형마다 (C - B) x (A - B)를 구한다. (정규화하지 않으므로 넓이에 비례 = 넓이 가중)
+//   2) 정점마다 자기를 포함한 삼각형들의 값을 더한 뒤 정규화한다.
+//
+// 두 가지 버전이 있다.
+//   - computeVertexNormals(..., normals)
+//       삼각형을 돌면서 꼭짓점 세 개에 더하는(scatter) 한 스레드 버전. 준비물이 없다.
+//   - computeVertexNormals(..., adjacency, normals, pool)
+//       VertexAdjacency(정점 → 삼각형 목록)를 미리 만들어 두고
+//       (1) 삼각형 법선을 SoA 배열에 한꺼번에 계산한 뒤
+//       (2) 정점마다 자기 삼각형들의 값을 모으는(gather) 버전.
+//       두 단계 모두 서로 다른 곳에 쓰므로 잠금 / atomic 없이 여러 스레드로 나눌 수 있다.
+//
+// 정점마다 삼각형 번호 순서대로 더하므로 두 버전의 결과는 비트 단위로 같다.
+// 메쉬 연결(index)이 바뀌지 않는 동안 VertexAdjacency는 계속 다시 쓸 수 있다.
+// -------------------------------------------------------------
+struct VertexAdjacency {
+    std::vector<uint32_t> offsets; // 정점 v의 삼각형 목록 = faces[offsets[v] .. offsets[v+1])
+    std::vector<uint32_t> faces;   // 삼각형 번호 (정점마다 오름차순)
+
+    // indices : 삼각형 꼭짓점 번호 [a, b, c, ...] (indexCount는 3의 배수)
+    void build(const uint32_t* indices, size_t indexCount, size_t vertexCount);
+};
+
+// positions / normals : [x, y, z, ...] (vertexCount개)
+void computeVertexNormals(const float* positions, size_t vertexCount,
+                          const uint32_t* indices, size_t indexCount, float* normals);
+
+void computeVertexNormals(const float* positions, size_t vertexCount,
+                          const uint32_t* indices, size_t indexCount,
+                          const VertexAdjacency& adjacency, float* normals, ThreadPool& pool);
@@ -5,8 +5,13 @@
 // 이 3가지 노이즈는 행성의 지형이 자연스럽게 보이도록 만드는 핵심 알고리즘이다.
 //
 // 제공되는 함수:
-//   void initNoise(uint32_t seed);
+//   void initNoiseTable(NoiseTable& table, uint32_t seed, NoiseBackend backend);
 //     → 노이즈 계산에 필요한 무작위 테이블을 seed로 초기화한다.
+//       backend가 Hashed이면 테이블 대신 격자 해시(latticeHash)를 쓴다.
+//       (initNoise(seed)는 파일 안의 기본 테이블을 초기화하는 예전 API)
+//
+// 아래 함수들은 모두 NoiseTable을 첫 인자로 받는 버전과,
+// 기본 테이블을 쓰는 예전 버전(인자 없이)이 함께 있다.
 //
 //   float perlin(float x, float y, float z);
 //     → Perlin 노이즈. -1~1 사이 값을 반환.
@@ -18,9 +23,22 @@
 //
 //   float ridged_fbm(...);
 //     → 산맥처럼 날카로운 능선을 만드는 특수 노이즈.
+//
+//   float simplex(table, x, y, z);
+//     → Simplex 노이즈. fbm / ridged_fbm에 NoiseBasis::Simplex를 주면
+//       Perlin 대신 이것을 옥타브마다 쌓는다.
+//
+//   NoiseGrad perlin_d / fbm_d / ridged_fbm_d(table, ...);
+//     → 위 노이즈 값과 함께 (x, y, z) 방향 기울기(gradient)를 계산. 법선 계산용.
+//
+//   TerrainLayers terrain_layers(table, params, x, y, z);
+//     → get_height에 필요한 세 층(macro / micro / ridge)을 한 루프에서 같이 계산.
 // -------------------------------------------------------------
 
 #include "util.hpp"
+#include "noise.hpp"
+#include "noise_params.hpp"
+#include "perf_counters.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -35,31 +53,81 @@
 //
 // 256개 테이블을 두 번 복사하여 512개로 만든 이유는
 // 인덱싱 편의를 위해서다.
+//
+// 테이블은 NoiseTable 구조체(noise.hpp)에 담겨 행성 생성기마다 따로 있고,
+// 아래 default_table은 예전 API(initNoise, perlin(x,y,z) ...)용 기본 테이블이다.
 // -------------------------------------------------------------
-static int perm_table[512];
+static NoiseTable default_table;
 static bool perm_inited = false;
 
 // -------------------------------------------------------------
-// initNoise(seed)
+// initNoiseTable(table, seed, backend)
 // -------------------------------------------------------------
 // seed 값을 이용해 노이즈용 무작위 순서 테이블을 만든다.
 // seed가 동일하면 항상 같은 랜덤 테이블이 만들어져서
 // → 같은 행성이 다시 만들어질 수 있다.
+//
+// Hashed 방식은 테이블 대신 hashSeed만 쓰므로 섞는 과정을 건너뛴다.
+//
+// 섞는 순서는 std::shuffle 대신 shuffle_perm으로 직접 정한다.
+// std::shuffle이 난수를 쓰는 방식은 표준 라이브러리마다 달라서
+// 같은 seed라도 WASM(emscripten, libc++)과 네이티브(g++, libstdc++)의 행성이 달랐다.
 // -------------------------------------------------------------
-void initNoise(uint32_t seed) {
+
+// libc++의 std::shuffle(first, last, mt19937)과 같은 순서로 섞는다. (브라우저 행성이 바뀌지 않게)
+// 앞에서부터 k번째 자리를 [k, 255] 중 하나와 바꾸고,
+// [0, d] 난수는 d + 1을 담을 만큼의 아래 비트만 남긴 값이 범위를 넘으면 다시 뽑는다.
+// (js_planet.js의 shufflePerm도 같은 순서여야 한다)
+static void shuffle_perm(int* perm_table, std::mt19937& rng) {
+    for (int k = 0, d = 255; d > 0; ++k, --d) {
+        const uint32_t range = static_cast<uint32_t>(d) + 1u;
+        int bits = 0;
+        while ((1u << bits) < range) ++bits;
+        const uint32_t mask = (1u << bits) - 1u;
+
+        uint32_t u;
+        do {
+            u = static_cast<uint32_t>(rng()) & mask;
+        } while (u >= range);
+        if (u != 0) std::swap(perm_table[k], perm_table[k + u]);
+    }
+}
+
+void initNoiseTable(NoiseTable& table, uint32_t seed, NoiseBackend backend) {
+    table.backend = backend;
+    table.hashSeed = hash32(seed);
+    if (backend == NoiseBackend::Hashed) return;
+
+    int* perm_table = table.perm;
+
     // 0~255 정렬된 상태로 시작
     for (int i = 0; i < 256; ++i) perm_table[i] = i;
 
     // seed 기반으로 섞기(랜덤 셔플)
     std::mt19937 rng(seed);
-    std::shuffle(perm_table, perm_table + 256, rng);
+    shuffle_perm(perm_table, rng);
 
     // 두 번 복사해 512개 테이블 만들기
     for (int i = 0; i < 256; ++i) perm_table[256 + i] = perm_table[i];
+}
 
+// -------------------------------------------------------------
+// initNoise(seed) / defaultNoiseTable()
+// -------------------------------------------------------------
+// 예전 API용 기본 테이블을 초기화하거나 꺼내 준다.
+// 아직 초기화 전에 꺼내면 기본 seed(0)를 사용한다.
+// (기본 테이블은 전역 상태라 여러 스레드에서 initNoise를 부르면 안 된다)
+// -------------------------------------------------------------
+void initNoise(uint32_t seed) {
+    initNoiseTable(default_table, seed);
     perm_inited = true;
 }
 
+const NoiseTable& defaultNoiseTable() {
+    if (!perm_inited) initNoise(0); // 만약 initNoise를 안 부르면 기본 seed 사용
+    return default_table;
+}
+
 // -------------------------------------------------------------
 // fadef
 // -------------------------------------------------------------
@@ -98,10 +166,11 @@ static inline float grad(int hash, float x, float y, float z) {
 //   - 결과값은 -1 ~ 1
 //   - 매끄럽고 구름 같은 패턴
 //   - 반복성이 없고 자연스럽다
+//
+// perlin_impl은 테이블 주소만 받아 계산하는 본체.
+// (fbm, terrain_layers처럼 여러 번 부르는 곳에서 인라인되어 쓰인다)
 // -------------------------------------------------------------
-float perlin(float x, float y, float z) {
-    if (!perm_inited) initNoise(0); // 만약 initPlanet를 안 부르면 기본 seed 사용
-
+static inline float perlin_impl(const int* perm_table, float x, float y, float z) {
     // 입력 좌표의 정수 부분(격자 위치)
     int X = static_cast<int>(std::floor(x)) & 255;
     int Y = static_cast<int>(std::floor(y)) & 255;
@@ -145,6 +214,340 @@ float perlin(float x, float y, float z) {
     return res; // -1 ~ 1
 }
 
+// -------------------------------------------------------------
+// perlin_hashed_impl
+// -------------------------------------------------------------
+// 테이블 없는(Hashed) Perlin 노이즈.
+// 격자 점의 gradient 번호를 perm_table 조회 대신
+// latticeHash(util.hpp)로 바로 계산한다는 점만 perlin_impl과 다르다.
+// (fade 곡선, grad, 보간 방식은 같다)
+//
+// 테이블 조회 14번이 정수 곱셈/xor로 바뀌어서,
+// SIMD에서 gather 없이 그대로 벡터화된다. (noise_simd.cpp)
+// 격자 좌표를 255로 자르지 않으므로 256칸마다 반복되지도 않는다.
+// -------------------------------------------------------------
+static inline float perlin_hashed_impl(uint32_t seed, float x, float y, float z) {
+    float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+
+    // 격자 좌표에 축별 상수를 곱해 둔다. (X+1 은 + LATTICE_PRIME_X)
+    uint32_t hx0 = static_cast<uint32_t>(static_cast<int>(fx)) * LATTICE_PRIME_X;
+    uint32_t hy0 = static_cast<uint32_t>(static_cast<int>(fy)) * LATTICE_PRIME_Y;
+    uint32_t hz0 = static_cast<uint32_t>(static_cast<int>(fz)) * LATTICE_PRIME_Z;
+    uint32_t hx1 = hx0 + LATTICE_PRIME_X;
+    uint32_t hy1 = hy0 + LATTICE_PRIME_Y;
+    uint32_t hz1 = hz0 + LATTICE_PRIME_Z;
+
+    x -= fx;
+    y -= fy;
+    z -= fz;
+
+    float u = fadef(x);
+    float v = fadef(y);
+    float w = fadef(z);
+
+    auto h = [seed](uint32_t a, uint32_t b, uint32_t c) {
+        return static_cast<int>(latticeHash(seed, a, b, c));
+    };
+
+    return lerpf(
+        lerpf(
+            lerpf(grad(h(hx0, hy0, hz0), x, y, z),
+                  grad(h(hx1, hy0, hz0), x - 1.0f, y, z), u),
+            lerpf(grad(h(hx0, hy1, hz0), x, y - 1.0f, z),
+                  grad(h(hx1, hy1, hz0), x - 1.0f, y - 1.0f, z), u),
+            v),
+        lerpf(
+            lerpf(grad(h(hx0, hy0, hz1), x, y, z - 1.0f),
+                  grad(h(hx1, hy0, hz1), x - 1.0f, y, z - 1.0f), u),
+            lerpf(grad(h(hx0, hy1, hz1), x, y - 1.0f, z - 1.0f),
+                  grad(h(hx1, hy1, hz1), x - 1.0f, y - 1.0f, z - 1.0f), u),
+            v),
+        w);
+}
+
+// -------------------------------------------------------------
+// 격자 방식별 샘플러
+// -------------------------------------------------------------
+// fbm / ridged_fbm / terrain_layers는 “점 하나의 노이즈 값”만 있으면 되므로
+// 방식(Table / Hashed)을 템플릿 인자로 받는다.
+// 방식 선택은 함수 시작에서 한 번만 하고, 옥타브 루프 안에는 분기가 없다.
+//
+// corners()는 미분 버전(perlin_d)이 쓰는 8개 코너 해시를 돌려준다.
+// 순서: (0,0,0) (1,0,0) (0,1,0) (1,1,0) (0,0,1) (1,0,1) (0,1,1) (1,1,1)
+// hash(i, j, k)는 격자 점 하나의 해시 (simplex가 씀)
+// -------------------------------------------------------------
+struct TableLattice {
+    const int* perm;
+    float operator()(float x, float y, float z) const { return perlin_impl(perm, x, y, z); }
+
+    void corners(float fx, float fy, float fz, int h[8]) const {
+        int X = static_cast<int>(fx) & 255;
+        int Y = static_cast<int>(fy) & 255;
+        int Z = static_cast<int>(fz) & 255;
+        int A  = perm[X] + Y;
+        int AA = perm[A] + Z;
+        int AB = perm[A + 1] + Z;
+        int B  = perm[X + 1] + Y;
+        int BA = perm[B] + Z;
+        int BB = perm[B + 1] + Z;
+        h[0] = perm[AA];     h[1] = perm[BA];     h[2] = perm[AB];     h[3] = perm[BB];
+        h[4] = perm[AA + 1]; h[5] = perm[BA + 1]; h[6] = perm[AB + 1]; h[7] = perm[BB + 1];
+    }
+
+    int hash(int i, int j, int k) const {
+        return perm[(i & 255) + perm[(j & 255) + perm[k & 255]]];
+    }
+};
+
+struct HashedLattice {
+    uint32_t seed;
+    float operator()(float x, float y, float z) const { return perlin_hashed_impl(seed, x, y, z); }
+
+    void corners(float fx, float fy, float fz, int h[8]) const {
+        uint32_t hx0 = static_cast<uint32_t>(static_cast<int>(fx)) * LATTICE_PRIME_X;
+        uint32_t hy0 = static_cast<uint32_t>(static_cast<int>(fy)) * LATTICE_PRIME_Y;
+        uint32_t hz0 = static_cast<uint32_t>(static_cast<int>(fz)) * LATTICE_PRIME_Z;
+        uint32_t hx1 = hx0 + LATTICE_PRIME_X;
+        uint32_t hy1 = hy0 + LATTICE_PRIME_Y;
+        uint32_t hz1 = hz0 + LATTICE_PRIME_Z;
+        h[0] = static_cast<int>(latticeHash(seed, hx0, hy0, hz0));
+        h[1] = static_cast<int>(latticeHash(seed, hx1, hy0, hz0));
+        h[2] = static_cast<int>(latticeHash(seed, hx0, hy1, hz0));
+        h[3] = static_cast<int>(latticeHash(seed, hx1, hy1, hz0));
+        h[4] = static_cast<int>(latticeHash(seed, hx0, hy0, hz1));
+        h[5] = static_cast<int>(latticeHash(seed, hx1, hy0, hz1));
+        h[6] = static_cast<int>(latticeHash(seed, hx0, hy1, hz1));
+        h[7] = static_cast<int>(latticeHash(seed, hx1, hy1, hz1));
+    }
+
+    int hash(int i, int j, int k) const {
+        return static_cast<int>(latticeHash(seed,
+                                            static_cast<uint32_t>(i) * LATTICE_PRIME_X,
+                                            static_cast<uint32_t>(j) * LATTICE_PRIME_Y,
+                                            static_cast<uint32_t>(k) * LATTICE_PRIME_Z));
+    }
+};
+
+// -------------------------------------------------------------
+// 미분(gradient) 버전: perlin_d / fbm_d / ridged_fbm_d
+// -------------------------------------------------------------
+// 노이즈 값과 함께 (x, y, z) 각 방향으로의 기울기를 해석적으로 계산한다.
+// 값(value)은 perlin / fbm / ridged_fbm 과 같은 연산 순서라 결과가 같다.
+//
+// 원리:
+//   - grad(h, x, y, z)는 (x, y, z)에 대한 1차식이므로
+//     기울기는 h가 고른 방향 벡터 그 자체다. (grad_d)
+//   - lerp(a, b, t(x))의 미분은 a' + t(b' - a') + t'(x)(b - a). (lerp_d)
+//   - fade 곡선의 미분은 30t^2(t-1)^2.
+// 이렇게 구한 기울기로 정점 법선을 바로 만들 수 있어서
+// 메쉬 전체를 다시 훑는 법선 계산(computeVertexNormals)이 필요 없다.
+// -------------------------------------------------------------
+static inline float fade_deriv(float t) {
+    return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+}
+
+static inline NoiseGrad grad_d(int hash, float x, float y, float z) {
+    int h = hash & 15;
+    float su = (h & 1) ? -1.0f : 1.0f;
+    float sv = (h & 2) ? -1.0f : 1.0f;
+    NoiseGrad g = { grad(hash, x, y, z), 0.0f, 0.0f, 0.0f };
+    if (h < 8) g.dx += su; else g.dy += su;
+    if (h < 4) g.dy += sv;
+    else if (h == 12 || h == 14) g.dx += sv;
+    else g.dz += sv;
+    return g;
+}
+
+// (dtx, dty, dtz) : 보간 계수 t의 기울기 (한 축만 0이 아니다)
+static inline NoiseGrad lerp_d(const NoiseGrad& a, const NoiseGrad& b, float t,
+                               float dtx, float dty, float dtz) {
+    float diff = b.value - a.value;
+    return { lerpf(a.value, b.value, t),
+             lerpf(a.dx, b.dx, t) + dtx * diff,
+             lerpf(a.dy, b.dy, t) + dty * diff,
+             lerpf(a.dz, b.dz, t) + dtz * diff };
+}
+
+template <class Lattice>
+static NoiseGrad perlin_d_impl(Lattice lattice, float x, float y, float z) {
+    float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+    int h[8];
+    lattice.corners(fx, fy, fz, h);
+
+    x -= fx;
+    y -= fy;
+    z -= fz;
+
+    float u = fadef(x), du = fade_deriv(x);
+    float v = fadef(y), dv = fade_deriv(y);
+    float w = fadef(z), dw = fade_deriv(z);
+
+    NoiseGrad x00 = lerp_d(grad_d(h[0], x, y, z),
+                           grad_d(h[1], x - 1.0f, y, z), u, du, 0.0f, 0.0f);
+    NoiseGrad x10 = lerp_d(grad_d(h[2], x, y - 1.0f, z),
+                           grad_d(h[3], x - 1.0f, y - 1.0f, z), u, du, 0.0f, 0.0f);
+    NoiseGrad x01 = lerp_d(grad_d(h[4], x, y, z - 1),
+                           grad_d(h[5], x - 1.0f, y, z - 1), u, du, 0.0f, 0.0f);
+    NoiseGrad x11 = lerp_d(grad_d(h[6], x, y - 1.0f, z - 1),
+                           grad_d(h[7], x - 1.0f, y - 1.0f, z - 1), u, du, 0.0f, 0.0f);
+
+    NoiseGrad y0 = lerp_d(x00, x10, v, 0.0f, dv, 0.0f);
+    NoiseGrad y1 = lerp_d(x01, x11, v, 0.0f, dv, 0.0f);
+    return lerp_d(y0, y1, w, 0.0f, 0.0f, dw);
+}
+
+// -------------------------------------------------------------
+// simplex(x,y,z)
+// -------------------------------------------------------------
+// 3D Simplex 노이즈.
+// Perlin은 정육면체 격자의 꼭짓점 8개를 보간하지만,
+// Simplex는 공간을 사면체(simplex)로 나눠서 꼭짓점 4개만 더한다.
+//   - 점 하나당 계산량이 적다 (코너 8개 → 4개)
+//   - 격자 축 방향 무늬(가로/세로 줄)가 덜 보인다 → 구 표면에서 더 자연스럽다
+//
+// 각 꼭짓점은 (0.6 - r^2)^4 * (gradient · 거리) 만큼 기여한다.
+// 격자 해시와 gradient(grad)는 Perlin과 같은 것을 쓰므로
+// Table / Hashed 방식 모두에서 동작한다.
+// 결과는 대략 -1 ~ 1 (kSimplexScale로 맞춤)
+// -------------------------------------------------------------
+static const float kSimplexF3 = 1.0f / 3.0f;  // 입력 좌표 → 사면체 격자 (skew)
+static const float kSimplexG3 = 1.0f / 6.0f;  // 사면체 격자 → 입력 좌표 (unskew)
+static const float kSimplexScale = 32.0f;
+
+// 꼭짓점 하나의 기여도
+static inline float simplex_corner(int hash, float x, float y, float z) {
+    float t = 0.6f - x * x - y * y - z * z;
+    if (t <= 0.0f) return 0.0f;
+    t *= t;
+    return t * t * grad(hash, x, y, z);
+}
+
+// 입력 점이 들어 있는 사면체의 꼭짓점 4개를 찾는다.
+// (i,j,k) : 첫 꼭짓점의 격자 좌표, (x0,y0,z0) : 그 꼭짓점에서 입력 점까지의 거리
+// o1, o2  : 두 번째 / 세 번째 꼭짓점의 격자 오프셋 (네 번째는 항상 (1,1,1))
+struct SimplexCell {
+    int i, j, k;
+    float x0, y0, z0;
+    int o1[3], o2[3];
+};
+
+static inline SimplexCell simplex_cell(float x, float y, float z) {
+    SimplexCell c;
+    float s = (x + y + z) * kSimplexF3;
+    float fi = std::floor(x + s), fj = std::floor(y + s), fk = std::floor(z + s);
+    float t = (fi + fj + fk) * kSimplexG3;
+    c.i = static_cast<int>(fi);
+    c.j = static_cast<int>(fj);
+    c.k = static_cast<int>(fk);
+    c.x0 = x - (fi - t);
+    c.y0 = y - (fj - t);
+    c.z0 = z - (fk - t);
+
+    // 좌표 크기 순서로 사면체 6개 중 하나를 고른다.
+    int a = c.x0 >= c.y0, b = c.y0 >= c.z0, d = c.x0 >= c.z0;
+    c.o1[0] = a & d;        c.o1[1] = (1 - a) & b;  c.o1[2] = (1 - b) & (1 - d);
+    c.o2[0] = a | d;        c.o2[1] = (1 - a) | b;  c.o2[2] = (1 - b) | (1 - d);
+    return c;
+}
+
+template <class Lattice>
+static inline float simplex_impl(Lattice lattice, float x, float y, float z) {
+    SimplexCell c = simplex_cell(x, y, z);
+
+    float x1 = c.x0 - c.o1[0] + kSimplexG3, y1 = c.y0 - c.o1[1] + kSimplexG3, z1 = c.z0 - c.o1[2] + kSimplexG3;
+    float x2 = c.x0 - c.o2[0] + 2.0f * kSimplexG3, y2 = c.y0 - c.o2[1] + 2.0f * kSimplexG3, z2 = c.z0 - c.o2[2] + 2.0f * kSimplexG3;
+    float x3 = c.x0 - 1.0f + 3.0f * kSimplexG3, y3 = c.y0 - 1.0f + 3.0f * kSimplexG3, z3 = c.z0 - 1.0f + 3.0f * kSimplexG3;
+
+    float n = simplex_corner(lattice.hash(c.i, c.j, c.k), c.x0, c.y0, c.z0);
+    n += simplex_corner(lattice.hash(c.i + c.o1[0], c.j + c.o1[1], c.k + c.o1[2]), x1, y1, z1);
+    n += simplex_corner(lattice.hash(c.i + c.o2[0], c.j + c.o2[1], c.k + c.o2[2]), x2, y2, z2);
+    n += simplex_corner(lattice.hash(c.i + 1, c.j + 1, c.k + 1), x3, y3, z3);
+    return kSimplexScale * n;
+}
+
+// simplex_corner의 미분 버전
+//   f = t^4 * (g · p),  t = 0.6 - |p|^2
+//   ∇f = t^4 * g - 8 t^3 (g · p) * p
+static inline void simplex_corner_d(int hash, float x, float y, float z, NoiseGrad& acc) {
+    float t = 0.6f - x * x - y * y - z * z;
+    if (t <= 0.0f) return;
+    NoiseGrad g = grad_d(hash, x, y, z);
+    float t2 = t * t;
+    float t4 = t2 * t2;
+    float k = -8.0f * t2 * t * g.value;
+    acc.value += t4 * g.value;
+    acc.dx += t4 * g.dx + k * x;
+    acc.dy += t4 * g.dy + k * y;
+    acc.dz += t4 * g.dz + k * z;
+}
+
+template <class Lattice>
+static NoiseGrad simplex_d_impl(Lattice lattice, float x, float y, float z) {
+    SimplexCell c = simplex_cell(x, y, z);
+
+    float x1 = c.x0 - c.o1[0] + kSimplexG3, y1 = c.y0 - c.o1[1] + kSimplexG3, z1 = c.z0 - c.o1[2] + kSimplexG3;
+    float x2 = c.x0 - c.o2[0] + 2.0f * kSimplexG3, y2 = c.y0 - c.o2[1] + 2.0f * kSimplexG3, z2 = c.z0 - c.o2[2] + 2.0f * kSimplexG3;
+    float x3 = c.x0 - 1.0f + 3.0f * kSimplexG3, y3 = c.y0 - 1.0f + 3.0f * kSimplexG3, z3 = c.z0 - 1.0f + 3.0f * kSimplexG3;
+
+    // 값은 simplex_impl과 같은 순서로 더한다. (0 + a + b + c + d)
+    NoiseGrad acc = { 0.0f, 0.0f, 0.0f, 0.0f };
+    simplex_corner_d(lattice.hash(c.i, c.j, c.k), c.x0, c.y0, c.z0, acc);
+    simplex_corner_d(lattice.hash(c.i + c.o1[0], c.j + c.o1[1], c.k + c.o1[2]), x1, y1, z1, acc);
+    simplex_corner_d(lattice.hash(c.i + c.o2[0], c.j + c.o2[1], c.k + c.o2[2]), x2, y2, z2, acc);
+    simplex_corner_d(lattice.hash(c.i + 1, c.j + 1, c.k + 1), x3, y3, z3, acc);
+    return { kSimplexScale * acc.value, kSimplexScale * acc.dx, kSimplexScale * acc.dy, kSimplexScale * acc.dz };
+}
+
+// -------------------------------------------------------------
+// 노이즈 종류(basis)별 샘플러 + 방식/종류 선택
+// -------------------------------------------------------------
+// fbm / ridged_fbm 등은 샘플러의
+//   noise(x, y, z)   : 값
+//   noise.d(x, y, z) : 값 + 기울기
+// 만 사용한다. with_noise가 (Table / Hashed) x (Perlin / Simplex) 중
+// 하나를 골라 한 번만 넘겨 주므로, 옥타브 루프 안에는 분기가 없다.
+// -------------------------------------------------------------
+template <class Lattice>
+struct PerlinNoise {
+    Lattice lattice;
+    float operator()(float x, float y, float z) const { return lattice(x, y, z); }
+    NoiseGrad d(float x, float y, float z) const { return perlin_d_impl(lattice, x, y, z); }
+};
+
+template <class Lattice>
+struct SimplexNoise {
+    Lattice lattice;
+    float operator()(float x, float y, float z) const { return simplex_impl(lattice, x, y, z); }
+    NoiseGrad d(float x, float y, float z) const { return simplex_d_impl(lattice, x, y, z); }
+};
+
+template <class F>
+static auto with_noise(const NoiseTable& table, NoiseBasis basis, F&& f)
+    -> decltype(f(PerlinNoise<TableLattice>{ TableLattice{ table.perm } })) {
+    if (table.backend == NoiseBackend::Hashed) {
+        HashedLattice lattice{ table.hashSeed };
+        if (basis == NoiseBasis::Simplex) return f(SimplexNoise<HashedLattice>{ lattice });
+        return f(PerlinNoise<HashedLattice>{ lattice });
+    }
+    TableLattice lattice{ table.perm };
+    if (basis == NoiseBasis::Simplex) return f(SimplexNoise<TableLattice>{ lattice });
+    return f(PerlinNoise<TableLattice>{ lattice });
+}
+
+float perlin(const NoiseTable& table, float x, float y, float z) {
+    if (table.backend == NoiseBackend::Hashed) return perlin_hashed_impl(table.hashSeed, x, y, z);
+    return perlin_impl(table.perm, x, y, z);
+}
+
+float perlin(float x, float y, float z) {
+    return perlin(defaultNoiseTable(), x, y, z);
+}
+
+float simplex(const NoiseTable& table, float x, float y, float z) {
+    if (table.backend == NoiseBackend::Hashed) return simplex_impl(HashedLattice{ table.hashSeed }, x, y, z);
+    return simplex_impl(TableLattice{ table.perm }, x, y, z);
+}
+
 // -------------------------------------------------------------
 // fbm (Fractal Brownian Motion)
 // -------------------------------------------------------------
@@ -157,14 +560,16 @@ float perlin(float x, float y, float z) {
 // - gain       → 옥타브마다 강도 감소
 // - 결과: 0 ~ 1 정도의 값
 // -------------------------------------------------------------
-float fbm(float x, float y, float z, int octaves, float lacunarity, float gain) {
+template <class Noise>
+static float fbm_impl(Noise noise, float x, float y, float z, int octaves, float lacunarity, float gain) {
+    PLANET_PERF_ADD(NoiseSamples, octaves);
     float amplitude = 1.0f;
     float frequency = 1.0f;
     float sum = 0.0f;
     float maxAmp = 0.0f;
 
     for (int i = 0; i < octaves; ++i) {
-        float n = perlin(x * frequency, y * frequency, z * frequency);
+        float n = noise(x * frequency, y * frequency, z * frequency);
         n = n * 0.5f + 0.5f; // -1~1 → 0~1 로 변환
 
         sum += n * amplitude; // 누적
@@ -177,6 +582,17 @@ float fbm(float x, float y, float z, int octaves, float lacunarity, float gain)
     return sum / maxAmp;  // 정규화
 }
 
+float fbm(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+          NoiseBasis basis) {
+    return with_noise(table, basis, [&](auto noise) {
+        return fbm_impl(noise, x, y, z, octaves, lacunarity, gain);
+    });
+}
+
+float fbm(float x, float y, float z, int octaves, float lacunarity, float gain) {
+    return fbm(defaultNoiseTable(), x, y, z, octaves, lacunarity, gain);
+}
+
 // -------------------------------------------------------------
 // ridged_fbm
 // -------------------------------------------------------------
@@ -190,14 +606,16 @@ float fbm(float x, float y, float z, int octaves, float lacunarity, float gain)
 //
 // 이 노이즈는 행성의 산맥·봉우리를 만들 때 핵심이다.
 // -------------------------------------------------------------
-float ridged_fbm(float x, float y, float z, int octaves, float lacunarity, float gain) {
+template <class Noise>
+static float ridged_fbm_impl(Noise noise, float x, float y, float z, int octaves, float lacunarity, float gain) {
+    PLANET_PERF_ADD(NoiseSamples, octaves);
     float sum = 0.0f;
     float frequency = 1.0f;
     float amplitude = 1.0f;
     float weight = 1.0f;
 
     for (int i = 0; i < octaves; ++i) {
-        float n = perlin(x * frequency, y * frequency, z * frequency);
+        float n = noise(x * frequency, y * frequency, z * frequency);
 
         // |n|가 클수록 낮아지고, 1-|n|이 높아져 산맥 형태가 된다.
         n = 1.0f - std::fabs(n);
@@ -214,4 +632,209 @@ float ridged_fbm(float x, float y, float z, int octaves, float lacunarity, float
         amplitude *= 0.5f;
     }
     return sum; // 보통 0 ~ 1.2 정도
-}
\ No newline at end of file
+}
+
+float ridged_fbm(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                 NoiseBasis basis) {
+    return with_noise(table, basis, [&](auto noise) {
+        return ridged_fbm_impl(noise, x, y, z, octaves, lacunarity, gain);
+    });
+}
+
+float ridged_fbm(float x, float y, float z, int octaves, float lacunarity, float gain) {
+    return ridged_fbm(defaultNoiseTable(), x, y, z, octaves, lacunarity, gain);
+}
+
+// -------------------------------------------------------------
+// fbm_d / ridged_fbm_d
+// -------------------------------------------------------------
+// fbm / ridged_fbm과 같은 루프에 기울기 누적을 더한 것.
+// -------------------------------------------------------------
+template <class Noise>
+static NoiseGrad fbm_d_impl(Noise noise, float x, float y, float z, int octaves, float lacunarity, float gain) {
+    PLANET_PERF_ADD(NoiseSamples, octaves);
+    float amplitude = 1.0f;
+    float frequency = 1.0f;
+    float sum = 0.0f;
+    float maxAmp = 0.0f;
+    float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+
+    for (int i = 0; i < octaves; ++i) {
+        NoiseGrad g = noise.d(x * frequency, y * frequency, z * frequency);
+        float n = g.value * 0.5f + 0.5f;
+
+        sum += n * amplitude;
+        maxAmp += amplitude;
+
+        // d/dx [ (perlin(x*f) * 0.5 + 0.5) * amp ] = perlin'(x*f) * f * 0.5 * amp
+        float k = 0.5f * amplitude * frequency;
+        dx += g.dx * k;
+        dy += g.dy * k;
+        dz += g.dz * k;
+
+        amplitude *= gain;
+        frequency *= lacunarity;
+    }
+    if (maxAmp == 0.0f) return { 0.0f, 0.0f, 0.0f, 0.0f };
+    return { sum / maxAmp, dx / maxAmp, dy / maxAmp, dz / maxAmp };
+}
+
+template <class Noise>
+static NoiseGrad ridged_fbm_d_impl(Noise noise, float x, float y, float z, int octaves, float lacunarity, float gain) {
+    PLANET_PERF_ADD(NoiseSamples, octaves);
+    float sum = 0.0f;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float weight = 1.0f;
+    float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+    float wdx = 0.0f, wdy = 0.0f, wdz = 0.0f; // weight의 기울기
+
+    for (int i = 0; i < octaves; ++i) {
+        NoiseGrad g = noise.d(x * frequency, y * frequency, z * frequency);
+
+        // n = 1 - |p|  →  n' = -sign(p) * p' * f
+        float n = 1.0f - std::fabs(g.value);
+        float k = (g.value < 0.0f ? 1.0f : -1.0f) * frequency;
+        float ndx = g.dx * k, ndy = g.dy * k, ndz = g.dz * k;
+
+        // n = n^2  →  n' = 2n * n'
+        ndx *= 2.0f * n; ndy *= 2.0f * n; ndz *= 2.0f * n;
+        n *= n;
+
+        // n = n * weight  →  n' = n' * weight + n * weight'
+        ndx = ndx * weight + n * wdx;
+        ndy = ndy * weight + n * wdy;
+        ndz = ndz * weight + n * wdz;
+        n *= weight;
+
+        sum += n * amplitude;
+        dx += ndx * amplitude;
+        dy += ndy * amplitude;
+        dz += ndz * amplitude;
+
+        // weight = clamp(n * gain, 0, 1) : 잘린 구간에서는 기울기가 0
+        float wv = n * gain;
+        weight = clampf(wv, 0.0f, 1.0f);
+        bool inside = wv > 0.0f && wv < 1.0f;
+        wdx = inside ? ndx * gain : 0.0f;
+        wdy = inside ? ndy * gain : 0.0f;
+        wdz = inside ? ndz * gain : 0.0f;
+
+        frequency *= lacunarity;
+        amplitude *= 0.5f;
+    }
+    return { sum, dx, dy, dz };
+}
+
+NoiseGrad perlin_d(const NoiseTable& table, float x, float y, float z) {
+    if (table.backend == NoiseBackend::Hashed) return perlin_d_impl(HashedLattice{ table.hashSeed }, x, y, z);
+    return perlin_d_impl(TableLattice{ table.perm }, x, y, z);
+}
+
+NoiseGrad simplex_d(const NoiseTable& table, float x, float y, float z) {
+    if (table.backend == NoiseBackend::Hashed) return simplex_d_impl(HashedLattice{ table.hashSeed }, x, y, z);
+    return simplex_d_impl(TableLattice{ table.perm }, x, y, z);
+}
+
+NoiseGrad fbm_d(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                NoiseBasis basis) {
+    return with_noise(table, basis, [&](auto noise) {
+        return fbm_d_impl(noise, x, y, z, octaves, lacunarity, gain);
+    });
+}
+
+NoiseGrad ridged_fbm_d(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                       NoiseBasis basis) {
+    return with_noise(table, basis, [&](auto noise) {
+        return ridged_fbm_d_impl(noise, x, y, z, octaves, lacunarity, gain);
+    });
+}
+
+// -------------------------------------------------------------
+// terrain_layers (합쳐진 지형 커널)
+// -------------------------------------------------------------
+// get_height는 원래 fbm(대륙) → fbm(디테일) → ridged_fbm(산맥)을
+// 차례로 세 번 불렀다. 그러면
+//   - 옥타브마다 주파수/강도를 세 번 따로 계산하고
+//   - perlin을 부를 때마다 기본 테이블 초기화 검사를 하고
+//   - 한 층이 끝나야 다음 층을 시작하는 긴 의존 사슬이 생긴다.
+//
+// 여기서는 옥타브 루프 하나 안에서 세 층의 perlin을 같이 계산한다.
+// 세 perlin은 서로 독립이라 CPU가 동시에 실행할 수 있고,
+// 주파수/강도 증가와 fbm 정규화 값(maxAmp)도 한 번만 계산한다.
+//
+// 계산 순서는 fbm / ridged_fbm과 같으므로 결과도 같다.
+// (허용 오차 |차이| <= 1e-6, 실제 측정 결과는 비트 단위로 동일)
+//
+// 입력 (x,y,z)는 정규화된 방향이어야 한다.
+// 반환값은 각 층의 강도(macroAmp 등)까지 곱한 값.
+// -------------------------------------------------------------
+template <class Lattice>
+static TerrainLayers terrain_layers_impl(Lattice lattice, const NoiseParams& p, float x, float y, float z) {
+    // 층마다 노이즈 종류(Perlin / Simplex)가 다를 수 있다.
+    // (분기 결과는 호출 내내 같아서 예측이 항상 맞는다)
+    auto noise = [&lattice](NoiseBasis basis, float sx, float sy, float sz) {
+        return basis == NoiseBasis::Simplex ? simplex_impl(lattice, sx, sy, sz) : lattice(sx, sy, sz);
+    };
+
+    // 층별 기본 좌표 (층마다 주파수만 다르다)
+    const float mx = x * p.macroFreq, my = y * p.macroFreq, mz = z * p.macroFreq;
+    const float ux = x * p.microFreq, uy = y * p.microFreq, uz = z * p.microFreq;
+    const float rx = x * p.ridgeFreq, ry = y * p.ridgeFreq, rz = z * p.ridgeFreq;
+
+    const int octaves = std::max(p.macroOctaves, std::max(p.microOctaves, p.ridgeOctaves));
+    PLANET_PERF_ADD(NoiseSamples, p.macroOctaves + p.microOctaves + p.ridgeOctaves);
+    PLANET_PERF_ADD(MacroOctaves, p.macroOctaves);
+    PLANET_PERF_ADD(MicroOctaves, p.microOctaves);
+    PLANET_PERF_ADD(RidgeOctaves, p.ridgeOctaves);
+
+    float frequency = 1.0f;  // 세 층이 같이 쓰는 주파수 배율
+    float amplitude = 1.0f;  // fbm 강도 (macro, micro 공통)
+    float ridgeAmp = 1.0f;   // ridged_fbm 강도 (옥타브마다 절반)
+    float weight = 1.0f;     // ridged_fbm의 이전 옥타브 영향
+
+    float macroSum = 0.0f, microSum = 0.0f, ridgeSum = 0.0f;
+    float macroMax = 0.0f, microMax = 0.0f;
+
+    // 층별 시간(PerfStage::Macro / Micro / Ridge)은 옥타브마다 층 하나를 계산할 때마다 더한다.
+    PLANET_PERF_CLOCK(clock);
+    for (int i = 0; i < octaves; ++i) {
+        if (i < p.macroOctaves) {
+            float n = noise(p.macroBasis, mx * frequency, my * frequency, mz * frequency);
+            macroSum += (n * 0.5f + 0.5f) * amplitude;
+            macroMax += amplitude;
+            PLANET_PERF_LAP(clock, Macro);
+        }
+        if (i < p.microOctaves) {
+            float n = noise(p.microBasis, ux * frequency, uy * frequency, uz * frequency);
+            microSum += (n * 0.5f + 0.5f) * amplitude;
+            microMax += amplitude;
+            PLANET_PERF_LAP(clock, Micro);
+        }
+        if (i < p.ridgeOctaves) {
+            float n = noise(p.ridgeBasis, rx * frequency, ry * frequency, rz * frequency);
+            n = 1.0f - std::fabs(n);
+            n *= n;
+            n *= weight;
+            ridgeSum += n * ridgeAmp;
+            weight = clampf(n * p.gain, 0.0f, 1.0f);
+            PLANET_PERF_LAP(clock, Ridge);
+        }
+
+        amplitude *= p.gain;
+        frequency *= p.lacunarity;
+        ridgeAmp *= 0.5f;
+    }
+
+    TerrainLayers out;
+    out.macro = (macroMax == 0.0f ? 0.0f : macroSum / macroMax) * p.macroAmp;
+    out.micro = (microMax == 0.0f ? 0.0f : microSum / microMax) * p.microAmp;
+    out.ridge = ridgeSum * p.ridgeAmp;
+    return out;
+}
+
+TerrainLayers terrain_layers(const NoiseTable& table, const NoiseParams& p, float x, float y, float z) {
+    if (table.backend == NoiseBackend::Hashed)
+        return terrain_layers_impl(HashedLattice{ table.hashSeed }, p, x, y, z);
+    return terrain_layers_impl(TableLattice{ table.perm }, p, x, y, z);
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// noise.hpp
+// -------------------------------------------------------------
+// noise.cpp / noise_simd.cpp 에 구현된 노이즈 함수들의 선언부.
+//
+// 예전에는 planet.cpp 안에 선언을 직접 적어두었지만,
+// 배치(batch) 함수들이 추가되면서 한곳에 모아 두었다.
+// -------------------------------------------------------------
+
+// -------------------------------------------------------------
+// NoiseTable: 퍼뮤테이션 테이블(길이 512) 한 벌
+// -------------------------------------------------------------
+// 예전에는 noise.cpp 안에 테이블이 딱 하나(전역)만 있어서
+// 행성 두 개를 동시에 만들 수 없었다.
+// 이제 테이블을 값으로 들고 다니므로, 행성 생성기(PlanetGenerator)마다
+// 자기 테이블을 하나씩 가질 수 있다.
+//
+// 격자 점의 랜덤 값을 어디서 가져올지(backend)도 여기서 정한다.
+//   - Table  : 퍼뮤테이션 테이블 조회 (원래 Perlin 방식, 기본값)
+//   - Hashed : 정수 해시(latticeHash, util.hpp) 계산
+//              테이블 조회(gather)가 없어서 SIMD로 계산하기 훨씬 쉽다.
+// 두 방식은 같은 seed라도 서로 다른 지형을 만든다. (둘 다 seed가 같으면 항상 같은 지형)
+// -------------------------------------------------------------
+enum class NoiseBackend : int {
+    Table = 0,
+    Hashed = 1,
+};
+
+struct NoiseTable {
+    int perm[512];         // Table 방식에서 쓰는 퍼뮤테이션 테이블
+    uint32_t hashSeed;     // Hashed 방식에서 쓰는 seed (hash32(seed))
+    NoiseBackend backend;
+};
+
+// -------------------------------------------------------------
+// NoiseBasis: 옥타브마다 쌓을 기본 노이즈의 종류
+// -------------------------------------------------------------
+//   - Perlin  : 정육면체 격자, 꼭짓점 8개 보간 (기본값)
+//   - Simplex : 사면체 격자, 꼭짓점 4개 합 → 더 가볍고 축 방향 무늬가 적다
+// NoiseParams에서 층(macro / micro / ridge)마다 따로 고를 수 있다.
+// -------------------------------------------------------------
+enum class NoiseBasis : int {
+    Perlin = 0,
+    Simplex = 1,
+};
+
+// seed로 테이블을 섞는다. (seed가 같으면 항상 같은 테이블)
+// Hashed 방식이면 퍼뮤테이션 테이블은 만들지 않는다.
+void initNoiseTable(NoiseTable& table, uint32_t seed, NoiseBackend backend = NoiseBackend::Table);
+
+// ---------------- 한 점씩 계산하는 함수 (noise.cpp) ----------------
+// table 인자를 받는 버전은 전역 상태를 건드리지 않으므로
+// 여러 스레드에서 동시에 불러도 안전하다.
+// basis로 옥타브마다 쌓을 노이즈(Perlin / Simplex)를 고른다.
+float perlin(const NoiseTable& table, float x, float y, float z);
+float simplex(const NoiseTable& table, float x, float y, float z);
+float fbm(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+          NoiseBasis basis = NoiseBasis::Perlin);
+float ridged_fbm(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                 NoiseBasis basis = NoiseBasis::Perlin);
+
+// 예전 API: noise.cpp 안의 기본(전역) 테이블을 사용한다.
+void initNoise(uint32_t seed); // 시드(seed)를 기반으로 기본 테이블 초기화
+float perlin(float x, float y, float z);
+float fbm(float x, float y, float z, int octaves, float lacunarity, float gain);
+float ridged_fbm(float x, float y, float z, int octaves, float lacunarity, float gain);
+
+// 기본(전역) 테이블.
+// 아직 initNoise가 호출되지 않았다면 기본 seed(0)로 먼저 초기화한다.
+const NoiseTable& defaultNoiseTable();
+
+// ---------------- 값 + 기울기(gradient)를 같이 계산하는 함수 (noise.cpp) ----------------
+//
+// value는 perlin / fbm / ridged_fbm 과 같은 값이고,
+// (dx, dy, dz)는 입력 좌표 (x, y, z)에 대한 해석적 편미분이다.
+// 지형 법선을 메쉬 없이 바로 구할 때 쓴다. (PlanetGenerator::heightAndNormal)
+struct NoiseGrad {
+    float value;
+    float dx, dy, dz;
+};
+
+NoiseGrad perlin_d(const NoiseTable& table, float x, float y, float z);
+NoiseGrad simplex_d(const NoiseTable& table, float x, float y, float z);
+NoiseGrad fbm_d(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                NoiseBasis basis = NoiseBasis::Perlin);
+NoiseGrad ridged_fbm_d(const NoiseTable& table, float x, float y, float z, int octaves, float lacunarity, float gain,
+                       NoiseBasis basis = NoiseBasis::Perlin);
+
+// ---------------- 지형용 합쳐진(fused) 커널 ----------------
+//
+// get_height가 쓰는 세 노이즈 층을 옥타브 루프 하나에서 같이 계산한다.
+// 결과는 fbm / fbm / ridged_fbm을 따로 부른 것과 같다.
+struct NoiseParams;
+
+struct TerrainLayers {
+    float macro; // 대륙 층 (macroAmp까지 곱한 값)
+    float micro; // 작은 디테일 층 (microAmp까지 곱한 값)
+    float ridge; // 산맥 층 (ridgeAmp까지 곱한 값)
+};
+
+// (x,y,z) : 정규화된 방향 (noise.cpp)
+TerrainLayers terrain_layers(const NoiseTable& table, const NoiseParams& p, float x, float y, float z);
+
+// terrain_layers의 배치 버전 (noise_simd.cpp)
+// 옥타브마다 세 층의 좌표를 한 버퍼에 모아 perlin_batch를 한 번만 부른다.
+// (Simplex 층은 따로 모아 simplex_batch로 계산)
+void terrain_layers_batch(const NoiseTable& table, const NoiseParams& p,
+                          const float* xs, const float* ys, const float* zs,
+                          float* macro, float* micro, float* ridge, size_t n);
+
+// ---------------- 여러 점을 한 번에 계산하는 함수 (noise_simd.cpp) ----------------
+//
+// xs[i], ys[i], zs[i] 좌표 n개를 받아 out[i]에 결과를 쓴다.
+// 실행 중인 CPU를 한 번 검사해서 AVX-512 / AVX2 / SSE4.1 / 스칼라 커널 중
+// 가장 빠른 것을 골라 쓴다. (WASM은 -msimd128 빌드일 때 SIMD128 커널)
+// 결과는 한 점씩 계산한 perlin/fbm/ridged_fbm 과 같다.
+// simplex_batch는 아직 SIMD 커널이 없어서 점마다 simplex()를 부른다.
+void perlin_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                  float* out, size_t n);
+void simplex_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                   float* out, size_t n);
+void fbm_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+               float* out, size_t n, int octaves, float lacunarity, float gain,
+               NoiseBasis basis = NoiseBasis::Perlin);
+void ridged_fbm_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                      float* out, size_t n, int octaves, float lacunarity, float gain,
+                      NoiseBasis basis = NoiseBasis::Perlin);
+
+// 값 + 기울기 배치 버전 (perlin_d / simplex_d / fbm_d / ridged_fbm_d와 같은 결과)
+// 점 i의 값과 기울기를 value[i], dx[i], dy[i], dz[i]에 쓴다.
+// perlin_d_batch는 perlin_batch와 같은 명령어 집합의 커널을 쓰고, simplex_d_batch는 점마다 계산한다.
+void perlin_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                    float* value, float* dx, float* dy, float* dz, size_t n);
+void simplex_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                     float* value, float* dx, float* dy, float* dz, size_t n);
+void fbm_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                 float* value, float* dx, float* dy, float* dz, size_t n,
+                 int octaves, float lacunarity, float gain, NoiseBasis basis = NoiseBasis::Perlin);
+void ridged_fbm_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                        float* value, float* dx, float* dy, float* dz, size_t n,
+                        int octaves, float lacunarity, float gain, NoiseBasis basis = NoiseBasis::Perlin);
+
+// 예전 API: 기본(전역) 테이블을 사용하는 배치 함수
+void perlin_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n);
+void fbm_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+               int octaves, float lacunarity, float gain);
+void ridged_fbm_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+                      int octaves, float lacunarity, float gain);
+
+// 현재 선택된 perlin_batch 커널 이름 ("avx512", "avx2", "sse4.1", "simd128", "scalar")
+// (환경 변수 PLANET_SIMD로 CPU가 지원하는 커널 중 하나를 고를 수 있다)
+const char* perlin_batch_kernel_name();
@@ -1,31 +1,15 @@
 #include "util.hpp"
+#include "noise_params.hpp"
 
 // -------------------------------------------------------------
-// NoiseParams 구조체 설명
+// NoiseParams 구조체 설명 (구조체 정의는 noise_params.hpp)
 // -------------------------------------------------------------
-// planet.cpp 에서 사용하는 노이즈 설정값과 동일한 구조.
 // 이 값들은 “행성의 대륙 모양, 산맥, 지형 디테일” 등을
 // 어떤 스타일로 만들지 결정하는 설정값 묶음이다.
 //
 // 여기서 만든 NoiseParams는 seed(정수) 하나만 바뀌어도
 // 완전히 다른 행성이 생성되도록 설계되어 있다.
 // -------------------------------------------------------------
-struct NoiseParams {
-    float macroFreq;      // 대륙 크기를 결정하는 노이즈 주파수
-    int   macroOctaves;   // 대륙 노이즈 반복 횟수 (옥타브 수)
-    float macroAmp;       // 대륙 전체 높이(산과 골짜기)의 강도
-
-    float microFreq;      // 작은 규모 지형 디테일의 주파수
-    int   microOctaves;   // micro 디테일의 옥타브 수
-    float microAmp;       // micro 디테일 강도
-
-    float ridgeFreq;      // 산맥 패턴의 주파수
-    int   ridgeOctaves;   // 산맥 옥타브 수
-    float ridgeAmp;       // 산맥의 강도 (얼마나 날카로운 산이 생기는지)
-
-    float lacunarity;     // 옥타브 간 주파수 증가 비율
-    float gain;           // 옥타브 간 강도 감소 비율
-};
 
 // -------------------------------------------------------------
 // r(seed, salt, a, b)
@@ -91,5 +75,14 @@ NoiseParams generateNoiseParams(uint32_t seed) {
     p.lacunarity = r(seed, 41, 1.8f, 2.2f);
     p.gain = r(seed, 42, 0.35f, 0.6f);
 
+    // ---------------------------------------------------------
+    // 5) 층별 기본 노이즈 종류
+    // ---------------------------------------------------------
+    // seed로 정하지 않는다. (기존 행성 모양이 그대로 유지되도록 Perlin)
+    // Simplex는 PlanetGenerator::setLayerBasis로 따로 고른다.
+    p.macroBasis = NoiseBasis::Perlin;
+    p.microBasis = NoiseBasis::Perlin;
+    p.ridgeBasis = NoiseBasis::Perlin;
+
     return p;
 }
\ No newline at end of file
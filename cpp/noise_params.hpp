@@ -0,0 +1,36 @@
+#pragma once
+#include "noise.hpp" // NoiseBasis
+#include <cstdint>
+
+// noise_params.hpp
+// -------------------------------------------------------------
+// 노이즈 파라미터 구조체
+// (행성의 지형을 어떤 스타일로 만들지 결정하는 설정 값 묶음)
+//
+// 예전에는 planet.cpp와 noise_params.cpp에 같은 구조체가 따로 적혀 있었는데,
+// noise.cpp의 합쳐진(fused) 지형 커널도 이 구조체를 쓰게 되어 한곳으로 모았다.
+// -------------------------------------------------------------
+struct NoiseParams {
+    float macroFreq;      // 대륙 크기를 결정하는 노이즈 주파수
+    int   macroOctaves;   // 대륙 노이즈의 반복(옥타브) 수
+    float macroAmp;       // 대륙 높이의 강도(얼마나 솟아오르는지)
+
+    float microFreq;      // 작은 지형들(작은 산/골짜기)용 주파수
+    int   microOctaves;   // micro 노이즈 옥타브
+    float microAmp;       // micro 디테일 강도
+
+    float ridgeFreq;      // 산맥 생성 노이즈의 주파수
+    int   ridgeOctaves;   // ridge 노이즈 옥타브
+    float ridgeAmp;       // 산맥의 강도
+
+    float lacunarity;     // 옥타브 간 주파수 증가율
+    float gain;           // 옥타브 간 강도 감소율
+
+    // 층별 기본 노이즈 종류 (generateNoiseParams는 모두 Perlin으로 둔다)
+    NoiseBasis macroBasis;
+    NoiseBasis microBasis;
+    NoiseBasis ridgeBasis;
+};
+
+// NoiseParams를 시드로부터 자동 생성하는 함수(노이즈 스타일 결정)
+NoiseParams generateNoiseParams(uint32_t seed);
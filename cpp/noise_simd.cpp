@@ -0,0 +1,1655 @@
+// noise_simd.cpp
+// -------------------------------------------------------------
+// 이 파일은 noise.cpp의 Perlin / fBm / Ridged 노이즈를
+// “여러 점을 한꺼번에” 계산하는 배치(batch) 버전을 구현한 곳이다.
+//
+// perlin()은 한 번에 점 하나만 계산하기 때문에,
+// 점이 수십만 개가 되면 같은 계산을 수십만 번 반복하게 된다.
+// 여기서는 CPU의 SIMD 명령어(SSE4.1 / AVX2 / AVX-512)를 이용해
+// 4개 / 8개 / 16개 점을 한 번에 계산한다.
+//
+// 어떤 명령어를 쓸지는 실행 중에 CPU를 한 번 검사해서 결정한다.
+// 환경 변수 PLANET_SIMD(scalar / sse4.1 / avx2 / avx512)로 더 느린 커널을 고를 수도 있다.
+// (CPU가 지원하지 않는 이름이면 무시한다. 커널마다 테스트를 돌릴 때 사용)
+// WASM은 실행 중 검사가 불가능하므로 빌드 옵션으로 정한다.
+//   - emcc -msimd128 로 빌드 → SIMD128 커널 (4개씩)
+//   - 그냥 빌드             → 스칼라 커널
+// (x86이 아닌 CPU에서도 스칼라 커널로 동작)
+//
+// 결과는 한 점씩 계산하는 perlin()과 같은 연산 순서를 따르므로
+// 같은 값을 돌려준다.
+//
+// 명령어 집합마다 커널이 두 벌씩 있다.
+//   - Table  방식 : 퍼뮤테이션 테이블 조회 (SSE4.1/WASM은 한 칸씩, AVX2 이상은 gather)
+//   - Hashed 방식 : 격자 해시를 정수 곱셈으로 계산 (gather 없음)
+// -------------------------------------------------------------
+
+#include "util.hpp"
+#include "noise.hpp"
+#include "noise_params.hpp"
+#include "perf_counters.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NOISE_SIMD_X86 1
+#endif
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define NOISE_SIMD_WASM 1
+#endif
+
+// AVX-512를 켜면 GCC가 곱셈+덧셈을 FMA 한 번으로 합쳐 버려서
+// 스칼라 perlin()과 마지막 자리 값이 달라진다. 같은 결과를 위해 합치지 않게 한다.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+
+// fbm_batch / ridged_fbm_batch가 한 번에 처리하는 점 개수.
+// 스택 버퍼 크기이기도 해서 너무 크게 잡지 않는다.
+constexpr size_t kBatchChunk = 256;
+
+using PerlinKernel = void (*)(const NoiseTable& table,
+                              const float* xs, const float* ys, const float* zs,
+                              float* out, size_t n);
+
+// 값 + 기울기 커널: out = { 값, d/dx, d/dy, d/dz } 배열 4개
+// (Table / Hashed 방식을 한 커널이 같이 처리한다. 방식 분기는 점 묶음마다 한 번)
+using PerlinDKernel = void (*)(const NoiseTable& table,
+                               const float* xs, const float* ys, const float* zs,
+                               float* const out[4], size_t n);
+
+// -------------------------------------------------------------
+// 스칼라 커널
+// -------------------------------------------------------------
+// SIMD를 쓸 수 없는 환경(WASM, 오래된 CPU)에서 사용.
+// -------------------------------------------------------------
+void perlin_kernel_scalar(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                          float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = perlin(table, xs[i], ys[i], zs[i]);
+}
+
+void perlin_d_kernel_scalar(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                            float* const out[4], size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        NoiseGrad g = perlin_d(table, xs[i], ys[i], zs[i]);
+        out[0][i] = g.value;
+        out[1][i] = g.dx;
+        out[2][i] = g.dy;
+        out[3][i] = g.dz;
+    }
+}
+
+#ifdef NOISE_SIMD_X86
+
+// =============================================================
+// SSE4.1 커널 (4개씩)
+// =============================================================
+// SSE4.1에는 gather 명령어가 없으므로 테이블 조회는 한 칸씩 읽어서 모은다.
+
+__attribute__((target("sse4.1")))
+inline __m128 fade_sse(__m128 t) {
+    // t^3 * (t * (t * 6 - 15) + 10)
+    __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    __m128 k = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    k = _mm_add_ps(_mm_mul_ps(t, k), _mm_set1_ps(10.0f));
+    return _mm_mul_ps(t3, k);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128 lerp_sse(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i gather_sse(const int* perm, __m128i idx) {
+    alignas(16) int i[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(i), idx);
+    return _mm_setr_epi32(perm[i[0]], perm[i[1]], perm[i[2]], perm[i[3]]);
+}
+
+// grad()의 분기(h < 8 ? x : y ...)를 비교 마스크 + blend로 바꾼 것.
+// 부호 뒤집기(-u, -v)는 부호 비트 xor로 처리한다.
+__attribute__((target("sse4.1")))
+inline __m128 grad_sse(__m128i hash, __m128 x, __m128 y, __m128 z) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+    __m128 lt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+    __m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 useX = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                                _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+    __m128 u = _mm_blendv_ps(y, x, lt8);
+    __m128 v = _mm_blendv_ps(_mm_blendv_ps(z, x, useX), y, lt4);
+    __m128i su = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31);
+    __m128i sv = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30);
+    u = _mm_xor_ps(u, _mm_castsi128_ps(su));
+    v = _mm_xor_ps(v, _mm_castsi128_ps(sv));
+    return _mm_add_ps(u, v);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128 perlin_sse(const int* perm, __m128 x, __m128 y, __m128 z) {
+    const __m128i m255 = _mm_set1_epi32(255);
+    const __m128i one_i = _mm_set1_epi32(1);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 fx = _mm_floor_ps(x), fy = _mm_floor_ps(y), fz = _mm_floor_ps(z);
+    __m128i X = _mm_and_si128(_mm_cvttps_epi32(fx), m255);
+    __m128i Y = _mm_and_si128(_mm_cvttps_epi32(fy), m255);
+    __m128i Z = _mm_and_si128(_mm_cvttps_epi32(fz), m255);
+    x = _mm_sub_ps(x, fx);
+    y = _mm_sub_ps(y, fy);
+    z = _mm_sub_ps(z, fz);
+
+    __m128 u = fade_sse(x), v = fade_sse(y), w = fade_sse(z);
+
+    __m128i A  = _mm_add_epi32(gather_sse(perm, X), Y);
+    __m128i AA = _mm_add_epi32(gather_sse(perm, A), Z);
+    __m128i AB = _mm_add_epi32(gather_sse(perm, _mm_add_epi32(A, one_i)), Z);
+    __m128i B  = _mm_add_epi32(gather_sse(perm, _mm_add_epi32(X, one_i)), Y);
+    __m128i BA = _mm_add_epi32(gather_sse(perm, B), Z);
+    __m128i BB = _mm_add_epi32(gather_sse(perm, _mm_add_epi32(B, one_i)), Z);
+
+    __m128 x1 = _mm_sub_ps(x, one), y1 = _mm_sub_ps(y, one), z1 = _mm_sub_ps(z, one);
+
+    __m128 r0 = lerp_sse(
+        lerp_sse(grad_sse(gather_sse(perm, AA), x, y, z),
+                 grad_sse(gather_sse(perm, BA), x1, y, z), u),
+        lerp_sse(grad_sse(gather_sse(perm, AB), x, y1, z),
+                 grad_sse(gather_sse(perm, BB), x1, y1, z), u),
+        v);
+    __m128 r1 = lerp_sse(
+        lerp_sse(grad_sse(gather_sse(perm, _mm_add_epi32(AA, one_i)), x, y, z1),
+                 grad_sse(gather_sse(perm, _mm_add_epi32(BA, one_i)), x1, y, z1), u),
+        lerp_sse(grad_sse(gather_sse(perm, _mm_add_epi32(AB, one_i)), x, y1, z1),
+                 grad_sse(gather_sse(perm, _mm_add_epi32(BB, one_i)), x1, y1, z1), u),
+        v);
+    return lerp_sse(r0, r1, w);
+}
+
+__attribute__((target("sse4.1")))
+void perlin_kernel_sse41(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                         float* out, size_t n) {
+    const int* perm = table.perm;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 r = perlin_sse(perm, _mm_loadu_ps(xs + i), _mm_loadu_ps(ys + i), _mm_loadu_ps(zs + i));
+        _mm_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        // 남은 점들은 0으로 채운 임시 버퍼에 옮겨 한 번 더 계산
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        _mm_store_ps(tr, perlin_sse(perm, _mm_load_ps(tx), _mm_load_ps(ty), _mm_load_ps(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- Hashed 방식 (SSE4.1) ----------------
+// 테이블 조회 대신 latticeHash(util.hpp)를 4개씩 계산한다.
+// 곱셈(_mm_mullo_epi32)과 shift/xor만 쓰므로 gather가 필요 없다.
+
+__attribute__((target("sse4.1")))
+inline __m128i hash32_sse(__m128i x) {
+    x = _mm_xor_si128(_mm_xor_si128(x, _mm_set1_epi32(61)), _mm_srli_epi32(x, 16));
+    x = _mm_add_epi32(x, _mm_slli_epi32(x, 3));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 4));
+    x = _mm_mullo_epi32(x, _mm_set1_epi32(0x27d4eb2d));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    return x;
+}
+
+__attribute__((target("sse4.1")))
+inline __m128 perlin_hashed_sse(__m128i seed, __m128 x, __m128 y, __m128 z) {
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 fx = _mm_floor_ps(x), fy = _mm_floor_ps(y), fz = _mm_floor_ps(z);
+    __m128i hx0 = _mm_mullo_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m128i hy0 = _mm_mullo_epi32(_mm_cvttps_epi32(fy), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m128i hz0 = _mm_mullo_epi32(_mm_cvttps_epi32(fz), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m128i hy1 = _mm_add_epi32(hy0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    x = _mm_sub_ps(x, fx);
+    y = _mm_sub_ps(y, fy);
+    z = _mm_sub_ps(z, fz);
+
+    __m128 u = fade_sse(x), v = fade_sse(y), w = fade_sse(z);
+
+    // seed ^ hx ^ hy 를 먼저 만들어 두고 z만 바꿔 가며 해시
+    __m128i s0 = _mm_xor_si128(seed, hx0), s1 = _mm_xor_si128(seed, hx1);
+    __m128i A = _mm_xor_si128(s0, hy0), B = _mm_xor_si128(s1, hy0);
+    __m128i C = _mm_xor_si128(s0, hy1), D = _mm_xor_si128(s1, hy1);
+
+    __m128 x1 = _mm_sub_ps(x, one), y1 = _mm_sub_ps(y, one), z1 = _mm_sub_ps(z, one);
+
+    __m128 r0 = lerp_sse(
+        lerp_sse(grad_sse(hash32_sse(_mm_xor_si128(A, hz0)), x, y, z),
+                 grad_sse(hash32_sse(_mm_xor_si128(B, hz0)), x1, y, z), u),
+        lerp_sse(grad_sse(hash32_sse(_mm_xor_si128(C, hz0)), x, y1, z),
+                 grad_sse(hash32_sse(_mm_xor_si128(D, hz0)), x1, y1, z), u),
+        v);
+    __m128 r1 = lerp_sse(
+        lerp_sse(grad_sse(hash32_sse(_mm_xor_si128(A, hz1)), x, y, z1),
+                 grad_sse(hash32_sse(_mm_xor_si128(B, hz1)), x1, y, z1), u),
+        lerp_sse(grad_sse(hash32_sse(_mm_xor_si128(C, hz1)), x, y1, z1),
+                 grad_sse(hash32_sse(_mm_xor_si128(D, hz1)), x1, y1, z1), u),
+        v);
+    return lerp_sse(r0, r1, w);
+}
+
+__attribute__((target("sse4.1")))
+void perlin_hashed_kernel_sse41(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                                float* out, size_t n) {
+    const __m128i seed = _mm_set1_epi32(static_cast<int>(table.hashSeed));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 r = perlin_hashed_sse(seed, _mm_loadu_ps(xs + i), _mm_loadu_ps(ys + i), _mm_loadu_ps(zs + i));
+        _mm_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        _mm_store_ps(tr, perlin_hashed_sse(seed, _mm_load_ps(tx), _mm_load_ps(ty), _mm_load_ps(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- 값 + 기울기 (SSE4.1) ----------------
+// noise.cpp의 perlin_d_impl과 같은 순서로 계산한다.
+// grad()는 (x, y, z)의 1차식이므로 코너의 기울기는 단위 벡터를 넣은 grad 값이다.
+
+__attribute__((target("sse4.1")))
+inline __m128 fade_deriv_sse(__m128 t) {
+    // 30 * t * t * (t * (t - 2) + 1)
+    __m128 k = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(t, _mm_set1_ps(2.0f))), _mm_set1_ps(1.0f));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(30.0f), t), t), k);
+}
+
+__attribute__((target("sse4.1")))
+inline void grad_d_sse(__m128i hash, __m128 x, __m128 y, __m128 z, __m128 g[4]) {
+    const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    g[0] = grad_sse(hash, x, y, z);
+    g[1] = grad_sse(hash, one, zero, zero);
+    g[2] = grad_sse(hash, zero, one, zero);
+    g[3] = grad_sse(hash, zero, zero, one);
+}
+
+// axis : 보간 계수 t가 달라지는 축 (1 = x, 2 = y, 3 = z), dt : 그 축의 t 기울기
+__attribute__((target("sse4.1")))
+inline void lerp_d_sse(const __m128 a[4], const __m128 b[4], __m128 t, __m128 dt, int axis, __m128 out[4]) {
+    __m128 diff = _mm_sub_ps(b[0], a[0]);
+    for (int k = 0; k < 4; ++k) out[k] = lerp_sse(a[k], b[k], t);
+    out[axis] = _mm_add_ps(out[axis], _mm_mul_ps(dt, diff));
+}
+
+// h : 코너 해시 8개 (noise.cpp의 Lattice::corners와 같은 순서), x / y / z : 격자 안의 위치
+__attribute__((target("sse4.1")))
+inline void perlin_d_sse(const __m128i h[8], __m128 x, __m128 y, __m128 z, __m128 out[4]) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 u = fade_sse(x), du = fade_deriv_sse(x);
+    __m128 v = fade_sse(y), dv = fade_deriv_sse(y);
+    __m128 w = fade_sse(z), dw = fade_deriv_sse(z);
+    __m128 x1 = _mm_sub_ps(x, one), y1 = _mm_sub_ps(y, one), z1 = _mm_sub_ps(z, one);
+
+    __m128 a[4], b[4], x00[4], x10[4], x01[4], x11[4], y0[4], y1v[4];
+    grad_d_sse(h[0], x, y, z, a);   grad_d_sse(h[1], x1, y, z, b);   lerp_d_sse(a, b, u, du, 1, x00);
+    grad_d_sse(h[2], x, y1, z, a);  grad_d_sse(h[3], x1, y1, z, b);  lerp_d_sse(a, b, u, du, 1, x10);
+    grad_d_sse(h[4], x, y, z1, a);  grad_d_sse(h[5], x1, y, z1, b);  lerp_d_sse(a, b, u, du, 1, x01);
+    grad_d_sse(h[6], x, y1, z1, a); grad_d_sse(h[7], x1, y1, z1, b); lerp_d_sse(a, b, u, du, 1, x11);
+    lerp_d_sse(x00, x10, v, dv, 2, y0);
+    lerp_d_sse(x01, x11, v, dv, 2, y1v);
+    lerp_d_sse(y0, y1v, w, dw, 3, out);
+}
+
+__attribute__((target("sse4.1")))
+inline void perlin_d_point_sse(const NoiseTable& table, __m128 x, __m128 y, __m128 z, __m128 out[4]) {
+    const __m128i one_i = _mm_set1_epi32(1);
+    __m128 fx = _mm_floor_ps(x), fy = _mm_floor_ps(y), fz = _mm_floor_ps(z);
+    __m128i h[8];
+    if (table.backend == NoiseBackend::Hashed) {
+        const __m128i seed = _mm_set1_epi32(static_cast<int>(table.hashSeed));
+        __m128i hx0 = _mm_mullo_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m128i hy0 = _mm_mullo_epi32(_mm_cvttps_epi32(fy), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m128i hz0 = _mm_mullo_epi32(_mm_cvttps_epi32(fz), _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m128i hx1 = _mm_add_epi32(hx0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m128i hy1 = _mm_add_epi32(hy0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m128i hz1 = _mm_add_epi32(hz0, _mm_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m128i s0 = _mm_xor_si128(seed, hx0), s1 = _mm_xor_si128(seed, hx1);
+        __m128i c[4] = { _mm_xor_si128(s0, hy0), _mm_xor_si128(s1, hy0),
+                         _mm_xor_si128(s0, hy1), _mm_xor_si128(s1, hy1) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = hash32_sse(_mm_xor_si128(c[k], hz0));
+            h[k + 4] = hash32_sse(_mm_xor_si128(c[k], hz1));
+        }
+    } else {
+        const int* perm = table.perm;
+        const __m128i m255 = _mm_set1_epi32(255);
+        __m128i X = _mm_and_si128(_mm_cvttps_epi32(fx), m255);
+        __m128i Y = _mm_and_si128(_mm_cvttps_epi32(fy), m255);
+        __m128i Z = _mm_and_si128(_mm_cvttps_epi32(fz), m255);
+        __m128i A  = _mm_add_epi32(gather_sse(perm, X), Y);
+        __m128i B  = _mm_add_epi32(gather_sse(perm, _mm_add_epi32(X, one_i)), Y);
+        __m128i c[4] = { _mm_add_epi32(gather_sse(perm, A), Z), _mm_add_epi32(gather_sse(perm, B), Z),
+                         _mm_add_epi32(gather_sse(perm, _mm_add_epi32(A, one_i)), Z),
+                         _mm_add_epi32(gather_sse(perm, _mm_add_epi32(B, one_i)), Z) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = gather_sse(perm, c[k]);
+            h[k + 4] = gather_sse(perm, _mm_add_epi32(c[k], one_i));
+        }
+    }
+    perlin_d_sse(h, _mm_sub_ps(x, fx), _mm_sub_ps(y, fy), _mm_sub_ps(z, fz), out);
+}
+
+__attribute__((target("sse4.1")))
+void perlin_d_kernel_sse41(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                           float* const out[4], size_t n) {
+    __m128 r[4];
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        perlin_d_point_sse(table, _mm_loadu_ps(xs + i), _mm_loadu_ps(ys + i), _mm_loadu_ps(zs + i), r);
+        for (int k = 0; k < 4; ++k) _mm_storeu_ps(out[k] + i, r[k]);
+    }
+    if (i < n) {
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        perlin_d_point_sse(table, _mm_load_ps(tx), _mm_load_ps(ty), _mm_load_ps(tz), r);
+        for (int c = 0; c < 4; ++c) {
+            _mm_store_ps(tr, r[c]);
+            for (size_t k = 0; i + k < n; ++k) out[c][i + k] = tr[k];
+        }
+    }
+}
+
+// =============================================================
+// AVX2 커널 (8개씩)
+// =============================================================
+// AVX2부터는 vpgatherdd로 테이블 8칸을 한 번에 읽을 수 있다.
+
+__attribute__((target("avx2")))
+inline __m256 fade_avx2(__m256 t) {
+    __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+    __m256 k = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+    k = _mm256_add_ps(_mm256_mul_ps(t, k), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(t3, k);
+}
+
+__attribute__((target("avx2")))
+inline __m256 lerp_avx2(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+__attribute__((target("avx2")))
+inline __m256i gather_avx2(const int* perm, __m256i idx) {
+    return _mm256_i32gather_epi32(perm, idx, 4);
+}
+
+__attribute__((target("avx2")))
+inline __m256 grad_avx2(__m256i hash, __m256 x, __m256 y, __m256 z) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+    __m256 lt8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+    __m256 lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 useX = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                                                      _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    __m256 u = _mm256_blendv_ps(y, x, lt8);
+    __m256 v = _mm256_blendv_ps(_mm256_blendv_ps(z, x, useX), y, lt4);
+    __m256i su = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31);
+    __m256i sv = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30);
+    u = _mm256_xor_ps(u, _mm256_castsi256_ps(su));
+    v = _mm256_xor_ps(v, _mm256_castsi256_ps(sv));
+    return _mm256_add_ps(u, v);
+}
+
+__attribute__((target("avx2")))
+inline __m256 perlin_avx2(const int* perm, __m256 x, __m256 y, __m256 z) {
+    const __m256i m255 = _mm256_set1_epi32(255);
+    const __m256i one_i = _mm256_set1_epi32(1);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    __m256 fx = _mm256_floor_ps(x), fy = _mm256_floor_ps(y), fz = _mm256_floor_ps(z);
+    __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(fx), m255);
+    __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(fy), m255);
+    __m256i Z = _mm256_and_si256(_mm256_cvttps_epi32(fz), m255);
+    x = _mm256_sub_ps(x, fx);
+    y = _mm256_sub_ps(y, fy);
+    z = _mm256_sub_ps(z, fz);
+
+    __m256 u = fade_avx2(x), v = fade_avx2(y), w = fade_avx2(z);
+
+    __m256i A  = _mm256_add_epi32(gather_avx2(perm, X), Y);
+    __m256i AA = _mm256_add_epi32(gather_avx2(perm, A), Z);
+    __m256i AB = _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(A, one_i)), Z);
+    __m256i B  = _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(X, one_i)), Y);
+    __m256i BA = _mm256_add_epi32(gather_avx2(perm, B), Z);
+    __m256i BB = _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(B, one_i)), Z);
+
+    __m256 x1 = _mm256_sub_ps(x, one), y1 = _mm256_sub_ps(y, one), z1 = _mm256_sub_ps(z, one);
+
+    __m256 r0 = lerp_avx2(
+        lerp_avx2(grad_avx2(gather_avx2(perm, AA), x, y, z),
+                  grad_avx2(gather_avx2(perm, BA), x1, y, z), u),
+        lerp_avx2(grad_avx2(gather_avx2(perm, AB), x, y1, z),
+                  grad_avx2(gather_avx2(perm, BB), x1, y1, z), u),
+        v);
+    __m256 r1 = lerp_avx2(
+        lerp_avx2(grad_avx2(gather_avx2(perm, _mm256_add_epi32(AA, one_i)), x, y, z1),
+                  grad_avx2(gather_avx2(perm, _mm256_add_epi32(BA, one_i)), x1, y, z1), u),
+        lerp_avx2(grad_avx2(gather_avx2(perm, _mm256_add_epi32(AB, one_i)), x, y1, z1),
+                  grad_avx2(gather_avx2(perm, _mm256_add_epi32(BB, one_i)), x1, y1, z1), u),
+        v);
+    return lerp_avx2(r0, r1, w);
+}
+
+__attribute__((target("avx2")))
+void perlin_kernel_avx2(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                        float* out, size_t n) {
+    const int* perm = table.perm;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 r = perlin_avx2(perm, _mm256_loadu_ps(xs + i), _mm256_loadu_ps(ys + i), _mm256_loadu_ps(zs + i));
+        _mm256_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        alignas(32) float tx[8] = {}, ty[8] = {}, tz[8] = {}, tr[8];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        _mm256_store_ps(tr, perlin_avx2(perm, _mm256_load_ps(tx), _mm256_load_ps(ty), _mm256_load_ps(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- Hashed 방식 (AVX2) ----------------
+// 테이블 조회 대신 latticeHash(util.hpp)를 8개씩 계산한다.
+// 곱셈(_mm256_mullo_epi32)과 shift/xor만 쓰므로 gather가 필요 없다.
+
+__attribute__((target("avx2")))
+inline __m256i hash32_avx2(__m256i x) {
+    x = _mm256_xor_si256(_mm256_xor_si256(x, _mm256_set1_epi32(61)), _mm256_srli_epi32(x, 16));
+    x = _mm256_add_epi32(x, _mm256_slli_epi32(x, 3));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 4));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x27d4eb2d));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    return x;
+}
+
+__attribute__((target("avx2")))
+inline __m256 perlin_hashed_avx2(__m256i seed, __m256 x, __m256 y, __m256 z) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    __m256 fx = _mm256_floor_ps(x), fy = _mm256_floor_ps(y), fz = _mm256_floor_ps(z);
+    __m256i hx0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m256i hy0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fy), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m256i hz0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fz), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    __m256i hx1 = _mm256_add_epi32(hx0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m256i hy1 = _mm256_add_epi32(hy0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m256i hz1 = _mm256_add_epi32(hz0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    x = _mm256_sub_ps(x, fx);
+    y = _mm256_sub_ps(y, fy);
+    z = _mm256_sub_ps(z, fz);
+
+    __m256 u = fade_avx2(x), v = fade_avx2(y), w = fade_avx2(z);
+
+    // seed ^ hx ^ hy 를 먼저 만들어 두고 z만 바꿔 가며 해시
+    __m256i s0 = _mm256_xor_si256(seed, hx0), s1 = _mm256_xor_si256(seed, hx1);
+    __m256i A = _mm256_xor_si256(s0, hy0), B = _mm256_xor_si256(s1, hy0);
+    __m256i C = _mm256_xor_si256(s0, hy1), D = _mm256_xor_si256(s1, hy1);
+
+    __m256 x1 = _mm256_sub_ps(x, one), y1 = _mm256_sub_ps(y, one), z1 = _mm256_sub_ps(z, one);
+
+    __m256 r0 = lerp_avx2(
+        lerp_avx2(grad_avx2(hash32_avx2(_mm256_xor_si256(A, hz0)), x, y, z),
+                 grad_avx2(hash32_avx2(_mm256_xor_si256(B, hz0)), x1, y, z), u),
+        lerp_avx2(grad_avx2(hash32_avx2(_mm256_xor_si256(C, hz0)), x, y1, z),
+                 grad_avx2(hash32_avx2(_mm256_xor_si256(D, hz0)), x1, y1, z), u),
+        v);
+    __m256 r1 = lerp_avx2(
+        lerp_avx2(grad_avx2(hash32_avx2(_mm256_xor_si256(A, hz1)), x, y, z1),
+                 grad_avx2(hash32_avx2(_mm256_xor_si256(B, hz1)), x1, y, z1), u),
+        lerp_avx2(grad_avx2(hash32_avx2(_mm256_xor_si256(C, hz1)), x, y1, z1),
+                 grad_avx2(hash32_avx2(_mm256_xor_si256(D, hz1)), x1, y1, z1), u),
+        v);
+    return lerp_avx2(r0, r1, w);
+}
+
+__attribute__((target("avx2")))
+void perlin_hashed_kernel_avx2(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                                float* out, size_t n) {
+    const __m256i seed = _mm256_set1_epi32(static_cast<int>(table.hashSeed));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 r = perlin_hashed_avx2(seed, _mm256_loadu_ps(xs + i), _mm256_loadu_ps(ys + i), _mm256_loadu_ps(zs + i));
+        _mm256_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        alignas(32) float tx[8] = {}, ty[8] = {}, tz[8] = {}, tr[8];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        _mm256_store_ps(tr, perlin_hashed_avx2(seed, _mm256_load_ps(tx), _mm256_load_ps(ty), _mm256_load_ps(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- 값 + 기울기 (AVX2) ----------------
+
+__attribute__((target("avx2")))
+inline __m256 fade_deriv_avx2(__m256 t) {
+    __m256 k = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(t, _mm256_set1_ps(2.0f))), _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(30.0f), t), t), k);
+}
+
+__attribute__((target("avx2")))
+inline void grad_d_avx2(__m256i hash, __m256 x, __m256 y, __m256 z, __m256 g[4]) {
+    const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+    g[0] = grad_avx2(hash, x, y, z);
+    g[1] = grad_avx2(hash, one, zero, zero);
+    g[2] = grad_avx2(hash, zero, one, zero);
+    g[3] = grad_avx2(hash, zero, zero, one);
+}
+
+__attribute__((target("avx2")))
+inline void lerp_d_avx2(const __m256 a[4], const __m256 b[4], __m256 t, __m256 dt, int axis, __m256 out[4]) {
+    __m256 diff = _mm256_sub_ps(b[0], a[0]);
+    for (int k = 0; k < 4; ++k) out[k] = lerp_avx2(a[k], b[k], t);
+    out[axis] = _mm256_add_ps(out[axis], _mm256_mul_ps(dt, diff));
+}
+
+__attribute__((target("avx2")))
+inline void perlin_d_avx2(const __m256i h[8], __m256 x, __m256 y, __m256 z, __m256 out[4]) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 u = fade_avx2(x), du = fade_deriv_avx2(x);
+    __m256 v = fade_avx2(y), dv = fade_deriv_avx2(y);
+    __m256 w = fade_avx2(z), dw = fade_deriv_avx2(z);
+    __m256 x1 = _mm256_sub_ps(x, one), y1 = _mm256_sub_ps(y, one), z1 = _mm256_sub_ps(z, one);
+
+    __m256 a[4], b[4], x00[4], x10[4], x01[4], x11[4], y0[4], y1v[4];
+    grad_d_avx2(h[0], x, y, z, a);   grad_d_avx2(h[1], x1, y, z, b);   lerp_d_avx2(a, b, u, du, 1, x00);
+    grad_d_avx2(h[2], x, y1, z, a);  grad_d_avx2(h[3], x1, y1, z, b);  lerp_d_avx2(a, b, u, du, 1, x10);
+    grad_d_avx2(h[4], x, y, z1, a);  grad_d_avx2(h[5], x1, y, z1, b);  lerp_d_avx2(a, b, u, du, 1, x01);
+    grad_d_avx2(h[6], x, y1, z1, a); grad_d_avx2(h[7], x1, y1, z1, b); lerp_d_avx2(a, b, u, du, 1, x11);
+    lerp_d_avx2(x00, x10, v, dv, 2, y0);
+    lerp_d_avx2(x01, x11, v, dv, 2, y1v);
+    lerp_d_avx2(y0, y1v, w, dw, 3, out);
+}
+
+__attribute__((target("avx2")))
+inline void perlin_d_point_avx2(const NoiseTable& table, __m256 x, __m256 y, __m256 z, __m256 out[4]) {
+    const __m256i one_i = _mm256_set1_epi32(1);
+    __m256 fx = _mm256_floor_ps(x), fy = _mm256_floor_ps(y), fz = _mm256_floor_ps(z);
+    __m256i h[8];
+    if (table.backend == NoiseBackend::Hashed) {
+        const __m256i seed = _mm256_set1_epi32(static_cast<int>(table.hashSeed));
+        __m256i hx0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m256i hy0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fy), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m256i hz0 = _mm256_mullo_epi32(_mm256_cvttps_epi32(fz), _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m256i hx1 = _mm256_add_epi32(hx0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m256i hy1 = _mm256_add_epi32(hy0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m256i hz1 = _mm256_add_epi32(hz0, _mm256_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m256i s0 = _mm256_xor_si256(seed, hx0), s1 = _mm256_xor_si256(seed, hx1);
+        __m256i c[4] = { _mm256_xor_si256(s0, hy0), _mm256_xor_si256(s1, hy0),
+                         _mm256_xor_si256(s0, hy1), _mm256_xor_si256(s1, hy1) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = hash32_avx2(_mm256_xor_si256(c[k], hz0));
+            h[k + 4] = hash32_avx2(_mm256_xor_si256(c[k], hz1));
+        }
+    } else {
+        const int* perm = table.perm;
+        const __m256i m255 = _mm256_set1_epi32(255);
+        __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(fx), m255);
+        __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(fy), m255);
+        __m256i Z = _mm256_and_si256(_mm256_cvttps_epi32(fz), m255);
+        __m256i A  = _mm256_add_epi32(gather_avx2(perm, X), Y);
+        __m256i B  = _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(X, one_i)), Y);
+        __m256i c[4] = { _mm256_add_epi32(gather_avx2(perm, A), Z), _mm256_add_epi32(gather_avx2(perm, B), Z),
+                         _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(A, one_i)), Z),
+                         _mm256_add_epi32(gather_avx2(perm, _mm256_add_epi32(B, one_i)), Z) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = gather_avx2(perm, c[k]);
+            h[k + 4] = gather_avx2(perm, _mm256_add_epi32(c[k], one_i));
+        }
+    }
+    perlin_d_avx2(h, _mm256_sub_ps(x, fx), _mm256_sub_ps(y, fy), _mm256_sub_ps(z, fz), out);
+}
+
+__attribute__((target("avx2")))
+void perlin_d_kernel_avx2(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                          float* const out[4], size_t n) {
+    __m256 r[4];
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        perlin_d_point_avx2(table, _mm256_loadu_ps(xs + i), _mm256_loadu_ps(ys + i), _mm256_loadu_ps(zs + i), r);
+        for (int k = 0; k < 4; ++k) _mm256_storeu_ps(out[k] + i, r[k]);
+    }
+    if (i < n) {
+        alignas(32) float tx[8] = {}, ty[8] = {}, tz[8] = {}, tr[8];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        perlin_d_point_avx2(table, _mm256_load_ps(tx), _mm256_load_ps(ty), _mm256_load_ps(tz), r);
+        for (int c = 0; c < 4; ++c) {
+            _mm256_store_ps(tr, r[c]);
+            for (size_t k = 0; i + k < n; ++k) out[c][i + k] = tr[k];
+        }
+    }
+}
+
+// =============================================================
+// AVX-512 커널 (16개씩)
+// =============================================================
+// 비교 결과가 마스크 레지스터(__mmask16)로 나오므로 blend도 마스크로 한다.
+
+__attribute__((target("avx512f")))
+inline __m512 fade_avx512(__m512 t) {
+    __m512 t3 = _mm512_mul_ps(_mm512_mul_ps(t, t), t);
+    __m512 k = _mm512_sub_ps(_mm512_mul_ps(t, _mm512_set1_ps(6.0f)), _mm512_set1_ps(15.0f));
+    k = _mm512_add_ps(_mm512_mul_ps(t, k), _mm512_set1_ps(10.0f));
+    return _mm512_mul_ps(t3, k);
+}
+
+__attribute__((target("avx512f")))
+inline __m512 lerp_avx512(__m512 a, __m512 b, __m512 t) {
+    return _mm512_add_ps(a, _mm512_mul_ps(t, _mm512_sub_ps(b, a)));
+}
+
+__attribute__((target("avx512f")))
+inline __m512i gather_avx512(const int* perm, __m512i idx) {
+    return _mm512_i32gather_epi32(idx, perm, 4);
+}
+
+__attribute__((target("avx512f")))
+inline __m512 grad_avx512(__m512i hash, __m512 x, __m512 y, __m512 z) {
+    __m512i h = _mm512_and_si512(hash, _mm512_set1_epi32(15));
+    __mmask16 lt8 = _mm512_cmplt_epi32_mask(h, _mm512_set1_epi32(8));
+    __mmask16 lt4 = _mm512_cmplt_epi32_mask(h, _mm512_set1_epi32(4));
+    __mmask16 useX = _mm512_cmpeq_epi32_mask(h, _mm512_set1_epi32(12))
+                   | _mm512_cmpeq_epi32_mask(h, _mm512_set1_epi32(14));
+    __m512 u = _mm512_mask_blend_ps(lt8, y, x);
+    __m512 v = _mm512_mask_blend_ps(lt4, _mm512_mask_blend_ps(useX, z, x), y);
+    __m512i su = _mm512_slli_epi32(_mm512_and_si512(h, _mm512_set1_epi32(1)), 31);
+    __m512i sv = _mm512_slli_epi32(_mm512_and_si512(h, _mm512_set1_epi32(2)), 30);
+    u = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(u), su));
+    v = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(v), sv));
+    return _mm512_add_ps(u, v);
+}
+
+__attribute__((target("avx512f")))
+inline __m512 perlin_avx512(const int* perm, __m512 x, __m512 y, __m512 z) {
+    const __m512i m255 = _mm512_set1_epi32(255);
+    const __m512i one_i = _mm512_set1_epi32(1);
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const int toFloor = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+
+    __m512 fx = _mm512_roundscale_ps(x, toFloor);
+    __m512 fy = _mm512_roundscale_ps(y, toFloor);
+    __m512 fz = _mm512_roundscale_ps(z, toFloor);
+    __m512i X = _mm512_and_si512(_mm512_cvttps_epi32(fx), m255);
+    __m512i Y = _mm512_and_si512(_mm512_cvttps_epi32(fy), m255);
+    __m512i Z = _mm512_and_si512(_mm512_cvttps_epi32(fz), m255);
+    x = _mm512_sub_ps(x, fx);
+    y = _mm512_sub_ps(y, fy);
+    z = _mm512_sub_ps(z, fz);
+
+    __m512 u = fade_avx512(x), v = fade_avx512(y), w = fade_avx512(z);
+
+    __m512i A  = _mm512_add_epi32(gather_avx512(perm, X), Y);
+    __m512i AA = _mm512_add_epi32(gather_avx512(perm, A), Z);
+    __m512i AB = _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(A, one_i)), Z);
+    __m512i B  = _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(X, one_i)), Y);
+    __m512i BA = _mm512_add_epi32(gather_avx512(perm, B), Z);
+    __m512i BB = _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(B, one_i)), Z);
+
+    __m512 x1 = _mm512_sub_ps(x, one), y1 = _mm512_sub_ps(y, one), z1 = _mm512_sub_ps(z, one);
+
+    __m512 r0 = lerp_avx512(
+        lerp_avx512(grad_avx512(gather_avx512(perm, AA), x, y, z),
+                    grad_avx512(gather_avx512(perm, BA), x1, y, z), u),
+        lerp_avx512(grad_avx512(gather_avx512(perm, AB), x, y1, z),
+                    grad_avx512(gather_avx512(perm, BB), x1, y1, z), u),
+        v);
+    __m512 r1 = lerp_avx512(
+        lerp_avx512(grad_avx512(gather_avx512(perm, _mm512_add_epi32(AA, one_i)), x, y, z1),
+                    grad_avx512(gather_avx512(perm, _mm512_add_epi32(BA, one_i)), x1, y, z1), u),
+        lerp_avx512(grad_avx512(gather_avx512(perm, _mm512_add_epi32(AB, one_i)), x, y1, z1),
+                    grad_avx512(gather_avx512(perm, _mm512_add_epi32(BB, one_i)), x1, y1, z1), u),
+        v);
+    return lerp_avx512(r0, r1, w);
+}
+
+__attribute__((target("avx512f")))
+void perlin_kernel_avx512(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                          float* out, size_t n) {
+    const int* perm = table.perm;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 r = perlin_avx512(perm, _mm512_loadu_ps(xs + i), _mm512_loadu_ps(ys + i), _mm512_loadu_ps(zs + i));
+        _mm512_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        // AVX-512는 마스크 load/store로 남은 점들을 바로 처리할 수 있다.
+        __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        __m512 zero = _mm512_setzero_ps();
+        __m512 r = perlin_avx512(perm,
+                                 _mm512_mask_loadu_ps(zero, m, xs + i),
+                                 _mm512_mask_loadu_ps(zero, m, ys + i),
+                                 _mm512_mask_loadu_ps(zero, m, zs + i));
+        _mm512_mask_storeu_ps(out + i, m, r);
+    }
+}
+
+// ---------------- Hashed 방식 (AVX-512) ----------------
+
+__attribute__((target("avx512f")))
+inline __m512i hash32_avx512(__m512i x) {
+    x = _mm512_xor_si512(_mm512_xor_si512(x, _mm512_set1_epi32(61)), _mm512_srli_epi32(x, 16));
+    x = _mm512_add_epi32(x, _mm512_slli_epi32(x, 3));
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 4));
+    x = _mm512_mullo_epi32(x, _mm512_set1_epi32(0x27d4eb2d));
+    x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 15));
+    return x;
+}
+
+__attribute__((target("avx512f")))
+inline __m512 perlin_hashed_avx512(__m512i seed, __m512 x, __m512 y, __m512 z) {
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const int toFloor = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+
+    __m512 fx = _mm512_roundscale_ps(x, toFloor);
+    __m512 fy = _mm512_roundscale_ps(y, toFloor);
+    __m512 fz = _mm512_roundscale_ps(z, toFloor);
+    __m512i hx0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fx), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m512i hy0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fy), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m512i hz0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fz), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    __m512i hx1 = _mm512_add_epi32(hx0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+    __m512i hy1 = _mm512_add_epi32(hy0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+    __m512i hz1 = _mm512_add_epi32(hz0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+    x = _mm512_sub_ps(x, fx);
+    y = _mm512_sub_ps(y, fy);
+    z = _mm512_sub_ps(z, fz);
+
+    __m512 u = fade_avx512(x), v = fade_avx512(y), w = fade_avx512(z);
+
+    __m512i s0 = _mm512_xor_si512(seed, hx0), s1 = _mm512_xor_si512(seed, hx1);
+    __m512i A = _mm512_xor_si512(s0, hy0), B = _mm512_xor_si512(s1, hy0);
+    __m512i C = _mm512_xor_si512(s0, hy1), D = _mm512_xor_si512(s1, hy1);
+
+    __m512 x1 = _mm512_sub_ps(x, one), y1 = _mm512_sub_ps(y, one), z1 = _mm512_sub_ps(z, one);
+
+    __m512 r0 = lerp_avx512(
+        lerp_avx512(grad_avx512(hash32_avx512(_mm512_xor_si512(A, hz0)), x, y, z),
+                    grad_avx512(hash32_avx512(_mm512_xor_si512(B, hz0)), x1, y, z), u),
+        lerp_avx512(grad_avx512(hash32_avx512(_mm512_xor_si512(C, hz0)), x, y1, z),
+                    grad_avx512(hash32_avx512(_mm512_xor_si512(D, hz0)), x1, y1, z), u),
+        v);
+    __m512 r1 = lerp_avx512(
+        lerp_avx512(grad_avx512(hash32_avx512(_mm512_xor_si512(A, hz1)), x, y, z1),
+                    grad_avx512(hash32_avx512(_mm512_xor_si512(B, hz1)), x1, y, z1), u),
+        lerp_avx512(grad_avx512(hash32_avx512(_mm512_xor_si512(C, hz1)), x, y1, z1),
+                    grad_avx512(hash32_avx512(_mm512_xor_si512(D, hz1)), x1, y1, z1), u),
+        v);
+    return lerp_avx512(r0, r1, w);
+}
+
+__attribute__((target("avx512f")))
+void perlin_hashed_kernel_avx512(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                                 float* out, size_t n) {
+    const __m512i seed = _mm512_set1_epi32(static_cast<int>(table.hashSeed));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 r = perlin_hashed_avx512(seed, _mm512_loadu_ps(xs + i), _mm512_loadu_ps(ys + i), _mm512_loadu_ps(zs + i));
+        _mm512_storeu_ps(out + i, r);
+    }
+    if (i < n) {
+        __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        __m512 zero = _mm512_setzero_ps();
+        __m512 r = perlin_hashed_avx512(seed,
+                                        _mm512_mask_loadu_ps(zero, m, xs + i),
+                                        _mm512_mask_loadu_ps(zero, m, ys + i),
+                                        _mm512_mask_loadu_ps(zero, m, zs + i));
+        _mm512_mask_storeu_ps(out + i, m, r);
+    }
+}
+
+// ---------------- 값 + 기울기 (AVX-512) ----------------
+
+__attribute__((target("avx512f")))
+inline __m512 fade_deriv_avx512(__m512 t) {
+    __m512 k = _mm512_add_ps(_mm512_mul_ps(t, _mm512_sub_ps(t, _mm512_set1_ps(2.0f))), _mm512_set1_ps(1.0f));
+    return _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(30.0f), t), t), k);
+}
+
+__attribute__((target("avx512f")))
+inline void grad_d_avx512(__m512i hash, __m512 x, __m512 y, __m512 z, __m512 g[4]) {
+    const __m512 one = _mm512_set1_ps(1.0f), zero = _mm512_setzero_ps();
+    g[0] = grad_avx512(hash, x, y, z);
+    g[1] = grad_avx512(hash, one, zero, zero);
+    g[2] = grad_avx512(hash, zero, one, zero);
+    g[3] = grad_avx512(hash, zero, zero, one);
+}
+
+__attribute__((target("avx512f")))
+inline void lerp_d_avx512(const __m512 a[4], const __m512 b[4], __m512 t, __m512 dt, int axis, __m512 out[4]) {
+    __m512 diff = _mm512_sub_ps(b[0], a[0]);
+    for (int k = 0; k < 4; ++k) out[k] = lerp_avx512(a[k], b[k], t);
+    out[axis] = _mm512_add_ps(out[axis], _mm512_mul_ps(dt, diff));
+}
+
+__attribute__((target("avx512f")))
+inline void perlin_d_avx512(const __m512i h[8], __m512 x, __m512 y, __m512 z, __m512 out[4]) {
+    const __m512 one = _mm512_set1_ps(1.0f);
+    __m512 u = fade_avx512(x), du = fade_deriv_avx512(x);
+    __m512 v = fade_avx512(y), dv = fade_deriv_avx512(y);
+    __m512 w = fade_avx512(z), dw = fade_deriv_avx512(z);
+    __m512 x1 = _mm512_sub_ps(x, one), y1 = _mm512_sub_ps(y, one), z1 = _mm512_sub_ps(z, one);
+
+    __m512 a[4], b[4], x00[4], x10[4], x01[4], x11[4], y0[4], y1v[4];
+    grad_d_avx512(h[0], x, y, z, a);   grad_d_avx512(h[1], x1, y, z, b);   lerp_d_avx512(a, b, u, du, 1, x00);
+    grad_d_avx512(h[2], x, y1, z, a);  grad_d_avx512(h[3], x1, y1, z, b);  lerp_d_avx512(a, b, u, du, 1, x10);
+    grad_d_avx512(h[4], x, y, z1, a);  grad_d_avx512(h[5], x1, y, z1, b);  lerp_d_avx512(a, b, u, du, 1, x01);
+    grad_d_avx512(h[6], x, y1, z1, a); grad_d_avx512(h[7], x1, y1, z1, b); lerp_d_avx512(a, b, u, du, 1, x11);
+    lerp_d_avx512(x00, x10, v, dv, 2, y0);
+    lerp_d_avx512(x01, x11, v, dv, 2, y1v);
+    lerp_d_avx512(y0, y1v, w, dw, 3, out);
+}
+
+__attribute__((target("avx512f")))
+inline void perlin_d_point_avx512(const NoiseTable& table, __m512 x, __m512 y, __m512 z, __m512 out[4]) {
+    const __m512i one_i = _mm512_set1_epi32(1);
+    const int toFloor = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+    __m512 fx = _mm512_roundscale_ps(x, toFloor);
+    __m512 fy = _mm512_roundscale_ps(y, toFloor);
+    __m512 fz = _mm512_roundscale_ps(z, toFloor);
+    __m512i h[8];
+    if (table.backend == NoiseBackend::Hashed) {
+        const __m512i seed = _mm512_set1_epi32(static_cast<int>(table.hashSeed));
+        __m512i hx0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fx), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m512i hy0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fy), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m512i hz0 = _mm512_mullo_epi32(_mm512_cvttps_epi32(fz), _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m512i hx1 = _mm512_add_epi32(hx0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_X)));
+        __m512i hy1 = _mm512_add_epi32(hy0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Y)));
+        __m512i hz1 = _mm512_add_epi32(hz0, _mm512_set1_epi32(static_cast<int>(LATTICE_PRIME_Z)));
+        __m512i s0 = _mm512_xor_si512(seed, hx0), s1 = _mm512_xor_si512(seed, hx1);
+        __m512i c[4] = { _mm512_xor_si512(s0, hy0), _mm512_xor_si512(s1, hy0),
+                         _mm512_xor_si512(s0, hy1), _mm512_xor_si512(s1, hy1) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = hash32_avx512(_mm512_xor_si512(c[k], hz0));
+            h[k + 4] = hash32_avx512(_mm512_xor_si512(c[k], hz1));
+        }
+    } else {
+        const int* perm = table.perm;
+        const __m512i m255 = _mm512_set1_epi32(255);
+        __m512i X = _mm512_and_si512(_mm512_cvttps_epi32(fx), m255);
+        __m512i Y = _mm512_and_si512(_mm512_cvttps_epi32(fy), m255);
+        __m512i Z = _mm512_and_si512(_mm512_cvttps_epi32(fz), m255);
+        __m512i A  = _mm512_add_epi32(gather_avx512(perm, X), Y);
+        __m512i B  = _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(X, one_i)), Y);
+        __m512i c[4] = { _mm512_add_epi32(gather_avx512(perm, A), Z), _mm512_add_epi32(gather_avx512(perm, B), Z),
+                         _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(A, one_i)), Z),
+                         _mm512_add_epi32(gather_avx512(perm, _mm512_add_epi32(B, one_i)), Z) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = gather_avx512(perm, c[k]);
+            h[k + 4] = gather_avx512(perm, _mm512_add_epi32(c[k], one_i));
+        }
+    }
+    perlin_d_avx512(h, _mm512_sub_ps(x, fx), _mm512_sub_ps(y, fy), _mm512_sub_ps(z, fz), out);
+}
+
+__attribute__((target("avx512f")))
+void perlin_d_kernel_avx512(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                            float* const out[4], size_t n) {
+    __m512 r[4];
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        perlin_d_point_avx512(table, _mm512_loadu_ps(xs + i), _mm512_loadu_ps(ys + i), _mm512_loadu_ps(zs + i), r);
+        for (int k = 0; k < 4; ++k) _mm512_storeu_ps(out[k] + i, r[k]);
+    }
+    if (i < n) {
+        __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        __m512 zero = _mm512_setzero_ps();
+        perlin_d_point_avx512(table,
+                              _mm512_mask_loadu_ps(zero, m, xs + i),
+                              _mm512_mask_loadu_ps(zero, m, ys + i),
+                              _mm512_mask_loadu_ps(zero, m, zs + i), r);
+        for (int k = 0; k < 4; ++k) _mm512_mask_storeu_ps(out[k] + i, m, r[k]);
+    }
+}
+
+#endif // NOISE_SIMD_X86
+
+#ifdef NOISE_SIMD_WASM
+
+// =============================================================
+// WASM SIMD128 커널 (4개씩)
+// =============================================================
+// 브라우저용 planet_simd.wasm 에서만 쓰인다.
+// WASM SIMD에는 gather가 없으므로 SSE4.1 커널처럼 한 칸씩 읽어서 모은다.
+// FMA 명령어도 없어서 스칼라 perlin()과 결과가 그대로 같다.
+
+inline v128_t fade_wasm(v128_t t) {
+    v128_t t3 = wasm_f32x4_mul(wasm_f32x4_mul(t, t), t);
+    v128_t k = wasm_f32x4_sub(wasm_f32x4_mul(t, wasm_f32x4_splat(6.0f)), wasm_f32x4_splat(15.0f));
+    k = wasm_f32x4_add(wasm_f32x4_mul(t, k), wasm_f32x4_splat(10.0f));
+    return wasm_f32x4_mul(t3, k);
+}
+
+inline v128_t lerp_wasm(v128_t a, v128_t b, v128_t t) {
+    return wasm_f32x4_add(a, wasm_f32x4_mul(t, wasm_f32x4_sub(b, a)));
+}
+
+inline v128_t gather_wasm(const int* perm, v128_t idx) {
+    return wasm_i32x4_make(perm[wasm_i32x4_extract_lane(idx, 0)],
+                           perm[wasm_i32x4_extract_lane(idx, 1)],
+                           perm[wasm_i32x4_extract_lane(idx, 2)],
+                           perm[wasm_i32x4_extract_lane(idx, 3)]);
+}
+
+inline v128_t grad_wasm(v128_t hash, v128_t x, v128_t y, v128_t z) {
+    v128_t h = wasm_v128_and(hash, wasm_i32x4_splat(15));
+    v128_t lt8 = wasm_i32x4_lt(h, wasm_i32x4_splat(8));
+    v128_t lt4 = wasm_i32x4_lt(h, wasm_i32x4_splat(4));
+    v128_t useX = wasm_v128_or(wasm_i32x4_eq(h, wasm_i32x4_splat(12)),
+                               wasm_i32x4_eq(h, wasm_i32x4_splat(14)));
+    // bitselect(a, b, mask) = mask ? a : b
+    v128_t u = wasm_v128_bitselect(x, y, lt8);
+    v128_t v = wasm_v128_bitselect(y, wasm_v128_bitselect(x, z, useX), lt4);
+    v128_t su = wasm_i32x4_shl(wasm_v128_and(h, wasm_i32x4_splat(1)), 31);
+    v128_t sv = wasm_i32x4_shl(wasm_v128_and(h, wasm_i32x4_splat(2)), 30);
+    return wasm_f32x4_add(wasm_v128_xor(u, su), wasm_v128_xor(v, sv));
+}
+
+inline v128_t perlin_wasm(const int* perm, v128_t x, v128_t y, v128_t z) {
+    const v128_t m255 = wasm_i32x4_splat(255);
+    const v128_t one_i = wasm_i32x4_splat(1);
+    const v128_t one = wasm_f32x4_splat(1.0f);
+
+    v128_t fx = wasm_f32x4_floor(x), fy = wasm_f32x4_floor(y), fz = wasm_f32x4_floor(z);
+    v128_t X = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fx), m255);
+    v128_t Y = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fy), m255);
+    v128_t Z = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fz), m255);
+    x = wasm_f32x4_sub(x, fx);
+    y = wasm_f32x4_sub(y, fy);
+    z = wasm_f32x4_sub(z, fz);
+
+    v128_t u = fade_wasm(x), v = fade_wasm(y), w = fade_wasm(z);
+
+    v128_t A  = wasm_i32x4_add(gather_wasm(perm, X), Y);
+    v128_t AA = wasm_i32x4_add(gather_wasm(perm, A), Z);
+    v128_t AB = wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(A, one_i)), Z);
+    v128_t B  = wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(X, one_i)), Y);
+    v128_t BA = wasm_i32x4_add(gather_wasm(perm, B), Z);
+    v128_t BB = wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(B, one_i)), Z);
+
+    v128_t x1 = wasm_f32x4_sub(x, one), y1 = wasm_f32x4_sub(y, one), z1 = wasm_f32x4_sub(z, one);
+
+    v128_t r0 = lerp_wasm(
+        lerp_wasm(grad_wasm(gather_wasm(perm, AA), x, y, z),
+                  grad_wasm(gather_wasm(perm, BA), x1, y, z), u),
+        lerp_wasm(grad_wasm(gather_wasm(perm, AB), x, y1, z),
+                  grad_wasm(gather_wasm(perm, BB), x1, y1, z), u),
+        v);
+    v128_t r1 = lerp_wasm(
+        lerp_wasm(grad_wasm(gather_wasm(perm, wasm_i32x4_add(AA, one_i)), x, y, z1),
+                  grad_wasm(gather_wasm(perm, wasm_i32x4_add(BA, one_i)), x1, y, z1), u),
+        lerp_wasm(grad_wasm(gather_wasm(perm, wasm_i32x4_add(AB, one_i)), x, y1, z1),
+                  grad_wasm(gather_wasm(perm, wasm_i32x4_add(BB, one_i)), x1, y1, z1), u),
+        v);
+    return lerp_wasm(r0, r1, w);
+}
+
+void perlin_kernel_wasm(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                        float* out, size_t n) {
+    const int* perm = table.perm;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t r = perlin_wasm(perm, wasm_v128_load(xs + i), wasm_v128_load(ys + i), wasm_v128_load(zs + i));
+        wasm_v128_store(out + i, r);
+    }
+    if (i < n) {
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        wasm_v128_store(tr, perlin_wasm(perm, wasm_v128_load(tx), wasm_v128_load(ty), wasm_v128_load(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- Hashed 방식 (SIMD128) ----------------
+// 테이블 조회가 없어서 lane을 하나씩 꺼낼 필요가 없다.
+// (Table 방식 커널보다 WASM에서 이득이 특히 크다)
+
+inline v128_t hash32_wasm(v128_t x) {
+    x = wasm_v128_xor(wasm_v128_xor(x, wasm_i32x4_splat(61)), wasm_u32x4_shr(x, 16));
+    x = wasm_i32x4_add(x, wasm_i32x4_shl(x, 3));
+    x = wasm_v128_xor(x, wasm_u32x4_shr(x, 4));
+    x = wasm_i32x4_mul(x, wasm_i32x4_splat(0x27d4eb2d));
+    x = wasm_v128_xor(x, wasm_u32x4_shr(x, 15));
+    return x;
+}
+
+inline v128_t perlin_hashed_wasm(v128_t seed, v128_t x, v128_t y, v128_t z) {
+    const v128_t one = wasm_f32x4_splat(1.0f);
+    const v128_t px = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_X));
+    const v128_t py = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_Y));
+    const v128_t pz = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_Z));
+
+    v128_t fx = wasm_f32x4_floor(x), fy = wasm_f32x4_floor(y), fz = wasm_f32x4_floor(z);
+    v128_t hx0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fx), px);
+    v128_t hy0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fy), py);
+    v128_t hz0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fz), pz);
+    v128_t hx1 = wasm_i32x4_add(hx0, px);
+    v128_t hy1 = wasm_i32x4_add(hy0, py);
+    v128_t hz1 = wasm_i32x4_add(hz0, pz);
+    x = wasm_f32x4_sub(x, fx);
+    y = wasm_f32x4_sub(y, fy);
+    z = wasm_f32x4_sub(z, fz);
+
+    v128_t u = fade_wasm(x), v = fade_wasm(y), w = fade_wasm(z);
+
+    v128_t s0 = wasm_v128_xor(seed, hx0), s1 = wasm_v128_xor(seed, hx1);
+    v128_t A = wasm_v128_xor(s0, hy0), B = wasm_v128_xor(s1, hy0);
+    v128_t C = wasm_v128_xor(s0, hy1), D = wasm_v128_xor(s1, hy1);
+
+    v128_t x1 = wasm_f32x4_sub(x, one), y1 = wasm_f32x4_sub(y, one), z1 = wasm_f32x4_sub(z, one);
+
+    v128_t r0 = lerp_wasm(
+        lerp_wasm(grad_wasm(hash32_wasm(wasm_v128_xor(A, hz0)), x, y, z),
+                  grad_wasm(hash32_wasm(wasm_v128_xor(B, hz0)), x1, y, z), u),
+        lerp_wasm(grad_wasm(hash32_wasm(wasm_v128_xor(C, hz0)), x, y1, z),
+                  grad_wasm(hash32_wasm(wasm_v128_xor(D, hz0)), x1, y1, z), u),
+        v);
+    v128_t r1 = lerp_wasm(
+        lerp_wasm(grad_wasm(hash32_wasm(wasm_v128_xor(A, hz1)), x, y, z1),
+                  grad_wasm(hash32_wasm(wasm_v128_xor(B, hz1)), x1, y, z1), u),
+        lerp_wasm(grad_wasm(hash32_wasm(wasm_v128_xor(C, hz1)), x, y1, z1),
+                  grad_wasm(hash32_wasm(wasm_v128_xor(D, hz1)), x1, y1, z1), u),
+        v);
+    return lerp_wasm(r0, r1, w);
+}
+
+void perlin_hashed_kernel_wasm(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                               float* out, size_t n) {
+    const v128_t seed = wasm_i32x4_splat(static_cast<int>(table.hashSeed));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t r = perlin_hashed_wasm(seed, wasm_v128_load(xs + i), wasm_v128_load(ys + i), wasm_v128_load(zs + i));
+        wasm_v128_store(out + i, r);
+    }
+    if (i < n) {
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        wasm_v128_store(tr, perlin_hashed_wasm(seed, wasm_v128_load(tx), wasm_v128_load(ty), wasm_v128_load(tz)));
+        for (size_t k = 0; i + k < n; ++k) out[i + k] = tr[k];
+    }
+}
+
+// ---------------- 값 + 기울기 (SIMD128) ----------------
+
+inline v128_t fade_deriv_wasm(v128_t t) {
+    v128_t k = wasm_f32x4_add(wasm_f32x4_mul(t, wasm_f32x4_sub(t, wasm_f32x4_splat(2.0f))), wasm_f32x4_splat(1.0f));
+    return wasm_f32x4_mul(wasm_f32x4_mul(wasm_f32x4_mul(wasm_f32x4_splat(30.0f), t), t), k);
+}
+
+inline void grad_d_wasm(v128_t hash, v128_t x, v128_t y, v128_t z, v128_t g[4]) {
+    const v128_t one = wasm_f32x4_splat(1.0f), zero = wasm_f32x4_splat(0.0f);
+    g[0] = grad_wasm(hash, x, y, z);
+    g[1] = grad_wasm(hash, one, zero, zero);
+    g[2] = grad_wasm(hash, zero, one, zero);
+    g[3] = grad_wasm(hash, zero, zero, one);
+}
+
+inline void lerp_d_wasm(const v128_t a[4], const v128_t b[4], v128_t t, v128_t dt, int axis, v128_t out[4]) {
+    v128_t diff = wasm_f32x4_sub(b[0], a[0]);
+    for (int k = 0; k < 4; ++k) out[k] = lerp_wasm(a[k], b[k], t);
+    out[axis] = wasm_f32x4_add(out[axis], wasm_f32x4_mul(dt, diff));
+}
+
+inline void perlin_d_wasm(const v128_t h[8], v128_t x, v128_t y, v128_t z, v128_t out[4]) {
+    const v128_t one = wasm_f32x4_splat(1.0f);
+    v128_t u = fade_wasm(x), du = fade_deriv_wasm(x);
+    v128_t v = fade_wasm(y), dv = fade_deriv_wasm(y);
+    v128_t w = fade_wasm(z), dw = fade_deriv_wasm(z);
+    v128_t x1 = wasm_f32x4_sub(x, one), y1 = wasm_f32x4_sub(y, one), z1 = wasm_f32x4_sub(z, one);
+
+    v128_t a[4], b[4], x00[4], x10[4], x01[4], x11[4], y0[4], y1v[4];
+    grad_d_wasm(h[0], x, y, z, a);   grad_d_wasm(h[1], x1, y, z, b);   lerp_d_wasm(a, b, u, du, 1, x00);
+    grad_d_wasm(h[2], x, y1, z, a);  grad_d_wasm(h[3], x1, y1, z, b);  lerp_d_wasm(a, b, u, du, 1, x10);
+    grad_d_wasm(h[4], x, y, z1, a);  grad_d_wasm(h[5], x1, y, z1, b);  lerp_d_wasm(a, b, u, du, 1, x01);
+    grad_d_wasm(h[6], x, y1, z1, a); grad_d_wasm(h[7], x1, y1, z1, b); lerp_d_wasm(a, b, u, du, 1, x11);
+    lerp_d_wasm(x00, x10, v, dv, 2, y0);
+    lerp_d_wasm(x01, x11, v, dv, 2, y1v);
+    lerp_d_wasm(y0, y1v, w, dw, 3, out);
+}
+
+inline void perlin_d_point_wasm(const NoiseTable& table, v128_t x, v128_t y, v128_t z, v128_t out[4]) {
+    const v128_t one_i = wasm_i32x4_splat(1);
+    v128_t fx = wasm_f32x4_floor(x), fy = wasm_f32x4_floor(y), fz = wasm_f32x4_floor(z);
+    v128_t h[8];
+    if (table.backend == NoiseBackend::Hashed) {
+        const v128_t seed = wasm_i32x4_splat(static_cast<int>(table.hashSeed));
+        const v128_t px = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_X));
+        const v128_t py = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_Y));
+        const v128_t pz = wasm_i32x4_splat(static_cast<int>(LATTICE_PRIME_Z));
+        v128_t hx0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fx), px);
+        v128_t hy0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fy), py);
+        v128_t hz0 = wasm_i32x4_mul(wasm_i32x4_trunc_sat_f32x4(fz), pz);
+        v128_t hx1 = wasm_i32x4_add(hx0, px);
+        v128_t hy1 = wasm_i32x4_add(hy0, py);
+        v128_t hz1 = wasm_i32x4_add(hz0, pz);
+        v128_t s0 = wasm_v128_xor(seed, hx0), s1 = wasm_v128_xor(seed, hx1);
+        v128_t c[4] = { wasm_v128_xor(s0, hy0), wasm_v128_xor(s1, hy0),
+                        wasm_v128_xor(s0, hy1), wasm_v128_xor(s1, hy1) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = hash32_wasm(wasm_v128_xor(c[k], hz0));
+            h[k + 4] = hash32_wasm(wasm_v128_xor(c[k], hz1));
+        }
+    } else {
+        const int* perm = table.perm;
+        const v128_t m255 = wasm_i32x4_splat(255);
+        v128_t X = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fx), m255);
+        v128_t Y = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fy), m255);
+        v128_t Z = wasm_v128_and(wasm_i32x4_trunc_sat_f32x4(fz), m255);
+        v128_t A  = wasm_i32x4_add(gather_wasm(perm, X), Y);
+        v128_t B  = wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(X, one_i)), Y);
+        v128_t c[4] = { wasm_i32x4_add(gather_wasm(perm, A), Z), wasm_i32x4_add(gather_wasm(perm, B), Z),
+                        wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(A, one_i)), Z),
+                        wasm_i32x4_add(gather_wasm(perm, wasm_i32x4_add(B, one_i)), Z) };
+        for (int k = 0; k < 4; ++k) {
+            h[k] = gather_wasm(perm, c[k]);
+            h[k + 4] = gather_wasm(perm, wasm_i32x4_add(c[k], one_i));
+        }
+    }
+    perlin_d_wasm(h, wasm_f32x4_sub(x, fx), wasm_f32x4_sub(y, fy), wasm_f32x4_sub(z, fz), out);
+}
+
+void perlin_d_kernel_wasm(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                          float* const out[4], size_t n) {
+    v128_t r[4];
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        perlin_d_point_wasm(table, wasm_v128_load(xs + i), wasm_v128_load(ys + i), wasm_v128_load(zs + i), r);
+        for (int k = 0; k < 4; ++k) wasm_v128_store(out[k] + i, r[k]);
+    }
+    if (i < n) {
+        alignas(16) float tx[4] = {}, ty[4] = {}, tz[4] = {}, tr[4];
+        for (size_t k = 0; i + k < n; ++k) { tx[k] = xs[i + k]; ty[k] = ys[i + k]; tz[k] = zs[i + k]; }
+        perlin_d_point_wasm(table, wasm_v128_load(tx), wasm_v128_load(ty), wasm_v128_load(tz), r);
+        for (int c = 0; c < 4; ++c) {
+            wasm_v128_store(tr, r[c]);
+            for (size_t k = 0; i + k < n; ++k) out[c][i + k] = tr[k];
+        }
+    }
+}
+
+#endif // NOISE_SIMD_WASM
+
+// -------------------------------------------------------------
+// 커널 선택 (프로그램 실행 중 딱 한 번)
+// -------------------------------------------------------------
+// fn       : Table 방식 커널
+// hashedFn : Hashed 방식 커널 (같은 명령어 집합)
+// dFn      : 값 + 기울기 커널 (두 방식 모두)
+struct KernelChoice {
+    PerlinKernel fn;
+    PerlinKernel hashedFn;
+    PerlinDKernel dFn;
+    const char* name;
+};
+
+// 이 CPU에서 쓸 수 있는 커널을 빠른 순서로 모은 뒤
+// PLANET_SIMD가 그중 하나를 가리키면 그것을, 아니면 가장 빠른 것을 고른다.
+KernelChoice selectKernel() {
+    KernelChoice usable[5];
+    int count = 0;
+#ifdef NOISE_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) usable[count++] = { perlin_kernel_avx512, perlin_hashed_kernel_avx512, perlin_d_kernel_avx512, "avx512" };
+    if (__builtin_cpu_supports("avx2"))    usable[count++] = { perlin_kernel_avx2,   perlin_hashed_kernel_avx2,   perlin_d_kernel_avx2,   "avx2" };
+    if (__builtin_cpu_supports("sse4.1"))  usable[count++] = { perlin_kernel_sse41,  perlin_hashed_kernel_sse41,  perlin_d_kernel_sse41,  "sse4.1" };
+#endif
+#ifdef NOISE_SIMD_WASM
+    usable[count++] = { perlin_kernel_wasm, perlin_hashed_kernel_wasm, perlin_d_kernel_wasm, "simd128" };
+#endif
+    usable[count++] = { perlin_kernel_scalar, perlin_kernel_scalar, perlin_d_kernel_scalar, "scalar" };
+
+    if (const char* forced = std::getenv("PLANET_SIMD")) {
+        for (int i = 0; i < count; ++i) {
+            if (std::strcmp(forced, usable[i].name) == 0) return usable[i];
+        }
+    }
+    return usable[0];
+}
+
+const KernelChoice& activeKernel() {
+    static const KernelChoice choice = selectKernel();
+    return choice;
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// perlin_batch
+// -------------------------------------------------------------
+// n개의 점에 대해 perlin(xs[i], ys[i], zs[i])를 계산해 out[i]에 쓴다.
+// table.backend에 따라 Table / Hashed 커널 중 하나를 쓴다.
+// -------------------------------------------------------------
+void perlin_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                  float* out, size_t n) {
+    PLANET_PERF_ADD(NoiseSamples, n);
+    const KernelChoice& k = activeKernel();
+    if (table.backend == NoiseBackend::Hashed) k.hashedFn(table, xs, ys, zs, out, n);
+    else k.fn(table, xs, ys, zs, out, n);
+}
+
+void perlin_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n) {
+    perlin_batch(defaultNoiseTable(), xs, ys, zs, out, n);
+}
+
+const char* perlin_batch_kernel_name() {
+    return activeKernel().name;
+}
+
+// -------------------------------------------------------------
+// simplex_batch
+// -------------------------------------------------------------
+// simplex()의 배치 버전.
+// 아직 SIMD 커널이 없어서 점마다 simplex()를 부른다.
+// (fbm_batch / terrain_layers_batch가 Simplex 층을 같은 흐름으로 다루기 위한 자리)
+// -------------------------------------------------------------
+void simplex_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                   float* out, size_t n) {
+    PLANET_PERF_ADD(NoiseSamples, n);
+    for (size_t i = 0; i < n; ++i) out[i] = simplex(table, xs[i], ys[i], zs[i]);
+}
+
+namespace {
+
+// basis에 맞는 배치 함수로 보낸다.
+void basis_batch(const NoiseTable& table, NoiseBasis basis,
+                 const float* xs, const float* ys, const float* zs, float* out, size_t n) {
+    if (basis == NoiseBasis::Simplex) simplex_batch(table, xs, ys, zs, out, n);
+    else perlin_batch(table, xs, ys, zs, out, n);
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// fbm_batch
+// -------------------------------------------------------------
+// fbm()과 같은 계산을 “옥타브 단위”로 뒤집어서 수행한다.
+//   한 점씩: 점마다 옥타브 루프
+//   배치:   옥타브마다 kBatchChunk개 점을 perlin_batch로 한 번에
+// 주파수/강도 계산 순서는 fbm()과 같다.
+// -------------------------------------------------------------
+void fbm_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+               float* out, size_t n, int octaves, float lacunarity, float gain, NoiseBasis basis) {
+    float sx[kBatchChunk], sy[kBatchChunk], sz[kBatchChunk], nv[kBatchChunk];
+
+    for (size_t base = 0; base < n; base += kBatchChunk) {
+        size_t count = std::min(kBatchChunk, n - base);
+        float* sum = out + base; // 출력 버퍼를 누적용으로 바로 사용
+        for (size_t i = 0; i < count; ++i) sum[i] = 0.0f;
+
+        float amplitude = 1.0f;
+        float frequency = 1.0f;
+        float maxAmp = 0.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t i = 0; i < count; ++i) {
+                sx[i] = xs[base + i] * frequency;
+                sy[i] = ys[base + i] * frequency;
+                sz[i] = zs[base + i] * frequency;
+            }
+            basis_batch(table, basis, sx, sy, sz, nv, count);
+            for (size_t i = 0; i < count; ++i) {
+                float v = nv[i] * 0.5f + 0.5f; // -1~1 → 0~1
+                sum[i] += v * amplitude;
+            }
+            maxAmp += amplitude;
+
+            amplitude *= gain;
+            frequency *= lacunarity;
+        }
+
+        if (maxAmp == 0.0f) {
+            for (size_t i = 0; i < count; ++i) sum[i] = 0.0f;
+        } else {
+            for (size_t i = 0; i < count; ++i) sum[i] = sum[i] / maxAmp; // 정규화
+        }
+    }
+}
+
+// -------------------------------------------------------------
+// ridged_fbm_batch
+// -------------------------------------------------------------
+// ridged_fbm()의 배치 버전. 이전 옥타브의 영향(weight)은
+// 점마다 다르므로 점별 배열로 들고 다닌다.
+// -------------------------------------------------------------
+void ridged_fbm_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                      float* out, size_t n, int octaves, float lacunarity, float gain, NoiseBasis basis) {
+    float sx[kBatchChunk], sy[kBatchChunk], sz[kBatchChunk], nv[kBatchChunk];
+    float weight[kBatchChunk];
+
+    for (size_t base = 0; base < n; base += kBatchChunk) {
+        size_t count = std::min(kBatchChunk, n - base);
+        float* sum = out + base;
+        for (size_t i = 0; i < count; ++i) { sum[i] = 0.0f; weight[i] = 1.0f; }
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t i = 0; i < count; ++i) {
+                sx[i] = xs[base + i] * frequency;
+                sy[i] = ys[base + i] * frequency;
+                sz[i] = zs[base + i] * frequency;
+            }
+            basis_batch(table, basis, sx, sy, sz, nv, count);
+            for (size_t i = 0; i < count; ++i) {
+                float v = 1.0f - std::fabs(nv[i]);
+                v *= v;
+                v *= weight[i];
+                sum[i] += v * amplitude;
+                weight[i] = clampf(v * gain, 0.0f, 1.0f);
+            }
+
+            frequency *= lacunarity;
+            amplitude *= 0.5f;
+        }
+    }
+}
+
+// 예전 API: 기본(전역) 테이블 사용
+void fbm_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+               int octaves, float lacunarity, float gain) {
+    fbm_batch(defaultNoiseTable(), xs, ys, zs, out, n, octaves, lacunarity, gain);
+}
+
+void ridged_fbm_batch(const float* xs, const float* ys, const float* zs, float* out, size_t n,
+                      int octaves, float lacunarity, float gain) {
+    ridged_fbm_batch(defaultNoiseTable(), xs, ys, zs, out, n, octaves, lacunarity, gain);
+}
+
+// -------------------------------------------------------------
+// terrain_layers_batch
+// -------------------------------------------------------------
+// terrain_layers(noise.cpp)의 배치 버전.
+//
+// 옥타브마다 아직 남아 있는 층들의 좌표를 한 버퍼에 이어 붙여서
+//   [Perlin 층 점들 | Simplex 층 점들]
+// 종류마다 배치 함수를 한 번씩만 부른다. 층별로 세 번 부를 때보다
+// 커널 호출이 줄고, 벡터 폭을 채우지 못하는 자투리도 줄어든다.
+//
+// 주파수/강도/정규화 값은 세 층이 함께 쓰며,
+// 계산 순서가 fbm_batch / ridged_fbm_batch와 같아서 결과도 같다.
+// -------------------------------------------------------------
+void terrain_layers_batch(const NoiseTable& table, const NoiseParams& p,
+                          const float* xs, const float* ys, const float* zs,
+                          float* macro, float* micro, float* ridge, size_t n) {
+    float sx[3 * kBatchChunk], sy[3 * kBatchChunk], sz[3 * kBatchChunk], nv[3 * kBatchChunk];
+    float weight[kBatchChunk];
+
+    const int octaves = std::max(p.macroOctaves, std::max(p.microOctaves, p.ridgeOctaves));
+    PLANET_PERF_ADD(MacroOctaves, n * p.macroOctaves);
+    PLANET_PERF_ADD(MicroOctaves, n * p.microOctaves);
+    PLANET_PERF_ADD(RidgeOctaves, n * p.ridgeOctaves);
+
+    for (size_t base = 0; base < n; base += kBatchChunk) {
+        size_t count = std::min(kBatchChunk, n - base);
+        const float* x = xs + base;
+        const float* y = ys + base;
+        const float* z = zs + base;
+        float* macroSum = macro + base;
+        float* microSum = micro + base;
+        float* ridgeSum = ridge + base;
+        // 노이즈 계산은 층별 단계에, 좌표 준비 / 누적 / 정규화는 Layers에 더한다.
+        PLANET_PERF_CLOCK(clock);
+        for (size_t i = 0; i < count; ++i) {
+            macroSum[i] = 0.0f;
+            microSum[i] = 0.0f;
+            ridgeSum[i] = 0.0f;
+            weight[i] = 1.0f;
+        }
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float ridgeAmp = 1.0f;
+        float macroMax = 0.0f, microMax = 0.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            const bool doMacro = o < p.macroOctaves;
+            const bool doMicro = o < p.microOctaves;
+            const bool doRidge = o < p.ridgeOctaves;
+            size_t perlinCount = 0;
+
+            // 1) 이번 옥타브에 필요한 좌표를 한 버퍼에 모으기
+            //    Perlin 층을 앞에, Simplex 층을 뒤에 둔다.
+            size_t k = 0;
+            auto pack = [&](float freq) {
+                const size_t at = k;
+                for (size_t i = 0; i < count; ++i) {
+                    sx[k + i] = x[i] * freq * frequency;
+                    sy[k + i] = y[i] * freq * frequency;
+                    sz[k + i] = z[i] * freq * frequency;
+                }
+                k += count;
+                return at;
+            };
+            size_t macroAt = 0, microAt = 0, ridgeAt = 0;
+            for (NoiseBasis basis : { NoiseBasis::Perlin, NoiseBasis::Simplex }) {
+                if (doMacro && p.macroBasis == basis) macroAt = pack(p.macroFreq);
+                if (doMicro && p.microBasis == basis) microAt = pack(p.microFreq);
+                if (doRidge && p.ridgeBasis == basis) ridgeAt = pack(p.ridgeFreq);
+                if (basis == NoiseBasis::Perlin) perlinCount = k;
+            }
+
+            PLANET_PERF_LAP(clock, Layers);
+
+            // 2) 종류별로 한 번에 계산
+#if PLANET_PERF_COUNTERS
+            // 계수기 빌드에서는 층별 시간(PerfStage::Macro / Micro / Ridge)을 재려고
+            // 층마다 따로 부른다. (점마다 따로 계산하므로 값은 같다)
+            (void)perlinCount;
+            auto layerNoise = [&](size_t at, NoiseBasis basis) {
+                if (basis == NoiseBasis::Simplex) simplex_batch(table, sx + at, sy + at, sz + at, nv + at, count);
+                else perlin_batch(table, sx + at, sy + at, sz + at, nv + at, count);
+            };
+            if (doMacro) { layerNoise(macroAt, p.macroBasis); PLANET_PERF_LAP(clock, Macro); }
+            if (doMicro) { layerNoise(microAt, p.microBasis); PLANET_PERF_LAP(clock, Micro); }
+            if (doRidge) { layerNoise(ridgeAt, p.ridgeBasis); PLANET_PERF_LAP(clock, Ridge); }
+#else
+            if (perlinCount > 0) perlin_batch(table, sx, sy, sz, nv, perlinCount);
+            if (k > perlinCount) {
+                simplex_batch(table, sx + perlinCount, sy + perlinCount, sz + perlinCount,
+                              nv + perlinCount, k - perlinCount);
+            }
+#endif
+
+            // 3) 층별로 누적
+            if (doMacro) {
+                for (size_t i = 0; i < count; ++i) macroSum[i] += (nv[macroAt + i] * 0.5f + 0.5f) * amplitude;
+                macroMax += amplitude;
+            }
+            if (doMicro) {
+                for (size_t i = 0; i < count; ++i) microSum[i] += (nv[microAt + i] * 0.5f + 0.5f) * amplitude;
+                microMax += amplitude;
+            }
+            if (doRidge) {
+                for (size_t i = 0; i < count; ++i) {
+                    float v = 1.0f - std::fabs(nv[ridgeAt + i]);
+                    v *= v;
+                    v *= weight[i];
+                    ridgeSum[i] += v * ridgeAmp;
+                    weight[i] = clampf(v * p.gain, 0.0f, 1.0f);
+                }
+            }
+
+            amplitude *= p.gain;
+            frequency *= p.lacunarity;
+            ridgeAmp *= 0.5f;
+        }
+
+        // 4) 정규화 + 층별 강도
+        for (size_t i = 0; i < count; ++i) {
+            macroSum[i] = (macroMax == 0.0f ? 0.0f : macroSum[i] / macroMax) * p.macroAmp;
+            microSum[i] = (microMax == 0.0f ? 0.0f : microSum[i] / microMax) * p.microAmp;
+            ridgeSum[i] = ridgeSum[i] * p.ridgeAmp;
+        }
+        PLANET_PERF_LAP(clock, Layers);
+    }
+}
+
+// -------------------------------------------------------------
+// perlin_d_batch / simplex_d_batch
+// -------------------------------------------------------------
+// perlin_d / simplex_d의 배치 버전. 값과 기울기를 value / dx / dy / dz 배열에 나눠 쓴다.
+// simplex_d_batch는 simplex_batch처럼 아직 점마다 simplex_d()를 부른다.
+// -------------------------------------------------------------
+void perlin_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                    float* value, float* dx, float* dy, float* dz, size_t n) {
+    PLANET_PERF_ADD(NoiseSamples, n);
+    float* const out[4] = { value, dx, dy, dz };
+    activeKernel().dFn(table, xs, ys, zs, out, n);
+}
+
+void simplex_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                     float* value, float* dx, float* dy, float* dz, size_t n) {
+    PLANET_PERF_ADD(NoiseSamples, n);
+    for (size_t i = 0; i < n; ++i) {
+        NoiseGrad g = simplex_d(table, xs[i], ys[i], zs[i]);
+        value[i] = g.value;
+        dx[i] = g.dx;
+        dy[i] = g.dy;
+        dz[i] = g.dz;
+    }
+}
+
+namespace {
+
+void basis_d_batch(const NoiseTable& table, NoiseBasis basis, const float* xs, const float* ys, const float* zs,
+                   float* value, float* dx, float* dy, float* dz, size_t n) {
+    if (basis == NoiseBasis::Simplex) simplex_d_batch(table, xs, ys, zs, value, dx, dy, dz, n);
+    else perlin_d_batch(table, xs, ys, zs, value, dx, dy, dz, n);
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// fbm_d_batch / ridged_fbm_d_batch
+// -------------------------------------------------------------
+// fbm_d / ridged_fbm_d(noise.cpp)를 fbm_batch처럼 “옥타브 단위”로 뒤집은 것.
+// 점마다의 누적 순서는 한 점씩 계산할 때와 같아서 결과도 같다.
+// (층 캐시를 채우는 PlanetGenerator::sampleLayers가 사용)
+// -------------------------------------------------------------
+void fbm_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                 float* value, float* dx, float* dy, float* dz, size_t n,
+                 int octaves, float lacunarity, float gain, NoiseBasis basis) {
+    float sx[kBatchChunk], sy[kBatchChunk], sz[kBatchChunk];
+    float nv[kBatchChunk], ndx[kBatchChunk], ndy[kBatchChunk], ndz[kBatchChunk];
+
+    for (size_t base = 0; base < n; base += kBatchChunk) {
+        size_t count = std::min(kBatchChunk, n - base);
+        float* sum = value + base;
+        float* gx = dx + base;
+        float* gy = dy + base;
+        float* gz = dz + base;
+        for (size_t i = 0; i < count; ++i) sum[i] = gx[i] = gy[i] = gz[i] = 0.0f;
+
+        float amplitude = 1.0f;
+        float frequency = 1.0f;
+        float maxAmp = 0.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t i = 0; i < count; ++i) {
+                sx[i] = xs[base + i] * frequency;
+                sy[i] = ys[base + i] * frequency;
+                sz[i] = zs[base + i] * frequency;
+            }
+            basis_d_batch(table, basis, sx, sy, sz, nv, ndx, ndy, ndz, count);
+            float k = 0.5f * amplitude * frequency;
+            for (size_t i = 0; i < count; ++i) {
+                sum[i] += (nv[i] * 0.5f + 0.5f) * amplitude;
+                gx[i] += ndx[i] * k;
+                gy[i] += ndy[i] * k;
+                gz[i] += ndz[i] * k;
+            }
+            maxAmp += amplitude;
+
+            amplitude *= gain;
+            frequency *= lacunarity;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (maxAmp == 0.0f) {
+                sum[i] = gx[i] = gy[i] = gz[i] = 0.0f;
+            } else {
+                sum[i] = sum[i] / maxAmp;
+                gx[i] = gx[i] / maxAmp;
+                gy[i] = gy[i] / maxAmp;
+                gz[i] = gz[i] / maxAmp;
+            }
+        }
+    }
+}
+
+void ridged_fbm_d_batch(const NoiseTable& table, const float* xs, const float* ys, const float* zs,
+                        float* value, float* dx, float* dy, float* dz, size_t n,
+                        int octaves, float lacunarity, float gain, NoiseBasis basis) {
+    float sx[kBatchChunk], sy[kBatchChunk], sz[kBatchChunk];
+    float nv[kBatchChunk], ndx[kBatchChunk], ndy[kBatchChunk], ndz[kBatchChunk];
+    float weight[kBatchChunk], wdx[kBatchChunk], wdy[kBatchChunk], wdz[kBatchChunk]; // weight와 그 기울기
+
+    for (size_t base = 0; base < n; base += kBatchChunk) {
+        size_t count = std::min(kBatchChunk, n - base);
+        float* sum = value + base;
+        float* gx = dx + base;
+        float* gy = dy + base;
+        float* gz = dz + base;
+        for (size_t i = 0; i < count; ++i) {
+            sum[i] = gx[i] = gy[i] = gz[i] = 0.0f;
+            weight[i] = 1.0f;
+            wdx[i] = wdy[i] = wdz[i] = 0.0f;
+        }
+
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+
+        for (int o = 0; o < octaves; ++o) {
+            for (size_t i = 0; i < count; ++i) {
+                sx[i] = xs[base + i] * frequency;
+                sy[i] = ys[base + i] * frequency;
+                sz[i] = zs[base + i] * frequency;
+            }
+            basis_d_batch(table, basis, sx, sy, sz, nv, ndx, ndy, ndz, count);
+            for (size_t i = 0; i < count; ++i) {
+                // ridged_fbm_d_impl과 같은 단계: 1 - |p|, 제곱, weight 곱하기
+                float v = 1.0f - std::fabs(nv[i]);
+                float k = (nv[i] < 0.0f ? 1.0f : -1.0f) * frequency;
+                float vx = ndx[i] * k, vy = ndy[i] * k, vz = ndz[i] * k;
+
+                vx *= 2.0f * v; vy *= 2.0f * v; vz *= 2.0f * v;
+                v *= v;
+
+                vx = vx * weight[i] + v * wdx[i];
+                vy = vy * weight[i] + v * wdy[i];
+                vz = vz * weight[i] + v * wdz[i];
+                v *= weight[i];
+
+                sum[i] += v * amplitude;
+                gx[i] += vx * amplitude;
+                gy[i] += vy * amplitude;
+                gz[i] += vz * amplitude;
+
+                float wv = v * gain;
+                weight[i] = clampf(wv, 0.0f, 1.0f);
+                bool inside = wv > 0.0f && wv < 1.0f;
+                wdx[i] = inside ? vx * gain : 0.0f;
+                wdy[i] = inside ? vy * gain : 0.0f;
+                wdz[i] = inside ? vz * gain : 0.0f;
+            }
+
+            frequency *= lacunarity;
+            amplitude *= 0.5f;
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#include "noise_volume.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <cmath>
+
+// 한 번에 terrain_layers_batch로 넘기는 격자 점 개수
+static const size_t kBakeChunk = 256;
+
+// --------------------------------------------------------------
+// bake
+// --------------------------------------------------------------
+// 격자 범위는 [-E, E]^3, 칸 크기 h = 2E / (N - 1).
+// 단위 구 바깥으로 한 칸씩 여유를 두도록 E = 1 + h  →  E = (N - 1) / (N - 3).
+//
+// 단위 구 위의 점을 보간할 때 쓰이는 격자 점은
+// 그 점이 들어 있는 칸의 꼭짓점 8개뿐이고, 모두 점에서 h*sqrt(3) 안에 있다.
+// 그래서 | |node| - 1 | <= h*sqrt(3) 인 격자 점만 계산하고 나머지는 0으로 둔다.
+// (N = 64에서 전체 262,144개 중 약 36,000개)
+// --------------------------------------------------------------
+void NoiseVolume::bake(const NoiseTable& table, const NoiseParams& params, int resolution) {
+    res_ = std::max(8, std::min(resolution, 256));
+    float extent = float(res_ - 1) / float(res_ - 3);
+    lo_ = -extent;
+    cell_ = 2.0f * extent / float(res_ - 1);
+    invCell_ = 1.0f / cell_;
+
+    size_t total = static_cast<size_t>(res_) * res_ * res_;
+    data_.assign(total * 3, 0.0f);
+    bakedNodes_ = 0;
+
+    // 반올림 오차로 꼭 필요한 점이 빠지지 않도록 조금 넓게 잡는다.
+    float band = cell_ * 1.7320508f * 1.01f;
+
+    size_t idx[kBakeChunk];
+    float xs[kBakeChunk], ys[kBakeChunk], zs[kBakeChunk];
+    float macro[kBakeChunk], micro[kBakeChunk], ridge[kBakeChunk];
+    size_t m = 0;
+
+    auto flush = [&]() {
+        terrain_layers_batch(table, params, xs, ys, zs, macro, micro, ridge, m);
+        for (size_t i = 0; i < m; ++i) {
+            float* node = &data_[idx[i] * 3];
+            node[0] = macro[i];
+            node[1] = micro[i];
+            node[2] = ridge[i];
+        }
+        bakedNodes_ += m;
+        m = 0;
+    };
+
+    for (int k = 0; k < res_; ++k) {
+        float z = lo_ + k * cell_;
+        for (int j = 0; j < res_; ++j) {
+            float y = lo_ + j * cell_;
+            for (int i = 0; i < res_; ++i) {
+                float x = lo_ + i * cell_;
+                float r = std::sqrt(x * x + y * y + z * z);
+                if (std::fabs(r - 1.0f) > band) continue;
+
+                idx[m] = index(i, j, k);
+                xs[m] = x; ys[m] = y; zs[m] = z;
+                if (++m == kBakeChunk) flush();
+            }
+        }
+    }
+    if (m > 0) flush();
+}
+
+void NoiseVolume::clear() {
+    data_.clear();
+    data_.shrink_to_fit();
+    res_ = 0;
+    bakedNodes_ = 0;
+}
+
+// --------------------------------------------------------------
+// locate
+// --------------------------------------------------------------
+// 좌표를 격자 단위로 바꿔 칸 번호(0 ~ N-2)와 칸 안의 위치(0~1)를 구한다.
+// --------------------------------------------------------------
+void NoiseVolume::locate(float x, float y, float z, int cell[3], float frac[3]) const {
+    const float p[3] = { x, y, z };
+    for (int a = 0; a < 3; ++a) {
+        float g = (p[a] - lo_) * invCell_;
+        int c = static_cast<int>(std::floor(g));
+        c = std::max(0, std::min(c, res_ - 2));
+        cell[a] = c;
+        frac[a] = clampf(g - float(c), 0.0f, 1.0f);
+    }
+}
+
+// --------------------------------------------------------------
+// sample
+// --------------------------------------------------------------
+// 칸의 꼭짓점 8개를 x → y → z 순서로 선형 보간한다. (세 층을 한 번에)
+// --------------------------------------------------------------
+TerrainLayers NoiseVolume::sample(float x, float y, float z) const {
+    int c[3];
+    float f[3];
+    locate(x, y, z, c, f);
+
+    const size_t dx = 3, dy = static_cast<size_t>(res_) * 3, dz = dy * res_;
+    const float* base = &data_[index(c[0], c[1], c[2]) * 3];
+
+    float out[3];
+    for (int l = 0; l < 3; ++l) {
+        const float* v = base + l;
+        float x00 = lerp(v[0],            v[dx],            f[0]);
+        float x10 = lerp(v[dy],           v[dy + dx],       f[0]);
+        float x01 = lerp(v[dz],           v[dz + dx],       f[0]);
+        float x11 = lerp(v[dz + dy],      v[dz + dy + dx],  f[0]);
+        float y0 = lerp(x00, x10, f[1]);
+        float y1 = lerp(x01, x11, f[1]);
+        out[l] = lerp(y0, y1, f[2]);
+    }
+    return TerrainLayers{ out[0], out[1], out[2] };
+}
+
+// --------------------------------------------------------------
+// sampleGrad
+// --------------------------------------------------------------
+// sample과 같은 값 + 보간식의 (x, y, z) 편미분.
+//   d/dx = [ (v100 - v000)(1-fy)(1-fz) + (v110 - v010) fy (1-fz)
+//          + (v101 - v001)(1-fy) fz    + (v111 - v011) fy fz ] / h   (y, z도 같은 방식)
+// 결과 NoiseGrad의 value / dx / dy / dz는 모두 층별 강도까지 곱한 값이다.
+// --------------------------------------------------------------
+TerrainLayers NoiseVolume::sampleGrad(float x, float y, float z,
+                                      NoiseGrad& macro, NoiseGrad& micro, NoiseGrad& ridge) const {
+    int c[3];
+    float f[3];
+    locate(x, y, z, c, f);
+
+    const size_t dx = 3, dy = static_cast<size_t>(res_) * 3, dz = dy * res_;
+    const float* base = &data_[index(c[0], c[1], c[2]) * 3];
+    const float gy = 1.0f - f[1], gz = 1.0f - f[2];
+
+    NoiseGrad* out[3] = { &macro, &micro, &ridge };
+    for (int l = 0; l < 3; ++l) {
+        const float* v = base + l;
+        float v000 = v[0],       v100 = v[dx];
+        float v010 = v[dy],      v110 = v[dy + dx];
+        float v001 = v[dz],      v101 = v[dz + dx];
+        float v011 = v[dz + dy], v111 = v[dz + dy + dx];
+
+        float x00 = lerp(v000, v100, f[0]);
+        float x10 = lerp(v010, v110, f[0]);
+        float x01 = lerp(v001, v101, f[0]);
+        float x11 = lerp(v011, v111, f[0]);
+        float y0 = lerp(x00, x10, f[1]);
+        float y1 = lerp(x01, x11, f[1]);
+
+        NoiseGrad& g = *out[l];
+        g.value = lerp(y0, y1, f[2]);
+        g.dx = ((v100 - v000) * gy * gz + (v110 - v010) * f[1] * gz
+              + (v101 - v001) * gy * f[2] + (v111 - v011) * f[1] * f[2]) * invCell_;
+        g.dy = ((x10 - x00) * gz + (x11 - x01) * f[2]) * invCell_;
+        g.dz = (y1 - y0) * invCell_;
+    }
+    return TerrainLayers{ macro.value, micro.value, ridge.value };
+}
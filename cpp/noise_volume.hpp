@@ -0,0 +1,59 @@
+#pragma once
+#include "noise.hpp"
+#include "noise_params.hpp"
+#include <cstddef>
+#include <vector>
+
+// noise_volume.hpp
+// -------------------------------------------------------------
+// NoiseVolume: 지형 세 층(macro / micro / ridge)을 미리 구워 둔 3D 격자.
+//
+// scale / radius만 바뀔 때도 점마다 모든 옥타브를 다시 계산하던 것을
+// “격자에서 값 읽기 + 3선형(trilinear) 보간”으로 바꾸기 위한 미리보기용 캐시.
+//
+//   - 격자는 단위 구를 감싸는 정육면체(한 칸 여유 포함)를 N x N x N으로 나눈다.
+//   - 구 표면 근처(보간에 쓰일 수 있는) 격자 점만 계산하므로
+//     N^3 전체를 계산하는 것보다 훨씬 빠르다.
+//   - 저장하는 값은 terrain_layers와 같은 “params의 층별 강도까지 곱한 값”이고,
+//     scale / radius와는 상관없다. (seed / 방식 / 종류가 바뀔 때만 다시 굽는다)
+//     PlanetGenerator는 강도를 1로 두고 구워서, 강도만 바뀔 때는 다시 굽지 않는다.
+//
+// 보간 오차는 PlanetGenerator::setPreviewMode가 정확한 계산과 비교해서 잰다.
+// -------------------------------------------------------------
+class NoiseVolume {
+public:
+    // table / params로 resolution^3 격자를 굽는다. (resolution은 8~256으로 맞춤)
+    void bake(const NoiseTable& table, const NoiseParams& params, int resolution);
+
+    // 구운 데이터를 버린다.
+    void clear();
+
+    bool empty() const { return data_.empty(); }
+    int resolution() const { return res_; }
+
+    // 구운 격자 점 개수 (구 표면 근처만)
+    size_t bakedNodeCount() const { return bakedNodes_; }
+
+    // (x, y, z) : 단위 구 위의 점 (격자 밖이면 가장자리 칸으로 맞춘다)
+    TerrainLayers sample(float x, float y, float z) const;
+
+    // sample + 층별 기울기 (보간식의 해석적 미분, 칸 안에서는 1차식)
+    TerrainLayers sampleGrad(float x, float y, float z,
+                             NoiseGrad& macro, NoiseGrad& micro, NoiseGrad& ridge) const;
+
+private:
+    // 격자 점 (i, j, k)의 세 층 값이 data_[index * 3 + 0..2]에 있다.
+    size_t index(int i, int j, int k) const {
+        return (static_cast<size_t>(k) * res_ + j) * res_ + i;
+    }
+
+    // 점이 들어 있는 칸과 칸 안의 위치(0~1)
+    void locate(float x, float y, float z, int cell[3], float frac[3]) const;
+
+    std::vector<float> data_;
+    int res_ = 0;
+    float lo_ = 0.0f;      // 격자 시작 좌표 (세 축 공통)
+    float cell_ = 0.0f;    // 칸 하나의 크기
+    float invCell_ = 0.0f;
+    size_t bakedNodes_ = 0;
+};
@@ -0,0 +1,53 @@
+#include "perf_counters.hpp"
+
+// perf_counters.cpp
+// -------------------------------------------------------------
+// PLANET_PERF_COUNTERS = 1일 때의 전역 계수기 / 단계별 타이머.
+// (0이면 이 파일은 비어 있다)
+// -------------------------------------------------------------
+#if PLANET_PERF_COUNTERS
+
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+std::atomic<uint64_t> g_counters[kPerfCounterCount];
+std::atomic<uint64_t> g_stageNs[kPerfStageCount];
+std::atomic<uint64_t> g_stageCalls[kPerfStageCount];
+
+} // namespace
+
+void perfAdd(PerfCounter counter, uint64_t n) {
+    g_counters[static_cast<int>(counter)].fetch_add(n, std::memory_order_relaxed);
+}
+
+uint64_t perfNow() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t perfLap(uint64_t start, PerfStage stage) {
+    const uint64_t now = perfNow();
+    const int s = static_cast<int>(stage);
+    g_stageNs[s].fetch_add(now - start, std::memory_order_relaxed);
+    g_stageCalls[s].fetch_add(1, std::memory_order_relaxed);
+    return now;
+}
+
+void perfRead(double* out) {
+    for (int i = 0; i < kPerfCounterCount; ++i)
+        *out++ = static_cast<double>(g_counters[i].load(std::memory_order_relaxed));
+    for (int i = 0; i < kPerfStageCount; ++i)
+        *out++ = static_cast<double>(g_stageNs[i].load(std::memory_order_relaxed));
+    for (int i = 0; i < kPerfStageCount; ++i)
+        *out++ = static_cast<double>(g_stageCalls[i].load(std::memory_order_relaxed));
+}
+
+void perfReset() {
+    for (auto& c : g_counters) c.store(0, std::memory_order_relaxed);
+    for (auto& c : g_stageNs) c.store(0, std::memory_order_relaxed);
+    for (auto& c : g_stageCalls) c.store(0, std::memory_order_relaxed);
+}
+
+#endif
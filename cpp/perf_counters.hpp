@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// perf_counters.hpp
+// -------------------------------------------------------------
+// 지형 계산의 계수기(counter)와 단계별 타이머(stage timer).
+//
+// 지형을 다시 계산할 때 시간이 어디에 쓰이는지 보기 위한 것이다.
+// (정규화 / 세 노이즈 층 / 산맥 마스크 / 섞기 / 결과 쓰기)
+//
+// PLANET_PERF_COUNTERS를 1로 빌드할 때만 켜진다. (기본 0)
+//   - CMake : -DPLANET_PERF_COUNTERS=ON
+//   - WASM  : PLANET_PERF_COUNTERS=1 ./build.sh
+// 0이면 아래 매크로가 모두 빈 문장이 되어 계산 코드에 아무것도 남지 않는다.
+// 그래서 릴리스 빌드에 그대로 두어도 된다.
+//
+// 켜면 값은 전역(모든 PlanetGenerator / 스레드 합계)으로 모이고,
+// C API get_perf_counters / reset_perf_counters로 읽고 지운다. (planet.hpp)
+// 스레드 여러 개가 같은 원자(atomic) 변수에 더하므로, 켠 빌드의 시간은 끈 빌드보다 느리다.
+// 단계별 시간 비율을 보는 용도로 쓴다.
+// 시간은 steady_clock(ns)이다. 브라우저는 타이머 정밀도를 낮추므로
+// WASM에서는 한 점씩 계산하는 get_height의 단계 시간보다 배치 단계 시간을 보는 편이 낫다.
+// -------------------------------------------------------------
+#ifndef PLANET_PERF_COUNTERS
+#define PLANET_PERF_COUNTERS 0
+#endif
+
+enum class PerfCounter : int {
+    NoiseSamples = 0, // 격자 노이즈(Perlin / Simplex) 한 점 계산 수 (옥타브마다 1)
+    MacroOctaves = 1, // 층별로 계산한 옥타브 수 (점 수 x 옥타브 수)
+    MicroOctaves = 2,
+    RidgeOctaves = 3,
+    Vertices = 4,     // 최종 높이를 계산한 점 수 (get_height, 배치, 메쉬, LOD 모두)
+    HeightCalls = 5,  // 한 점짜리 get_height(PlanetGenerator::height) 호출 수
+};
+constexpr int kPerfCounterCount = 6;
+
+enum class PerfStage : int {
+    Normalize = 0, // 입력 좌표 → 단위 방향
+    Macro = 1,     // 층별 격자 노이즈 (+ 기울기). 세 층을 합쳐 계산하는 커널에서도 층마다 잰다.
+    Micro = 2,
+    Ridge = 3,
+    Layers = 4,    // 층 계산 중 노이즈가 아닌 부분 (좌표 준비, 옥타브 누적, 정규화, 캐시 쓰기, 미리보기 격자 보간)
+    Combine = 5,   // 극지 효과 + 섞기 (메쉬 경로는 법선까지)
+    WriteBack = 6, // 결과 위치를 버퍼에 쓰기
+    RidgeMask = 7, // 산맥 마스크 (macro로 만든 대륙 마스크, get_height / 배치 경로)
+};
+constexpr int kPerfStageCount = 8;
+
+// get_perf_counters가 쓰는 값 수: [계수기 6 | 단계별 ns 8 | 단계별 횟수 8]
+constexpr int kPerfValueCount = kPerfCounterCount + 2 * kPerfStageCount;
+
+#if PLANET_PERF_COUNTERS
+
+void perfAdd(PerfCounter counter, uint64_t n);
+uint64_t perfNow();
+// now - start를 stage에 더하고 now를 돌려준다.
+uint64_t perfLap(uint64_t start, PerfStage stage);
+// out[kPerfValueCount]에 지금 값을 double로 쓴다.
+void perfRead(double* out);
+void perfReset();
+
+// PLANET_PERF_ADD(Vertices, n)
+#define PLANET_PERF_ADD(counter, n) perfAdd(PerfCounter::counter, static_cast<uint64_t>(n))
+// PLANET_PERF_CLOCK(clock) 뒤에 단계마다 PLANET_PERF_LAP(clock, Stage)를 부르면
+// 앞 LAP(또는 CLOCK / RESET)부터 걸린 시간이 그 단계에 더해진다.
+// 재지 않을 구간 뒤에는 PLANET_PERF_RESET(clock)으로 시작 시각만 다시 잡는다.
+#define PLANET_PERF_CLOCK(clock) uint64_t clock = perfNow()
+#define PLANET_PERF_LAP(clock, stage) (clock = perfLap(clock, PerfStage::stage))
+#define PLANET_PERF_RESET(clock) (clock = perfNow())
+
+#else
+
+#define PLANET_PERF_ADD(counter, n) ((void)0)
+#define PLANET_PERF_CLOCK(clock) ((void)0)
+#define PLANET_PERF_LAP(clock, stage) ((void)0)
+#define PLANET_PERF_RESET(clock) ((void)0)
+
+#endif
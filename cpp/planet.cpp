@@ -1,173 +1,1486 @@
 #include "util.hpp"
+#include "planet.hpp" // PlanetGenerator, C 인터페이스 선언
+#include "mesh_buffers.hpp"
+#include "mesh_normals.hpp"
+#include "terrain_lod.hpp"
+#include "perf_counters.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+// --------------------------------------------------------------
+// combine_height
+// --------------------------------------------------------------
+// 세 노이즈 층(macro / micro / ridge)의 값을 섞어 최종 높이를 만든다.
+// height()와 heightBatch()가 같은 공식을 쓰도록 따로 뺐다.
+// 산맥 마스크(continent_mask)와 나머지(blend_height)로 나뉘어 있어서
+// 계수기 빌드에서는 두 단계를 따로 잴 수 있다. (PerfStage::RidgeMask / Combine)
+//
+// ny    : 정규화된 방향의 y 성분 (극지방 판단용)
+// scale : 지형 전체 높이 배율
+// --------------------------------------------------------------
+static inline float continent_mask(float macro) {
+    // ---------- 4) 육지 마스크 ----------
+    // macro가 어느 정도 이상일 때만 산맥을 살아 있게 하고,
+    // 바다 근처에서는 산맥 효과가 약하도록 만든다.
+    return smoothstep(0.35f, 0.65f, macro);
+}
+
+static inline float blend_height(float macro, float micro, float ridge, float continentMask, float ny, float scale) {
+    // ---------- 5) 극지방 효과 ----------
+    // y축이 위아래 방향이라, y가 ±1에 가까울수록 북/남극.
+    // 극지에는 약간의 얼음층/평원 같은 효과를 추가.
+    float lat = std::fabs(ny);
+    float polarBoost = smoothstep(0.6f, 0.95f, lat) * 0.08f;
+
+    // ---------- 6) 최종 높이 계산 ----------
+    // 각 요소를 비율로 섞어서 전체 지형을 구성한다.
+    float height = macro * 0.65f
+                 + micro * 0.30f
+                 + ridge * continentMask * 0.6f
+                 + polarBoost;
+
+    // ---------- 7) 바다 수위 조절 ----------
+    // seaLevel 값이 클수록 물이 많아지고 육지가 줄어든다.
+    const float seaLevel = 0.45f;
+    height -= seaLevel;
+
+    // ---------- 8) 전체 높이 배율 ----------
+    // 사용자가 입력한 scale 값에 따라 지형의 높낮이를 조절
+    height *= scale;
+
+    return height;
+}
+
+static inline float combine_height(float macro, float micro, float ridge, float ny, float scale) {
+    return blend_height(macro, micro, ridge, continent_mask(macro), ny, scale);
+}
+
+// --------------------------------------------------------------
+// combine_height_grad
+// --------------------------------------------------------------
+// combine_height의 기울기(gradient).
+// 세 층의 값(macro / micro / ridge)과 각 층의 기울기(g*)를 받아
+// 최종 높이의 기울기를 돌려준다. (combine_height와 같은 계수를 써야 한다)
+// --------------------------------------------------------------
+static inline Vec3 combine_height_grad(float macro, const Vec3& gMacro, const Vec3& gMicro,
+                                       float ridge, const Vec3& gRidge, float ny, float scale) {
+    float continentMask = smoothstep(0.35f, 0.65f, macro);
+    float maskDeriv = smoothstepDeriv(0.35f, 0.65f, macro);
+
+    // height = macro*0.65 + micro*0.30 + ridge*mask(macro)*0.6 + polar(|ny|)
+    float kMacro = 0.65f + ridge * maskDeriv * 0.6f;
+    float kRidge = continentMask * 0.6f;
+    Vec3 g(gMacro.x * kMacro + gMicro.x * 0.30f + gRidge.x * kRidge,
+           gMacro.y * kMacro + gMicro.y * 0.30f + gRidge.y * kRidge,
+           gMacro.z * kMacro + gMicro.z * 0.30f + gRidge.z * kRidge);
+
+    float polarDeriv = smoothstepDeriv(0.6f, 0.95f, std::fabs(ny)) * 0.08f;
+    g.y += ny < 0.0f ? -polarDeriv : polarDeriv;
+
+    g.x *= scale; g.y *= scale; g.z *= scale;
+    return g;
+}
+
+// 배치 계산 때 한 번에 처리하는 점 개수(스택 버퍼 크기)
+static const size_t kHeightChunk = 256;
+
+// 멀티스레드 버전에서 스레드 하나가 한 번에 가져가는 정점 개수
+// 정점 하나가 12바이트라서 16의 배수로 잡으면 조각 경계가 64바이트(캐시 라인)에 맞는다.
+// → 두 스레드가 같은 캐시 라인에 쓰지 않는다. (buffer 시작이 정렬되어 있을 때)
+static const size_t kParallelChunk = 1024;
+static_assert(kParallelChunk % 16 == 0, "chunk must cover whole cache lines");
+
+// 미리보기 오차를 잴 때 쓰는 방향 개수 (피보나치 구 배치)
+static const size_t kPreviewErrorSamples = 16384;
+
+// terrainRevision / layerRevision에 쓸 다음 번호 (모든 생성기가 같이 써서 생성기끼리 번호가 겹치지 않는다)
+static std::atomic<uint64_t> g_nextTerrainRevision{ 1 };
+
+static uint64_t nextTerrainRevision() {
+    return g_nextTerrainRevision.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --------------------------------------------------------------
+// surface_normal
+// --------------------------------------------------------------
+// 높이의 3D 기울기 g(scale 적용 후)를 구의 접평면으로 투영해서(gt = g - (g·n)n) 법선을 만든다.
+//   표면 위치가 P = n * r (r = radius + h) 일 때  법선 = normalize(n - gt / r)
+// heightAndNormalUnit / displaceUnitWithNormals / shapeLayers가 같은 식을 쓰도록 따로 뺐다.
+// --------------------------------------------------------------
+static inline void surface_normal(const Vec3& n, const Vec3& g, float r, float* normal) {
+    float gn = g.x * n.x + g.y * n.y + g.z * n.z;
+    Vec3 out = n;
+    if (std::fabs(r) > 1e-6f) {
+        float inv = 1.0f / r;
+        out = normalize(Vec3(n.x - (g.x - gn * n.x) * inv,
+                             n.y - (g.y - gn * n.y) * inv,
+                             n.z - (g.z - gn * n.z) * inv));
+    }
+    normal[0] = out.x;
+    normal[1] = out.y;
+    normal[2] = out.z;
+}
+
+// --------------------------------------------------------------
+// read_param / write_param / param_layers
+// --------------------------------------------------------------
+// NoiseParam 번호로 NoiseParams의 값 하나를 읽고 쓴다. (옥타브는 int로 반올림)
+// param_layers : 그 값이 모양을 바꾸는 층 비트 (강도는 0, lacunarity / gain은 세 층 모두)
+// --------------------------------------------------------------
+static float read_param(const NoiseParams& p, NoiseParam param) {
+    switch (param) {
+    case NoiseParam::MacroFreq:    return p.macroFreq;
+    case NoiseParam::MacroOctaves: return float(p.macroOctaves);
+    case NoiseParam::MacroAmp:     return p.macroAmp;
+    case NoiseParam::MicroFreq:    return p.microFreq;
+    case NoiseParam::MicroOctaves: return float(p.microOctaves);
+    case NoiseParam::MicroAmp:     return p.microAmp;
+    case NoiseParam::RidgeFreq:    return p.ridgeFreq;
+    case NoiseParam::RidgeOctaves: return float(p.ridgeOctaves);
+    case NoiseParam::RidgeAmp:     return p.ridgeAmp;
+    case NoiseParam::Lacunarity:   return p.lacunarity;
+    case NoiseParam::Gain:         return p.gain;
+    }
+    return 0.0f;
+}
+
+static void write_param(NoiseParams& p, NoiseParam param, float value) {
+    const int octaves = std::max(1, std::min(static_cast<int>(std::lround(value)), 12));
+    const float positive = std::max(value, 1e-4f);
+    switch (param) {
+    case NoiseParam::MacroFreq:    p.macroFreq = positive; break;
+    case NoiseParam::MacroOctaves: p.macroOctaves = octaves; break;
+    case NoiseParam::MacroAmp:     p.macroAmp = value; break;
+    case NoiseParam::MicroFreq:    p.microFreq = positive; break;
+    case NoiseParam::MicroOctaves: p.microOctaves = octaves; break;
+    case NoiseParam::MicroAmp:     p.microAmp = value; break;
+    case NoiseParam::RidgeFreq:    p.ridgeFreq = positive; break;
+    case NoiseParam::RidgeOctaves: p.ridgeOctaves = octaves; break;
+    case NoiseParam::RidgeAmp:     p.ridgeAmp = value; break;
+    case NoiseParam::Lacunarity:   p.lacunarity = positive; break;
+    case NoiseParam::Gain:         p.gain = value; break;
+    }
+}
+
+static int param_layers(NoiseParam param) {
+    switch (param) {
+    case NoiseParam::MacroFreq:
+    case NoiseParam::MacroOctaves: return 1 << static_cast<int>(TerrainLayer::Macro);
+    case NoiseParam::MicroFreq:
+    case NoiseParam::MicroOctaves: return 1 << static_cast<int>(TerrainLayer::Micro);
+    case NoiseParam::RidgeFreq:
+    case NoiseParam::RidgeOctaves: return 1 << static_cast<int>(TerrainLayer::Ridge);
+    case NoiseParam::Lacunarity:
+    case NoiseParam::Gain:         return kAllTerrainLayers;
+    default:                       return 0;
+    }
+}
+
+// --------------------------------------------------------------
+// PlanetGenerator 생성 / 초기화
+// --------------------------------------------------------------
+// seed   : 행성의 지형이 결정되는 “유전 암호” 같은 역할
+// scale  : 산의 높이, 골짜기 깊이 등 전체 높이를 얼마나 키울지
+// radius : 행성의 기본 크기(지름이 아니라 반지름!)
+//
+// init이 호출되면:
+// 1) 이 생성기 전용 노이즈 테이블이 초기화되고
+// 2) 노이즈 파라미터(대륙/산맥 스타일)가 시드 기반으로 자동 생성된다.
+// --------------------------------------------------------------
+PlanetGenerator::PlanetGenerator(uint32_t seed, float scale, float radius) {
+    table_.backend = NoiseBackend::Table;
+    params_.macroBasis = NoiseBasis::Perlin;
+    params_.microBasis = NoiseBasis::Perlin;
+    params_.ridgeBasis = NoiseBasis::Perlin;
+    init(seed, scale, radius);
+}
+
+void PlanetGenerator::init(uint32_t seed, float scale, float radius) {
+    scale_ = scale;
+    radius_ = radius;
+
+    // seed가 그대로면 노이즈 테이블 / 파라미터 / 미리보기 격자가 모두 그대로이므로
+    // scale / radius만 바꾸고 끝낸다. (지형 캐시도 그대로 쓸 수 있다)
+    if (terrainRevision_ != 0 && seed == seed_) return;
+
+    seed_ = seed;
+
+    // 노이즈 엔진 초기화(시드 기반으로 랜덤 테이블 생성)
+    // 노이즈 방식은 setNoiseBackend로 정해 둔 것을 그대로 쓴다.
+    initNoiseTable(table_, seed_, table_.backend);
+
+    // 시드를 기반으로 노이즈 파라미터(지형 스타일) 자동 생성
+    // 층별 노이즈 종류는 setLayerBasis로 정해 둔 것을 유지한다.
+    NoiseParams prev = params_;
+    params_ = generateNoiseParams(seed_);
+    params_.macroBasis = prev.macroBasis;
+    params_.microBasis = prev.microBasis;
+    params_.ridgeBasis = prev.ridgeBasis;
+
+    // setParam으로 정해 둔 값도 유지한다.
+    for (int i = 0; i < kNoiseParamCount; ++i) {
+        if (overrideMask_ & (1u << i)) write_param(params_, static_cast<NoiseParam>(i), overrides_[i]);
+    }
+
+    touchLayers(kAllTerrainLayers);
+    refreshPreview();
+}
+
+// --------------------------------------------------------------
+// touchLayers
+// --------------------------------------------------------------
+// layers 비트의 층 번호를 새로 받는다. 지형 번호는 항상 새로 받는다.
+// (layers가 0이면 강도처럼 층 모양은 그대로이고 섞는 값만 바뀐 경우)
+// --------------------------------------------------------------
+void PlanetGenerator::touchLayers(int layers) {
+    terrainRevision_ = nextTerrainRevision();
+    for (int l = 0; l < 3; ++l) {
+        if (layers & (1 << l)) layerRevisions_[l] = nextTerrainRevision();
+    }
+}
+
+// --------------------------------------------------------------
+// setNoiseBackend
+// --------------------------------------------------------------
+// Table  : 퍼뮤테이션 테이블 방식 (원래 지형)
+// Hashed : 격자 해시 방식 (테이블 조회가 없어서 SIMD에서 더 빠르다)
+//
+// 같은 seed라도 방식이 다르면 지형 모양이 달라진다.
+// NoiseParams(지형 스타일)는 seed로만 정해지므로 그대로 둔다.
+// --------------------------------------------------------------
+void PlanetGenerator::setNoiseBackend(NoiseBackend backend) {
+    initNoiseTable(table_, seed_, backend);
+    touchLayers(kAllTerrainLayers);
+    refreshPreview();
+}
+
+// --------------------------------------------------------------
+// setLayerBasis
+// --------------------------------------------------------------
+// 층 하나(macro / micro / ridge)의 기본 노이즈를 Perlin / Simplex 중에서 고른다.
+// 나머지 파라미터(주파수, 옥타브 수 ...)는 그대로 둔다.
+// --------------------------------------------------------------
+void PlanetGenerator::setLayerBasis(TerrainLayer layer, NoiseBasis basis) {
+    switch (layer) {
+    case TerrainLayer::Macro: params_.macroBasis = basis; break;
+    case TerrainLayer::Micro: params_.microBasis = basis; break;
+    case TerrainLayer::Ridge: params_.ridgeBasis = basis; break;
+    }
+    touchLayers(1 << static_cast<int>(layer));
+    refreshPreview();
+}
+
+// --------------------------------------------------------------
+// setParam / param / clearParamOverrides
+// --------------------------------------------------------------
+// 값이 실제로 바뀐 경우에만 층 번호를 바꾸고 미리보기를 갱신한다.
+//   - 주파수 / 옥타브 : 그 층만 다시 계산 (미리보기 격자는 다시 굽는다)
+//   - 강도            : 다시 계산하는 층 없음, 섞기만 다시 (미리보기 격자도 그대로)
+//   - lacunarity / gain : 세 층 모두
+// --------------------------------------------------------------
+void PlanetGenerator::setParam(NoiseParam param, float value) {
+    const int index = static_cast<int>(param);
+    if (index < 0 || index >= kNoiseParamCount) return;
+
+    NoiseParams next = params_;
+    write_param(next, param, value);
+    overrides_[index] = read_param(next, param);
+    overrideMask_ |= 1u << index;
+    if (read_param(next, param) == read_param(params_, param)) return;
+
+    params_ = next;
+    const int layers = param_layers(param);
+    touchLayers(layers);
+    if (layers != 0) {
+        refreshPreview();
+    } else if (previewEnabled_) {
+        measurePreviewError();
+    } else {
+        previewErrorStale_ = true;
+    }
+}
+
+float PlanetGenerator::param(NoiseParam param) const {
+    return read_param(params_, param);
+}
+
+void PlanetGenerator::clearParamOverrides() {
+    overrideMask_ = 0;
+
+    NoiseParams fresh = generateNoiseParams(seed_);
+    fresh.macroBasis = params_.macroBasis;
+    fresh.microBasis = params_.microBasis;
+    fresh.ridgeBasis = params_.ridgeBasis;
+
+    bool changed = false;
+    int layers = 0;
+    for (int i = 0; i < kNoiseParamCount; ++i) {
+        NoiseParam param = static_cast<NoiseParam>(i);
+        if (read_param(fresh, param) != read_param(params_, param)) {
+            changed = true;
+            layers |= param_layers(param);
+        }
+    }
+    if (!changed) return;
+
+    params_ = fresh;
+    touchLayers(layers);
+    if (layers != 0) {
+        refreshPreview();
+    } else if (previewEnabled_) {
+        measurePreviewError();
+    } else {
+        previewErrorStale_ = true;
+    }
+}
+
+// --------------------------------------------------------------
+// setPreviewMode
+// --------------------------------------------------------------
+// resolution > 0 : 미리보기를 켠다. 같은 해상도로 이미 구워 둔 격자가 있으면 그대로 쓴다.
+// resolution <= 0 : 미리보기를 끈다. (구운 격자는 지형이 바뀔 때까지 남겨 둬서
+//                   다시 켤 때 바로 쓸 수 있다)
+// --------------------------------------------------------------
+void PlanetGenerator::setPreviewMode(int resolution) {
+    if (resolution <= 0) {
+        if (previewEnabled_) touchLayers(kAllTerrainLayers);
+        previewEnabled_ = false;
+        return;
+    }
+    if (!previewEnabled_ || resolution != previewResolution_) touchLayers(kAllTerrainLayers);
+    previewEnabled_ = true;
+    if (resolution != previewResolution_) {
+        previewResolution_ = resolution;
+        volume_.clear();
+    }
+    if (volume_.empty()) {
+        refreshPreview();
+    } else if (previewErrorStale_) {
+        measurePreviewError();
+    }
+}
+
+// --------------------------------------------------------------
+// refreshPreview
+// --------------------------------------------------------------
+// 지형이 바뀌었을 때 부른다.
+// 미리보기가 꺼져 있으면 격자만 비우고,
+// 켜져 있으면 다시 구운 뒤 정확한 계산과 비교해 오차를 잰다.
+//
+// 오차(measurePreviewError)는 scale = 1일 때의 최종 높이 차이로 잰다.
+// combine_height는 마지막에 scale을 곱하기만 하므로
+// 다른 scale에서의 오차는 여기에 |scale|을 곱한 값이다. (previewMaxError)
+// --------------------------------------------------------------
+void PlanetGenerator::refreshPreview() {
+    volume_.clear();
+    previewMaxErr_ = 0.0f;
+    previewRmsErr_ = 0.0f;
+    previewErrorStale_ = false;
+    if (!previewEnabled_) return;
+
+    // 강도는 previewLayers에서 곱하므로 격자는 강도 1로 굽는다. (강도만 바뀌면 다시 굽지 않는다)
+    NoiseParams unit = params_;
+    unit.macroAmp = unit.microAmp = unit.ridgeAmp = 1.0f;
+    volume_.bake(table_, unit, previewResolution_);
+    measurePreviewError();
+}
+
+void PlanetGenerator::measurePreviewError() {
+    float nx[kHeightChunk], ny[kHeightChunk], nz[kHeightChunk];
+    float macro[kHeightChunk], micro[kHeightChunk], ridge[kHeightChunk];
+    const float golden = 2.39996323f; // 황금각 (라디안)
+    double sumSq = 0.0;
+    float maxErr = 0.0f;
+
+    for (size_t base = 0; base < kPreviewErrorSamples; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, kPreviewErrorSamples - base);
+
+        // 피보나치 구: 위도는 고르게, 경도는 황금각씩 돌려서 방향을 고르게 퍼뜨린다.
+        for (size_t i = 0; i < m; ++i) {
+            float t = (float(base + i) + 0.5f) / float(kPreviewErrorSamples);
+            float y = 1.0f - 2.0f * t;
+            float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+            float a = golden * float(base + i);
+            nx[i] = r * std::cos(a); ny[i] = y; nz[i] = r * std::sin(a);
+        }
+
+        terrain_layers_batch(table_, params_, nx, ny, nz, macro, micro, ridge, m);
+
+        for (size_t i = 0; i < m; ++i) {
+            TerrainLayers approx = previewLayers(nx[i], ny[i], nz[i]);
+            float exact = combine_height(macro[i], micro[i], ridge[i], ny[i], 1.0f);
+            float preview = combine_height(approx.macro, approx.micro, approx.ridge, ny[i], 1.0f);
+            float err = std::fabs(preview - exact);
+            maxErr = std::max(maxErr, err);
+            sumSq += double(err) * err;
+        }
+    }
+
+    previewMaxErr_ = maxErr;
+    previewRmsErr_ = static_cast<float>(std::sqrt(sumSq / double(kPreviewErrorSamples)));
+    previewErrorStale_ = false;
+}
+
+// 격자는 강도 1로 구워 두었으므로 지금 강도를 곱한다.
+TerrainLayers PlanetGenerator::previewLayers(float x, float y, float z) const {
+    TerrainLayers l = volume_.sample(x, y, z);
+    l.macro *= params_.macroAmp;
+    l.micro *= params_.microAmp;
+    l.ridge *= params_.ridgeAmp;
+    return l;
+}
+
+// --------------------------------------------------------------
+// height
+// --------------------------------------------------------------
+// (x, y, z) 방향을 기준으로 “그 방향에서 얼마나 튀어나오거나 파여 있는지” 계산.
+//
+// 반환값:
+// - 양수 → 기본 반지름보다 튀어나온 부분(육지/산)
+// - 음수 → 기본 반지름보다 파인 부분(바다/계곡)
+// --------------------------------------------------------------
+float PlanetGenerator::height(float x, float y, float z) const {
+    PLANET_PERF_ADD(HeightCalls, 1);
+    PLANET_PERF_ADD(Vertices, 1);
+    PLANET_PERF_CLOCK(clock);
+
+    // 먼저 (x,y,z)를 “단위 벡터”로 만들어 방향만 사용하도록 한다.
+    Vec3 n = normalize(Vec3(x, y, z));
+    PLANET_PERF_LAP(clock, Normalize);
+
+    // ---------- 1~3) 대륙 / 작은 디테일 / 산맥 ----------
+    // - macro : fBm 노이즈로 부드럽고 자연스러운 대륙(산-골짜기) 패턴
+    // - micro : 작은 굴곡(바위, 작은 언덕)
+    // - ridge : ridged fBm으로 봉우리가 날카로운 산맥
+    // 세 층은 terrain_layers(noise.cpp)가 옥타브 루프 하나에서 같이 계산한다.
+    // (층별 시간은 그 안에서 잰다. 미리보기 모드에서는 구워 둔 격자에서 보간)
+    TerrainLayers layers;
+    if (previewEnabled_) {
+        layers = previewLayers(n.x, n.y, n.z);
+        PLANET_PERF_LAP(clock, Layers);
+    } else {
+        layers = terrain_layers(table_, params_, n.x, n.y, n.z);
+        PLANET_PERF_RESET(clock);
+    }
+
+    float mask = continent_mask(layers.macro);
+    PLANET_PERF_LAP(clock, RidgeMask);
+
+    float h = blend_height(layers.macro, layers.micro, layers.ridge, mask, n.y, scale_);
+    PLANET_PERF_LAP(clock, Combine);
+    return h;
+}
+
+// --------------------------------------------------------------
+// heightBatch
+// --------------------------------------------------------------
+// height()를 count개의 점에 대해 한 번에 계산한다.
+// 점마다 정규화한 뒤 heightBatchUnit으로 넘긴다.
+// 결과는 height()를 점마다 부른 것과 같다.
+// --------------------------------------------------------------
+void PlanetGenerator::heightBatch(const float* xs, const float* ys, const float* zs,
+                                  float* out, size_t count) const {
+    float nx[kHeightChunk], ny[kHeightChunk], nz[kHeightChunk];
+
+    for (size_t base = 0; base < count; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, count - base);
+
+        // 방향만 사용하도록 정규화
+        for (size_t i = 0; i < m; ++i) {
+            Vec3 n = normalize(Vec3(xs[base + i], ys[base + i], zs[base + i]));
+            nx[i] = n.x; ny[i] = n.y; nz[i] = n.z;
+        }
+
+        heightBatchUnit(nx, ny, nz, out + base, m);
+    }
+}
+
+// --------------------------------------------------------------
+// heightBatchUnit
+// --------------------------------------------------------------
+// 입력이 이미 단위 방향이라고 보고 정규화 없이 높이를 계산한다.
+// 세 층을 terrain_layers_batch로 계산하므로 SIMD 커널(noise_simd.cpp)이 그대로 적용되고,
+// 입력 배열을 복사하지 않고 kHeightChunk개씩 바로 넘긴다.
+// --------------------------------------------------------------
+void PlanetGenerator::heightBatchUnit(const float* nx, const float* ny, const float* nz,
+                                      float* out, size_t count) const {
+    heightBatchScaled(nx, ny, nz, out, count, scale_);
+}
+
+void PlanetGenerator::heightBatchScaled(const float* nx, const float* ny, const float* nz,
+                                        float* out, size_t count, float scale) const {
+    float macro[kHeightChunk], micro[kHeightChunk], ridge[kHeightChunk], mask[kHeightChunk];
+
+    for (size_t base = 0; base < count; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, count - base);
+        const float* x = nx + base;
+        const float* y = ny + base;
+        const float* z = nz + base;
+        PLANET_PERF_ADD(Vertices, m);
+        PLANET_PERF_CLOCK(clock);
+
+        // 1~3) 세 노이즈 층을 한 번에 계산 (미리보기 모드에서는 격자 보간)
+        if (previewEnabled_) {
+            for (size_t i = 0; i < m; ++i) {
+                TerrainLayers l = previewLayers(x[i], y[i], z[i]);
+                macro[i] = l.macro; micro[i] = l.micro; ridge[i] = l.ridge;
+            }
+            PLANET_PERF_LAP(clock, Layers);
+        } else {
+            // 층별 / 층 외 시간은 terrain_layers_batch 안에서 잰다.
+            terrain_layers_batch(table_, params_, x, y, z, macro, micro, ridge, m);
+            PLANET_PERF_RESET(clock);
+        }
+
+        // 4) 산맥 마스크
+        for (size_t i = 0; i < m; ++i) mask[i] = continent_mask(macro[i]);
+        PLANET_PERF_LAP(clock, RidgeMask);
+
+        // 5~8) 섞기
+        for (size_t i = 0; i < m; ++i) {
+            out[base + i] = blend_height(macro[i], micro[i], ridge[i], mask[i], y[i], scale);
+        }
+        PLANET_PERF_LAP(clock, Combine);
+    }
+}
+
+// --------------------------------------------------------------
+// heightAndNormal
+// --------------------------------------------------------------
+// height()와 같은 높이를 돌려주면서, 그 점의 지형 법선도 normal[0..2]에 쓴다.
+//
+// fbm_d / ridged_fbm_d로 높이의 3D 기울기(g)를 구한 뒤
+// 구의 접평면으로 투영해서(gt = g - (g·n)n) 법선을 만든다.
+//   표면 위치가 P = n * (radius + h(n)) 일 때
+//   법선 = normalize(n - gt / (radius + h))
+// 메쉬 삼각형을 쓰지 않으므로 해상도와 상관없이 정확한 법선이 나온다.
+// (미리보기 모드에서는 격자 보간식의 기울기를 쓴다)
+// --------------------------------------------------------------
+float PlanetGenerator::heightAndNormal(float x, float y, float z, float* normal) const {
+    Vec3 n = normalize(Vec3(x, y, z));
+    return heightAndNormalUnit(n.x, n.y, n.z, normal);
+}
+
+// heightAndNormal과 같지만 (x, y, z)가 이미 단위 방향이라고 보고 정규화를 건너뛴다.
+float PlanetGenerator::heightAndNormalUnit(float x, float y, float z, float* normal) const {
+    float grad[3];
+    float h = terrainUnit(x, y, z, grad) * scale_;
+    Vec3 g(grad[0] * scale_, grad[1] * scale_, grad[2] * scale_);
+    surface_normal(Vec3(x, y, z), g, radius_ + h, normal);
+    return h;
+}
+
+// --------------------------------------------------------------
+// terrainUnit / layerUnit / combineLayers
+// --------------------------------------------------------------
+// scale = 1일 때의 높이와 3D 기울기. (heightAndNormalUnit이 사용)
+// combine_height / combine_height_grad는 마지막에 scale을 곱하기만 하므로
+// 여기에 scale을 곱한 값은 scale을 넣어 바로 계산한 값과 같다.
+//
+// 층 값은 강도를 곱하기 전 값(layerUnit, TerrainLayerCache와 같은 형식)으로 구한 뒤
+// combineLayers에서 강도를 곱해 섞는다. 캐시에서 섞는 shapeLayers도 같은 함수를 쓰므로
+// 캐시를 쓴 결과와 바로 계산한 결과가 같다.
+// --------------------------------------------------------------
+float PlanetGenerator::terrainUnit(float x, float y, float z, float* grad) const {
+    PLANET_PERF_ADD(Vertices, 1);
+    NoiseGrad macro, micro, ridge;
+    if (previewEnabled_) {
+        // 격자는 강도 1로 구워 두었으므로 layerUnit과 같은 형식이다.
+        volume_.sampleGrad(x, y, z, macro, micro, ridge);
+    } else {
+        macro = layerUnit(TerrainLayer::Macro, x, y, z);
+        micro = layerUnit(TerrainLayer::Micro, x, y, z);
+        ridge = layerUnit(TerrainLayer::Ridge, x, y, z);
+    }
+    return combineLayers(macro, micro, ridge, y, grad);
+}
+
+NoiseGrad PlanetGenerator::layerUnit(TerrainLayer layer, float x, float y, float z) const {
+    if (previewEnabled_) {
+        NoiseGrad l[3];
+        volume_.sampleGrad(x, y, z, l[0], l[1], l[2]);
+        return l[static_cast<int>(layer)];
+    }
+
+    // 층 값 = noise(n * freq)  →  기울기 = noise' * freq
+    // 층을 하나씩 계산하므로 층별 시간(PerfStage::Macro / Micro / Ridge)은 여기서 잰다.
+    const NoiseParams& p = params_;
+    PLANET_PERF_CLOCK(clock);
+    float freq;
+    NoiseGrad g;
+    switch (layer) {
+    case TerrainLayer::Macro:
+        freq = p.macroFreq;
+        g = fbm_d(table_, x * freq, y * freq, z * freq, p.macroOctaves, p.lacunarity, p.gain, p.macroBasis);
+        PLANET_PERF_ADD(MacroOctaves, p.macroOctaves);
+        PLANET_PERF_LAP(clock, Macro);
+        break;
+    case TerrainLayer::Micro:
+        freq = p.microFreq;
+        g = fbm_d(table_, x * freq, y * freq, z * freq, p.microOctaves, p.lacunarity, p.gain, p.microBasis);
+        PLANET_PERF_ADD(MicroOctaves, p.microOctaves);
+        PLANET_PERF_LAP(clock, Micro);
+        break;
+    default:
+        freq = p.ridgeFreq;
+        g = ridged_fbm_d(table_, x * freq, y * freq, z * freq, p.ridgeOctaves, p.lacunarity, p.gain, p.ridgeBasis);
+        PLANET_PERF_ADD(RidgeOctaves, p.ridgeOctaves);
+        PLANET_PERF_LAP(clock, Ridge);
+        break;
+    }
+    return { g.value, g.dx * freq, g.dy * freq, g.dz * freq };
+}
+
+float PlanetGenerator::combineLayers(const NoiseGrad& macro, const NoiseGrad& micro, const NoiseGrad& ridge,
+                                     float ny, float* grad) const {
+    const NoiseParams& p = params_;
+    float macroV = macro.value * p.macroAmp;
+    float microV = micro.value * p.microAmp;
+    float ridgeV = ridge.value * p.ridgeAmp;
+    Vec3 gMacro(macro.dx * p.macroAmp, macro.dy * p.macroAmp, macro.dz * p.macroAmp);
+    Vec3 gMicro(micro.dx * p.microAmp, micro.dy * p.microAmp, micro.dz * p.microAmp);
+    Vec3 gRidge(ridge.dx * p.ridgeAmp, ridge.dy * p.ridgeAmp, ridge.dz * p.ridgeAmp);
+
+    Vec3 g = combine_height_grad(macroV, gMacro, gMicro, ridgeV, gRidge, ny, 1.0f);
+    grad[0] = g.x;
+    grad[1] = g.y;
+    grad[2] = g.z;
+    return combine_height(macroV, microV, ridgeV, ny, 1.0f);
+}
+
+// --------------------------------------------------------------
+// layerBatch
+// --------------------------------------------------------------
+// layerUnit의 배치 버전. m(kHeightChunk 이하)개 점의 층 하나를
+// fbm_d_batch / ridged_fbm_d_batch로 계산해 v / dx / dy / dz에 쓴다.
+// (강도를 곱하기 전, 기울기에는 freq를 곱한 값. layerUnit을 점마다 부른 것과 같다)
+// --------------------------------------------------------------
+void PlanetGenerator::layerBatch(TerrainLayer layer, const float* xs, const float* ys, const float* zs, size_t m,
+                                 float* v, float* dx, float* dy, float* dz) const {
+    const NoiseParams& p = params_;
+    float freq;
+    int octaves;
+    NoiseBasis basis;
+    switch (layer) {
+    case TerrainLayer::Macro:
+        freq = p.macroFreq; octaves = p.macroOctaves; basis = p.macroBasis;
+        PLANET_PERF_ADD(MacroOctaves, m * octaves);
+        break;
+    case TerrainLayer::Micro:
+        freq = p.microFreq; octaves = p.microOctaves; basis = p.microBasis;
+        PLANET_PERF_ADD(MicroOctaves, m * octaves);
+        break;
+    default:
+        freq = p.ridgeFreq; octaves = p.ridgeOctaves; basis = p.ridgeBasis;
+        PLANET_PERF_ADD(RidgeOctaves, m * octaves);
+        break;
+    }
+
+    // 층 값 = noise(n * freq)  →  기울기 = noise' * freq
+    // 노이즈 시간은 층별 단계(PerfStage::Macro / Micro / Ridge)에, 좌표 준비는 Layers에 더한다.
+    PLANET_PERF_CLOCK(clock);
+    float sx[kHeightChunk], sy[kHeightChunk], sz[kHeightChunk];
+    for (size_t i = 0; i < m; ++i) {
+        sx[i] = xs[i] * freq;
+        sy[i] = ys[i] * freq;
+        sz[i] = zs[i] * freq;
+    }
+    PLANET_PERF_LAP(clock, Layers);
+    if (layer == TerrainLayer::Ridge) {
+        ridged_fbm_d_batch(table_, sx, sy, sz, v, dx, dy, dz, m, octaves, p.lacunarity, p.gain, basis);
+        PLANET_PERF_LAP(clock, Ridge);
+    } else {
+        fbm_d_batch(table_, sx, sy, sz, v, dx, dy, dz, m, octaves, p.lacunarity, p.gain, basis);
+        if (layer == TerrainLayer::Macro) PLANET_PERF_LAP(clock, Macro);
+        else PLANET_PERF_LAP(clock, Micro);
+    }
+    for (size_t i = 0; i < m; ++i) {
+        dx[i] *= freq;
+        dy[i] *= freq;
+        dz[i] *= freq;
+    }
+    PLANET_PERF_LAP(clock, Layers);
+}
+
+// --------------------------------------------------------------
+// displaceUnitWithNormals
+// --------------------------------------------------------------
+// 단위 방향 count개의 위치(out: [x, y, z, ...])와 법선(normals)을 계산한다.
+// kHeightChunk개씩 세 층을 layerBatch로 구한 뒤 점마다 combineLayers로 섞으므로
+// heightAndNormalUnit을 점마다 부른 것과 같은 값이 나온다.
+// (미리보기 모드에서는 점마다 격자에서 읽는다)
+// --------------------------------------------------------------
+void PlanetGenerator::displaceUnitWithNormals(const float* nx, const float* ny, const float* nz,
+                                              float* out, float* normals, size_t count) const {
+    float v[3][kHeightChunk], dx[3][kHeightChunk], dy[3][kHeightChunk], dz[3][kHeightChunk];
+
+    for (size_t base = 0; base < count; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, count - base);
+        const float* x = nx + base;
+        const float* y = ny + base;
+        const float* z = nz + base;
+        PLANET_PERF_ADD(Vertices, m);
+        PLANET_PERF_CLOCK(clock);
+
+        if (previewEnabled_) {
+            for (size_t i = 0; i < m; ++i) {
+                NoiseGrad l[3];
+                volume_.sampleGrad(x[i], y[i], z[i], l[0], l[1], l[2]);
+                for (int k = 0; k < 3; ++k) {
+                    v[k][i] = l[k].value; dx[k][i] = l[k].dx; dy[k][i] = l[k].dy; dz[k][i] = l[k].dz;
+                }
+            }
+            PLANET_PERF_LAP(clock, Layers);
+        } else {
+            for (int k = 0; k < 3; ++k) layerBatch(static_cast<TerrainLayer>(k), x, y, z, m, v[k], dx[k], dy[k], dz[k]);
+            PLANET_PERF_RESET(clock);
+        }
+
+        for (size_t i = 0; i < m; ++i) {
+            float grad[3];
+            float h = combineLayers({ v[0][i], dx[0][i], dy[0][i], dz[0][i] }, { v[1][i], dx[1][i], dy[1][i], dz[1][i] },
+                                    { v[2][i], dx[2][i], dy[2][i], dz[2][i] }, y[i], grad) * scale_;
+            size_t idx = (base + i) * 3;
+            float r = radius_ + h;
+            out[idx]     = x[i] * r;
+            out[idx + 1] = y[i] * r;
+            out[idx + 2] = z[i] * r;
+            surface_normal(Vec3(x[i], y[i], z[i]), Vec3(grad[0] * scale_, grad[1] * scale_, grad[2] * scale_),
+                           r, normals + idx);
+        }
+        PLANET_PERF_LAP(clock, Combine);
+    }
+}
+
+/**
+ * @brief 정점 배열(Buffer)을 받아 한 번에 높이를 적용하는 함수 (Batch Processing)
+ * @param buffer : [x, y, z, x, y, z, ...] 형태의 1차원 배열 포인터
+ * @param vertexCount : 정점(점)의 개수
+ *
+ * 정점들을 kHeightChunk개씩 끊어서 좌표를 x/y/z 배열로 나눈 뒤
+ * heightBatchUnit으로 높이를 한 번에 계산한다.
+ */
+void PlanetGenerator::applyDisplacement(float* buffer, size_t vertexCount) const {
+    float nx[kHeightChunk], ny[kHeightChunk], nz[kHeightChunk], h[kHeightChunk];
+
+    for (size_t base = 0; base < vertexCount; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, vertexCount - base);
+        PLANET_PERF_CLOCK(clock);
+
+        // 1. 방향(단위 벡터) 구하기 (입력값이 찌그러져 있어도 상관없음)
+        for (size_t i = 0; i < m; ++i) {
+            size_t idx = (base + i) * 3; // x, y, z가 연속되어 있으므로 3칸씩 점프
+            Vec3 n = normalize(Vec3(buffer[idx], buffer[idx + 1], buffer[idx + 2]));
+            nx[i] = n.x; ny[i] = n.y; nz[i] = n.z;
+        }
+        PLANET_PERF_LAP(clock, Normalize);
+
+        // 2. 높이 계산 (배치, 이미 정규화했으므로 Unit 버전, 단계 시간은 안에서 잰다)
+        heightBatchUnit(nx, ny, nz, h, m);
+        PLANET_PERF_RESET(clock);
+
+        // 3. 최종 위치 계산 (반지름 + 높이) 후 메모리에 직접 덮어쓰기 (JS 쪽 배열이 바뀜)
+        for (size_t i = 0; i < m; ++i) {
+            size_t idx = (base + i) * 3;
+            float r = radius_ + h[i];
+            buffer[idx]     = nx[i] * r;
+            buffer[idx + 1] = ny[i] * r;
+            buffer[idx + 2] = nz[i] * r;
+        }
+        PLANET_PERF_LAP(clock, WriteBack);
+    }
+}
+
+/**
+ * @brief applyDisplacement와 같은 위치를 계산하면서 정점 법선도 함께 채운다.
+ * @param buffer : [x, y, z, ...] 정점 배열 (결과 위치로 덮어씀)
+ * @param normals : [nx, ny, nz, ...] 법선을 쓸 배열 (buffer와 같은 길이)
+ * @param vertexCount : 정점(점)의 개수
+ *
+ * 법선을 높이의 기울기로 바로 구하므로 JS 쪽의 computeVertexNormals가 필요 없다.
+ * kHeightChunk개씩 방향을 x/y/z 배열로 나눈 뒤 displaceUnitWithNormals로 넘긴다.
+ */
+void PlanetGenerator::applyDisplacementWithNormals(float* buffer, float* normals, size_t vertexCount) const {
+    float nx[kHeightChunk], ny[kHeightChunk], nz[kHeightChunk];
+
+    for (size_t base = 0; base < vertexCount; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, vertexCount - base);
+        PLANET_PERF_CLOCK(clock);
+
+        for (size_t i = 0; i < m; ++i) {
+            size_t idx = (base + i) * 3;
+            Vec3 n = normalize(Vec3(buffer[idx], buffer[idx + 1], buffer[idx + 2]));
+            nx[i] = n.x; ny[i] = n.y; nz[i] = n.z;
+        }
+        PLANET_PERF_LAP(clock, Normalize);
+
+        // 방향을 따로 복사해 두었으므로 결과를 buffer에 바로 덮어써도 된다.
+        displaceUnitWithNormals(nx, ny, nz, buffer + base * 3, normals + base * 3, m);
+    }
+}
+
+/**
+ * @brief SoA(축별 배열) 버전의 applyDisplacement (제자리)
+ * @param xs, ys, zs : 단위 방향 벡터의 x / y / z 배열 (결과 위치로 덮어씀)
+ * @param count : 정점(점)의 개수
+ *
+ * 입력을 정규화하지도, x/y/z로 나누지도 않고 바로 heightBatchUnit에 넘긴다.
+ */
+void PlanetGenerator::applyDisplacementSoA(float* xs, float* ys, float* zs, size_t count) const {
+    float h[kHeightChunk];
+
+    for (size_t base = 0; base < count; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, count - base);
+        heightBatchUnit(xs + base, ys + base, zs + base, h, m);
+        PLANET_PERF_CLOCK(clock);
+
+        for (size_t i = 0; i < m; ++i) {
+            float r = radius_ + h[i];
+            xs[base + i] *= r;
+            ys[base + i] *= r;
+            zs[base + i] *= r;
+        }
+        PLANET_PERF_LAP(clock, WriteBack);
+    }
+}
+
+/**
+ * @brief SoA 방향 배열을 읽기만 하고, 결과 위치를 따로 쓰는 버전
+ * @param xs, ys, zs : 단위 방향 벡터의 x / y / z 배열 (바뀌지 않음)
+ * @param out : [x, y, z, ...] 결과 위치 배열 (Three.js position 속성과 같은 배치)
+ * @param normals : [nx, ny, nz, ...] 법선 결과 배열 (nullptr이면 계산하지 않음)
+ * @param count : 정점(점)의 개수
+ *
+ * 방향 배열이 바뀌지 않으므로 메쉬마다 한 번만 만들어 두고 재생성 때마다 다시 쓸 수 있다.
+ */
+void PlanetGenerator::applyDisplacementSoA(const float* xs, const float* ys, const float* zs,
+                                           float* out, float* normals, size_t count) const {
+    if (normals) {
+        displaceUnitWithNormals(xs, ys, zs, out, normals, count);
+        return;
+    }
+
+    float h[kHeightChunk];
+    for (size_t base = 0; base < count; base += kHeightChunk) {
+        size_t m = std::min(kHeightChunk, count - base);
+        heightBatchUnit(xs + base, ys + base, zs + base, h, m);
+        PLANET_PERF_CLOCK(clock);
+
+        for (size_t i = 0; i < m; ++i) {
+            size_t idx = (base + i) * 3;
+            float r = radius_ + h[i];
+            out[idx]     = xs[base + i] * r;
+            out[idx + 1] = ys[base + i] * r;
+            out[idx + 2] = zs[base + i] * r;
+        }
+        PLANET_PERF_LAP(clock, WriteBack);
+    }
+}
+
+// --------------------------------------------------------------
+// classifyColors
+// --------------------------------------------------------------
+// 원점에서의 거리가 radius * landHeight보다 크면 육지, 아니면 바다.
+// sqrt 없이 거리의 제곱끼리 비교한다.
+// --------------------------------------------------------------
+void PlanetGenerator::classifyColors(const float* positions, uint32_t* colors, size_t count,
+                                     const VertexPalette& palette) const {
+    float limit = radius_ * palette.landHeight;
+    float limitSq = limit * limit;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* p = positions + i * 3;
+        float magnitudeSq = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+        colors[i] = magnitudeSq > limitSq ? palette.land : palette.ocean;
+    }
+}
+
+// --------------------------------------------------------------
+// staleLayers / sampleLayers / markLayers / shapeLayers
+// --------------------------------------------------------------
+// 층별 지형 캐시를 만들고(sample), 강도 / scale / radius로 섞는다(shape).
+// shape는 정점마다 세 층을 섞고(곱셈-덧셈 몇 번) 법선을 정규화할 뿐이라
+// 강도 / scale / radius를 바꿀 때는 노이즈 옥타브를 하나도 계산하지 않고,
+// micro만 바꾸면 micro 층만 다시 계산한다.
+// --------------------------------------------------------------
+int PlanetGenerator::staleLayers(const TerrainLayerCache& cache) const {
+    int layers = 0;
+    for (int l = 0; l < 3; ++l) {
+        if (cache.revisions[l] != layerRevisions_[l]) layers |= 1 << l;
+    }
+    return layers;
+}
+
+// 층마다 kHeightChunk개씩 layerBatch로 계산한다. (layerUnit을 점마다 부른 것과 같은 값)
+// 미리보기 모드에서는 격자에서 읽으므로 점마다 layerUnit을 부른다.
+void PlanetGenerator::sampleLayers(int layers, const float* xs, const float* ys, const float* zs,
+                                   TerrainLayerCache& cache, size_t begin, size_t end) const {
+    PLANET_PERF_CLOCK(clock);
+    if (previewEnabled_) {
+        for (size_t i = begin; i < end; ++i) {
+            for (int l = 0; l < 3; ++l) {
+                if (!(layers & (1 << l))) continue;
+                NoiseGrad g = layerUnit(static_cast<TerrainLayer>(l), xs[i], ys[i], zs[i]);
+                float* out = cache.layers[l].data() + i * 4;
+                out[0] = g.value;
+                out[1] = g.dx;
+                out[2] = g.dy;
+                out[3] = g.dz;
+            }
+        }
+        PLANET_PERF_LAP(clock, Layers);
+        return;
+    }
+
+    // 층별 시간은 layerBatch 안에서 재고, 캐시에 옮겨 쓰는 시간은 Layers에 더한다.
+    float v[kHeightChunk], dx[kHeightChunk], dy[kHeightChunk], dz[kHeightChunk];
+
+    for (int l = 0; l < 3; ++l) {
+        if (!(layers & (1 << l))) continue;
+        for (size_t base = begin; base < end; base += kHeightChunk) {
+            size_t m = std::min(kHeightChunk, end - base);
+            layerBatch(static_cast<TerrainLayer>(l), xs + base, ys + base, zs + base, m, v, dx, dy, dz);
+            PLANET_PERF_RESET(clock);
+            float* out = cache.layers[l].data() + base * 4;
+            for (size_t i = 0; i < m; ++i) {
+                out[i * 4]     = v[i];
+                out[i * 4 + 1] = dx[i];
+                out[i * 4 + 2] = dy[i];
+                out[i * 4 + 3] = dz[i];
+            }
+            PLANET_PERF_LAP(clock, Layers);
+        }
+    }
+}
+
+void PlanetGenerator::markLayers(int layers, TerrainLayerCache& cache) const {
+    for (int l = 0; l < 3; ++l) {
+        if (layers & (1 << l)) cache.revisions[l] = layerRevisions_[l];
+    }
+}
+
+void PlanetGenerator::shapeLayers(const float* xs, const float* ys, const float* zs, const TerrainLayerCache& cache,
+                                  float* out, float* normals, size_t begin, size_t end) const {
+    const float* macro = cache.layers[0].data();
+    const float* micro = cache.layers[1].data();
+    const float* ridge = cache.layers[2].data();
+    PLANET_PERF_ADD(Vertices, end - begin);
+    PLANET_PERF_CLOCK(clock);
+
+    for (size_t i = begin; i < end; ++i) {
+        const float* m = macro + i * 4;
+        const float* u = micro + i * 4;
+        const float* r = ridge + i * 4;
+        float grad[3];
+        float h = combineLayers({ m[0], m[1], m[2], m[3] }, { u[0], u[1], u[2], u[3] },
+                                { r[0], r[1], r[2], r[3] }, ys[i], grad) * scale_;
+
+        size_t idx = i * 3;
+        float radius = radius_ + h;
+        out[idx]     = xs[i] * radius;
+        out[idx + 1] = ys[i] * radius;
+        out[idx + 2] = zs[i] * radius;
+        if (normals) {
+            surface_normal(Vec3(xs[i], ys[i], zs[i]), Vec3(grad[0] * scale_, grad[1] * scale_, grad[2] * scale_),
+                           radius, normals + idx);
+        }
+    }
+    PLANET_PERF_LAP(clock, Combine);
+}
+
+void PlanetGenerator::sampleTerrainSoA(const float* xs, const float* ys, const float* zs,
+                                       float* heights, size_t count) const {
+    heightBatchScaled(xs, ys, zs, heights, count, 1.0f);
+}
+
+// --------------------------------------------------------------
+// applyDisplacement / applyDisplacementWithNormals / applyDisplacementSoA (멀티스레드)
+// --------------------------------------------------------------
+// 조각마다 한 스레드 버전을 그대로 부른다. (height 계산 함수들은 const라서 동시에 불러도 안전)
+// --------------------------------------------------------------
+void PlanetGenerator::applyDisplacement(float* buffer, size_t vertexCount, ThreadPool& pool) const {
+    pool.parallelFor(vertexCount, kParallelChunk, [&](size_t begin, size_t end) {
+        applyDisplacement(buffer + begin * 3, end - begin);
+    });
+}
+
+void PlanetGenerator::applyDisplacementWithNormals(float* buffer, float* normals, size_t vertexCount,
+                                                   ThreadPool& pool) const {
+    pool.parallelFor(vertexCount, kParallelChunk, [&](size_t begin, size_t end) {
+        applyDisplacementWithNormals(buffer + begin * 3, normals + begin * 3, end - begin);
+    });
+}
+
+void PlanetGenerator::applyDisplacementSoA(float* xs, float* ys, float* zs, size_t count, ThreadPool& pool) const {
+    pool.parallelFor(count, kParallelChunk, [&](size_t begin, size_t end) {
+        applyDisplacementSoA(xs + begin, ys + begin, zs + begin, end - begin);
+    });
+}
+
+void PlanetGenerator::applyDisplacementSoA(const float* xs, const float* ys, const float* zs,
+                                           float* out, float* normals, size_t count, ThreadPool& pool) const {
+    pool.parallelFor(count, kParallelChunk, [&](size_t begin, size_t end) {
+        applyDisplacementSoA(xs + begin, ys + begin, zs + begin, out + begin * 3,
+                             normals ? normals + begin * 3 : nullptr, end - begin);
+    });
+}
 
 // ----------------------------------------------
-// noise.cpp 안에 구현된 노이즈 관련 함수들의 선언부
-// (여기서는 "이런 함수가 있다"라고만 알려주는 역할)
+// 기본 생성기 / 메쉬 / LOD 함수가 함께 쓰는 스레드 풀 (set_thread_count로 크기 조절, 기본 1)
+// planet_* 핸들 함수는 이 풀을 쓰지 않는다.
 // ----------------------------------------------
-void initNoise(uint32_t seed); // 시드(seed)를 기반으로 노이즈용 테이블 초기화
-float perlin(float x, float y, float z);
-float fbm(float x, float y, float z, int octaves, float lacunarity, float gain);
-float ridged_fbm(float x, float y, float z, int octaves, float lacunarity, float gain);
+static ThreadPool& sharedPool() {
+    static ThreadPool pool(1);
+    return pool;
+}
 
 // ----------------------------------------------
-// 노이즈 파라미터 구조체
-// (행성의 지형을 어떤 스타일로 만들지 결정하는 설정 값 묶음)
+// 모듈 전체에서 공유하는 기본 생성기
+// (예전 API인 init_planet / get_height / apply_displacement_batch 가 사용)
 // ----------------------------------------------
-struct NoiseParams {
-    float macroFreq;      // 대륙 크기를 결정하는 노이즈 주파수
-    int   macroOctaves;   // 대륙 노이즈의 반복(옥타브) 수
-    float macroAmp;       // 대륙 높이의 강도(얼마나 솟아오르는지)
-
-    float microFreq;      // 작은 지형들(작은 산/골짜기)용 주파수
-    int   microOctaves;   // micro 노이즈 옥타브
-    float microAmp;       // micro 디테일 강도
+static PlanetGenerator GLOBAL_PLANET;
 
-    float ridgeFreq;      // 산맥 생성 노이즈의 주파수
-    int   ridgeOctaves;   // ridge 노이즈 옥타브
-    float ridgeAmp;       // 산맥의 강도
+// 현재 메쉬의 정점 버퍼 (mesh_* 함수들이 사용, JS가 HEAPF32 / HEAPU8 뷰로 직접 읽고 씀)
+static MeshBuffers GLOBAL_MESH;
 
-    float lacunarity;     // 옥타브 간 주파수 증가율
-    float gain;           // 옥타브 간 강도 감소율
-};
+// 정점 색 팔레트 (set_vertex_palette로 바꿈, 기본값은 main.js의 바다 / 육지 색)
+static VertexPalette GLOBAL_PALETTE = { 0xffb45f1au, 0xff48a348u, 1.1f };
 
-// NoiseParams를 시드로부터 자동 생성하는 함수(노이즈 스타일 결정)
-NoiseParams generateNoiseParams(uint32_t seed);
+// 카메라에 따라 패치를 나눠 그리는 LOD 지형 (lod_* 함수들이 사용, 기본 생성기 / 팔레트를 씀)
+static TerrainLod GLOBAL_LOD;
 
-// ----------------------------------------------
-// 행성 생성기 전체에서 유지하는 전역 상태 변수들
-// (사용자가 seed/scale/radius를 바꾸면 값이 업데이트됨)
-// ----------------------------------------------
 extern "C" {
-    static NoiseParams PARAMS;   // 행성 지형 스타일 전체
-    static uint32_t GLOBAL_SEED = 0;  
-    static float GLOBAL_SCALE = 1.0f;    // 지형 전체 높이 배율
-    static float GLOBAL_RADIUS = 1.0f;   // 기본 행성 반지름
-
     // --------------------------------------------------------------
     // init_planet
     // --------------------------------------------------------------
-    // 행성 생성기를 초기화하는 함수.
+    // 기본 생성기를 초기화하는 함수.
     // (JS → WASM에서 첫 실행 시 반드시 호출해야 함)
     //
-    // seed   : 행성의 지형이 결정되는 “유전 암호” 같은 역할
-    // scale  : 산의 높이, 골짜기 깊이 등 전체 높이를 얼마나 키울지
-    // radius : 행성의 기본 크기(지름이 아니라 반지름!)
-    //
-    // 이 함수가 호출되어야:
-    // 1) 노이즈 테이블이 초기화되고
-    // 2) 노이즈 파라미터(대륙/산맥 스타일)가 시드 기반으로 자동 생성되고
-    // 3) get_height(), get_final_position() 함수가 제대로 동작함
+    // 이 함수가 호출되어야 get_height(), apply_displacement_batch()가
+    // 원하는 seed / scale / radius로 동작한다.
     // --------------------------------------------------------------
     void init_planet(int seed, float scale, float radius) {
-        GLOBAL_SEED = static_cast<uint32_t>(seed);
-        GLOBAL_SCALE = scale;
-        GLOBAL_RADIUS = radius;
-
-        // 노이즈 엔진 초기화(시드 기반으로 랜덤 테이블 생성)
-        initNoise(GLOBAL_SEED);
-
-        // 시드를 기반으로 노이즈 파라미터(지형 스타일) 자동 생성
-        PARAMS = generateNoiseParams(GLOBAL_SEED);
+        GLOBAL_PLANET.init(static_cast<uint32_t>(seed), scale, radius);
     }
 
     // --------------------------------------------------------------
     // get_height
     // --------------------------------------------------------------
-    // (x, y, z) 방향을 기준으로 “그 방향에서 얼마나 튀어나오거나 파여 있는지” 계산.
-    //
-    // 반환값:
-    // - 양수 → 기본 반지름보다 튀어나온 부분(육지/산)
-    // - 음수 → 기본 반지름보다 파인 부분(바다/계곡)
+    // 기본 생성기로 (x, y, z) 방향의 높이를 계산한다.
     //
     // ※ Three.js에서는 이 값을 받아서 구 형태의 버텍스를 밀어내며 행성을 만든다.
     // --------------------------------------------------------------
     float get_height(float x, float y, float z) {
-        // 먼저 (x,y,z)를 “단위 벡터”로 만들어 방향만 사용하도록 한다.
-        Vec3 n = normalize(Vec3(x, y, z));
-
-        // ---------- 1) 대륙 모양 결정 ----------
-        // fBm 노이즈는 여러 주파수의 Perlin 노이즈를 섞어서
-        // 부드럽고 자연스러운 산-골짜기 패턴을 만든다.
-        float macro = fbm(n.x * PARAMS.macroFreq,
-                          n.y * PARAMS.macroFreq,
-                          n.z * PARAMS.macroFreq,
-                          PARAMS.macroOctaves,
-                          PARAMS.lacunarity,
-                          PARAMS.gain) * PARAMS.macroAmp;
-
-        // ---------- 2) 작은 지형 디테일 ----------
-        // micro 노이즈는 작은 굴곡(바위, 작은 언덕)을 추가한다.
-        float micro = fbm(n.x * PARAMS.microFreq,
-                          n.y * PARAMS.microFreq,
-                          n.z * PARAMS.microFreq,
-                          PARAMS.microOctaves,
-                          PARAMS.lacunarity,
-                          PARAMS.gain) * PARAMS.microAmp;
-
-        // ---------- 3) 날카로운 산맥(능선) ----------
-        // ridged_fbm은 봉우리가 날카로운 산맥을 만들기 적합한 노이즈.
-        float ridge = ridged_fbm(n.x * PARAMS.ridgeFreq,
-                                 n.y * PARAMS.ridgeFreq,
-                                 n.z * PARAMS.ridgeFreq,
-                                 PARAMS.ridgeOctaves,
-                                 PARAMS.lacunarity,
-                                 PARAMS.gain) * PARAMS.ridgeAmp;
-
-        // ---------- 4) 육지 마스크 ----------
-        // macro가 어느 정도 이상일 때만 산맥을 살아 있게 하고,
-        // 바다 근처에서는 산맥 효과가 약하도록 만든다.
-        float continentMask = smoothstep(0.35f, 0.65f, macro);
-
-        // ---------- 5) 극지방 효과 ----------
-        // y축이 위아래 방향이라, y가 ±1에 가까울수록 북/남극.
-        // 극지에는 약간의 얼음층/평원 같은 효과를 추가.
-        float lat = std::fabs(n.y);
-        float polarBoost = smoothstep(0.6f, 0.95f, lat) * 0.08f;
-
-        // ---------- 6) 최종 높이 계산 ----------
-        // 각 요소를 비율로 섞어서 전체 지형을 구성한다.
-        float height = macro * 0.65f
-                     + micro * 0.30f
-                     + ridge * continentMask * 0.6f
-                     + polarBoost;
-
-        // ---------- 7) 바다 수위 조절 ----------
-        // seaLevel 값이 클수록 물이 많아지고 육지가 줄어든다.
-        const float seaLevel = 0.45f;
-        height -= seaLevel;
-
-        // ---------- 8) 전체 높이 배율 ----------
-        // 사용자가 입력한 scale 값에 따라 지형의 높낮이를 조절
-        height *= GLOBAL_SCALE;
-
-        return height;
+        return GLOBAL_PLANET.height(x, y, z);
     }
 
     /**
-     * @brief 정점 배열(Buffer)을 받아 한 번에 높이를 적용하는 함수 (Batch Processing)
+     * @brief 기본 생성기로 정점 배열에 높이를 한 번에 적용 (Batch Processing)
      * @param buffer : [x, y, z, x, y, z, ...] 형태의 1차원 배열 포인터
      * @param vertexCount : 정점(점)의 개수
      */
     void apply_displacement_batch(float* buffer, int vertexCount) {
-        for (int i = 0; i < vertexCount; ++i) {
-            int idx = i * 3; // x, y, z가 연속되어 있으므로 3칸씩 점프
+        if (vertexCount <= 0) return;
+        GLOBAL_PLANET.applyDisplacement(buffer, static_cast<size_t>(vertexCount), sharedPool());
+    }
+
+    // --------------------------------------------------------------
+    // get_height_and_normal
+    // --------------------------------------------------------------
+    // get_height와 같은 높이를 돌려주고, 지형 법선을 normalOut[0..2]에 쓴다.
+    // --------------------------------------------------------------
+    float get_height_and_normal(float x, float y, float z, float* normalOut) {
+        return GLOBAL_PLANET.heightAndNormal(x, y, z, normalOut);
+    }
+
+    /**
+     * @brief apply_displacement_batch + 정점 법선 계산을 한 번에
+     * @param buffer : [x, y, z, ...] 정점 배열 (결과 위치로 덮어씀)
+     * @param normals : [nx, ny, nz, ...] 법선 결과 배열
+     * @param vertexCount : 정점(점)의 개수
+     */
+    void apply_displacement_normals_batch(float* buffer, float* normals, int vertexCount) {
+        if (vertexCount <= 0) return;
+        GLOBAL_PLANET.applyDisplacementWithNormals(buffer, normals, static_cast<size_t>(vertexCount), sharedPool());
+    }
+
+    // --------------------------------------------------------------
+    // apply_displacement_soa / apply_displacement_soa_to
+    // --------------------------------------------------------------
+    // xs / ys / zs : 단위 방향 벡터의 축별 배열 (정규화하지 않으므로 길이가 1이어야 함)
+    //
+    // apply_displacement_soa    : xs / ys / zs를 표면 위치로 덮어쓴다.
+    // apply_displacement_soa_to : 방향 배열은 그대로 두고
+    //                             out에 [x, y, z, ...] 위치를, normals(0이 아니면)에 법선을 쓴다.
+    //                             방향 배열을 WASM 메모리에 한 번 올려 두고 계속 다시 쓸 수 있다.
+    // --------------------------------------------------------------
+    void apply_displacement_soa(float* xs, float* ys, float* zs, int vertexCount) {
+        if (vertexCount <= 0) return;
+        GLOBAL_PLANET.applyDisplacementSoA(xs, ys, zs, static_cast<size_t>(vertexCount), sharedPool());
+    }
+
+    void apply_displacement_soa_to(const float* xs, const float* ys, const float* zs,
+                                   float* out, float* normals, int vertexCount) {
+        if (vertexCount <= 0) return;
+        GLOBAL_PLANET.applyDisplacementSoA(xs, ys, zs, out, normals, static_cast<size_t>(vertexCount), sharedPool());
+    }
+
+    // --------------------------------------------------------------
+    // mesh_* : 모듈이 들고 있는 메쉬 버퍼
+    // --------------------------------------------------------------
+    // 1) mesh_resize(n)            : 정점 n개짜리 버퍼를 만든다. (이전 포인터는 무효)
+    // 2) mesh_positions()에 변형 전 구의 위치를 쓰고 mesh_capture_directions()로 방향을 저장
+    // 3) 재생성마다 mesh_displace() : 저장한 방향으로 위치 / 법선을 다시 계산
+    //
+    // 포인터는 바이트 주소이고, 길이는 모두 mesh_vertex_count() * 3 (float)이다.
+    // (directions는 xs | ys | zs 순서의 SoA)
+    // --------------------------------------------------------------
+    void mesh_resize(int vertexCount) {
+        GLOBAL_MESH.resize(vertexCount > 0 ? static_cast<size_t>(vertexCount) : 0);
+    }
+
+    int mesh_vertex_count() {
+        return static_cast<int>(GLOBAL_MESH.vertexCount());
+    }
 
-            float x = buffer[idx];
-            float y = buffer[idx + 1];
-            float z = buffer[idx + 2];
+    float* mesh_directions() { return GLOBAL_MESH.directions(); }
+    float* mesh_positions() { return GLOBAL_MESH.positions(); }
+    float* mesh_normals() { return GLOBAL_MESH.normals(); }
+    uint32_t* mesh_colors() { return GLOBAL_MESH.colors(); }
 
-            // 1. 높이 계산 (기존 로직 재사용)
-            // (주의: 내부적으로 normalize를 하므로 입력값이 찌그러져 있어도 상관없음)
-            Vec3 n = normalize(Vec3(x, y, z));
-            float h = get_height(n.x, n.y, n.z);
+    void mesh_capture_directions() {
+        GLOBAL_MESH.captureDirections();
+    }
+
+    // --------------------------------------------------------------
+    // mesh_generate_sphere
+    // --------------------------------------------------------------
+    // mesh_resize + 위치 쓰기 + mesh_capture_directions 대신, 정점 간격이 고른 단위 구를
+    // 모듈 안에서 바로 만든다. (kind : 0 = Icosphere, 1 = CubeSphere)
+    // 정점 수는 targetVertices 이하에서 가장 촘촘하게 정해지고, 실제 정점 수를 돌려준다.
+    // 삼각형은 mesh_indices()(mesh_index_count()개, Uint32),
+    // 타일 범위는 mesh_tile_offsets()(mesh_tile_count() + 1개)로 읽는다.
+    // --------------------------------------------------------------
+    int mesh_generate_sphere(int kind, int targetVertices, int tilesPerEdge) {
+        SphereMeshKind meshKind = kind == 1 ? SphereMeshKind::CubeSphere : SphereMeshKind::Icosphere;
+        GLOBAL_MESH.generateSphere(meshKind, targetVertices > 0 ? static_cast<size_t>(targetVertices) : 0,
+                                   tilesPerEdge);
+        return static_cast<int>(GLOBAL_MESH.vertexCount());
+    }
+
+    int mesh_index_count() {
+        return static_cast<int>(GLOBAL_MESH.indexCount());
+    }
+
+    uint32_t* mesh_indices() { return GLOBAL_MESH.indices(); }
+
+    int mesh_tile_count() {
+        return static_cast<int>(GLOBAL_MESH.tileCount());
+    }
+
+    uint32_t* mesh_tile_offsets() { return GLOBAL_MESH.tileOffsets(); }
+
+    // 위치 / 법선을 계산한 조각을 바로 이어서 색으로 분류한다. (조각이 캐시에 있을 때)
+    // 메쉬의 층별 지형 캐시 중 모양이 바뀐 층만 노이즈를 다시 계산하고, 세 층을 지금
+    // 강도 / scale / radius로 다시 섞는다. 다시 계산한 층 비트(1 << layer)를 돌려준다. (0이면 섞기만)
+    int mesh_displace() {
+        size_t n = GLOBAL_MESH.vertexCount();
+        if (n == 0) return 0;
+        const float* xs = GLOBAL_MESH.directions();
+        const float* ys = xs + n;
+        const float* zs = ys + n;
+        TerrainLayerCache& cache = GLOBAL_MESH.layerCache();
+        float* positions = GLOBAL_MESH.positions();
+        float* normals = GLOBAL_MESH.normals();
+        uint32_t* colors = GLOBAL_MESH.colors();
+        const int stale = GLOBAL_PLANET.staleLayers(cache);
+
+        sharedPool().parallelFor(n, kParallelChunk, [&](size_t begin, size_t end) {
+            if (stale) GLOBAL_PLANET.sampleLayers(stale, xs, ys, zs, cache, begin, end);
+            GLOBAL_PLANET.shapeLayers(xs, ys, zs, cache, positions, normals, begin, end);
+            GLOBAL_PLANET.classifyColors(positions + begin * 3, colors + begin, end - begin, GLOBAL_PALETTE);
+        });
+        GLOBAL_PLANET.markLayers(stale, cache);
+        return stale;
+    }
 
-            // 2. 최종 위치 계산 (반지름 + 높이)
-            float r = GLOBAL_RADIUS + h;
+    // --------------------------------------------------------------
+    // set_vertex_palette / classify_vertex_colors
+    // --------------------------------------------------------------
+    // 색은 0xAABBGGRR (메모리 순서 R, G, B, A). JS에서는 Uint8 4개짜리 정규화 속성으로 쓴다.
+    // landHeight가 0 이하이면 기본값 1.1을 쓴다.
+    // --------------------------------------------------------------
+    void set_vertex_palette(uint32_t ocean, uint32_t land, float landHeight) {
+        GLOBAL_PALETTE.ocean = ocean;
+        GLOBAL_PALETTE.land = land;
+        GLOBAL_PALETTE.landHeight = landHeight > 0.0f ? landHeight : 1.1f;
+    }
 
-            // 3. 메모리에 직접 덮어쓰기 (JS 쪽 배열이 바뀜)
-            buffer[idx]     = n.x * r;
-            buffer[idx + 1] = n.y * r;
-            buffer[idx + 2] = n.z * r;
+    void classify_vertex_colors(const float* positions, uint32_t* colors, int vertexCount) {
+        if (vertexCount <= 0) return;
+        GLOBAL_PLANET.classifyColors(positions, colors, static_cast<size_t>(vertexCount), GLOBAL_PALETTE);
+    }
+
+    // --------------------------------------------------------------
+    // compute_vertex_normals
+    // --------------------------------------------------------------
+    // positions : 변형된 위치 [x, y, z, ...] (vertexCount개)
+    // indices   : 삼각형 꼭짓점 번호 [a, b, c, ...] (indexCount개, Uint32)
+    // normals   : 결과 [nx, ny, nz, ...] (vertexCount개)
+    //
+    // 한 스레드이면 삼각형 scatter 버전을, 여러 스레드이면 정점 → 삼각형 목록을 만들어
+    // 정점마다 모으는 버전을 쓴다. 두 버전의 결과는 같다.
+    // --------------------------------------------------------------
+    void compute_vertex_normals(const float* positions, int vertexCount,
+                                const uint32_t* indices, int indexCount, float* normals) {
+        if (vertexCount <= 0) return;
+        size_t vertices = static_cast<size_t>(vertexCount);
+        size_t count = indexCount > 0 ? static_cast<size_t>(indexCount) : 0;
+
+        if (sharedPool().threadCount() == 1) {
+            computeVertexNormals(positions, vertices, indices, count, normals);
+            return;
         }
+        VertexAdjacency adjacency;
+        adjacency.build(indices, count, vertices);
+        computeVertexNormals(positions, vertices, indices, count, adjacency, normals, sharedPool());
+    }
+
+    // --------------------------------------------------------------
+    // lod_* : quadtree LOD 지형 (terrain_lod.hpp)
+    // --------------------------------------------------------------
+    // 1) lod_configure(...)로 패치 크기 / 깊이 / 화면 오차 / 프레임당 예산 / 캐시 크기를 정한다.
+    //    (모든 패치를 버리므로 JS도 패치 메쉬를 모두 버린다)
+    // 2) 매 프레임 lod_frustum()에 평면 6개를 쓰고 lod_update(카메라)를 부른다. (행성 좌표계)
+    // 3) lod_released() 슬롯은 숨기고, lod_created() 슬롯은 정점 뷰를 다시 올리고,
+    //    lod_visible() 슬롯만 그린다.
+    // init_planet / set_vertex_palette 뒤에는 lod_regenerate()로 들고 있는 패치를 다시 계산한다.
+    //
+    // 슬롯의 정점은 lod_patch_positions / normals(float 3개씩) / colors(RGBA8)로,
+    // 모든 패치가 같이 쓰는 삼각형은 lod_indices()로 읽는다.
+    // --------------------------------------------------------------
+    void lod_configure(int patchSegments, int maxDepth, float errorPixels, int maxNewPatches, int cacheCapacity) {
+        LodSettings settings;
+        settings.patchSegments = patchSegments;
+        settings.maxDepth = maxDepth;
+        settings.errorPixels = errorPixels;
+        settings.maxNewPatches = maxNewPatches;
+        settings.cacheCapacity = cacheCapacity;
+        GLOBAL_LOD.configure(settings);
+    }
+
+    float* lod_frustum() { return GLOBAL_LOD.frustumPlanes(); }
+
+    int lod_update(float camX, float camY, float camZ, float fovY, float viewportHeight, int useFrustum) {
+        LodCamera camera = { camX, camY, camZ, fovY, viewportHeight, useFrustum != 0 };
+        GLOBAL_LOD.update(camera, GLOBAL_PLANET, GLOBAL_PALETTE, sharedPool());
+        return static_cast<int>(GLOBAL_LOD.visible().size());
+    }
+
+    int lod_regenerate() {
+        GLOBAL_LOD.regenerate(GLOBAL_PLANET, GLOBAL_PALETTE, sharedPool());
+        return static_cast<int>(GLOBAL_LOD.created().size());
+    }
+
+    int lod_visible_count() { return static_cast<int>(GLOBAL_LOD.visible().size()); }
+    const uint32_t* lod_visible() { return GLOBAL_LOD.visible().data(); }
+    int lod_created_count() { return static_cast<int>(GLOBAL_LOD.created().size()); }
+    const uint32_t* lod_created() { return GLOBAL_LOD.created().data(); }
+    int lod_released_count() { return static_cast<int>(GLOBAL_LOD.released().size()); }
+    const uint32_t* lod_released() { return GLOBAL_LOD.released().data(); }
+    int lod_resident_count() { return static_cast<int>(GLOBAL_LOD.residentCount()); }
+
+    int lod_patch_vertex_count() { return static_cast<int>(GLOBAL_LOD.patchVertexCount()); }
+    int lod_index_count() { return static_cast<int>(GLOBAL_LOD.indices().size()); }
+    const uint32_t* lod_indices() { return GLOBAL_LOD.indices().data(); }
+
+    float* lod_patch_positions(int slot) {
+        return slot >= 0 && static_cast<size_t>(slot) < GLOBAL_LOD.slotCount() ? GLOBAL_LOD.positions(slot) : nullptr;
+    }
+
+    float* lod_patch_normals(int slot) {
+        return slot >= 0 && static_cast<size_t>(slot) < GLOBAL_LOD.slotCount() ? GLOBAL_LOD.normals(slot) : nullptr;
+    }
+
+    uint32_t* lod_patch_colors(int slot) {
+        return slot >= 0 && static_cast<size_t>(slot) < GLOBAL_LOD.slotCount() ? GLOBAL_LOD.colors(slot) : nullptr;
+    }
+
+    // --------------------------------------------------------------
+    // set_preview_mode / get_preview_error
+    // --------------------------------------------------------------
+    // 기본 생성기의 미리보기 모드를 켜고 끈다. (resolution <= 0 이면 끔)
+    // scale / radius 슬라이더를 움직이는 동안에는 미리보기로 빠르게 갱신하고,
+    // Generate 때는 꺼서 정확한 지형을 만드는 식으로 쓴다.
+    //
+    // get_preview_error : 미리보기 높이의 최대 오차 (현재 scale 기준)
+    // --------------------------------------------------------------
+    void set_preview_mode(int resolution) {
+        GLOBAL_PLANET.setPreviewMode(resolution);
+    }
+
+    float get_preview_error() {
+        return GLOBAL_PLANET.previewMaxError();
+    }
+
+    // --------------------------------------------------------------
+    // set_noise_param / get_noise_param / clear_noise_params
+    // --------------------------------------------------------------
+    // param : NoiseParam 번호
+    //   0 macroFreq, 1 macroOctaves, 2 macroAmp, 3 microFreq, 4 microOctaves, 5 microAmp,
+    //   6 ridgeFreq, 7 ridgeOctaves, 8 ridgeAmp, 9 lacunarity, 10 gain
+    // 범위를 벗어난 번호는 무시하고(get은 0), 바꾼 뒤에는 mesh_displace / lod_regenerate로 다시 만든다.
+    // 바뀐 층만 다시 계산되고, 강도만 바꾸면 노이즈 계산 없이 섞기만 한다.
+    // --------------------------------------------------------------
+    void set_noise_param(int param, float value) {
+        if (param < 0 || param >= kNoiseParamCount) return;
+        GLOBAL_PLANET.setParam(static_cast<NoiseParam>(param), value);
+    }
+
+    float get_noise_param(int param) {
+        if (param < 0 || param >= kNoiseParamCount) return 0.0f;
+        return GLOBAL_PLANET.param(static_cast<NoiseParam>(param));
+    }
+
+    void clear_noise_params() {
+        GLOBAL_PLANET.clearParamOverrides();
+    }
+
+    // --------------------------------------------------------------
+    // set_thread_count / get_thread_count
+    // --------------------------------------------------------------
+    // 배치 함수들이 쓰는 스레드 수 (부른 스레드 포함).
+    // threads <= 0 이면 하드웨어 스레드 수로 맞춘다.
+    // --------------------------------------------------------------
+    void set_thread_count(int threads) {
+        unsigned n = threads <= 0 ? ThreadPool::hardwareThreads() : static_cast<unsigned>(threads);
+        if (n != sharedPool().threadCount()) sharedPool().resize(n);
+    }
+
+    int get_thread_count() {
+        return static_cast<int>(sharedPool().threadCount());
+    }
+
+    // --------------------------------------------------------------
+    // get_perf_counters / reset_perf_counters
+    // --------------------------------------------------------------
+    int get_perf_counters(double* out) {
+#if PLANET_PERF_COUNTERS
+        if (!out) return 0;
+        perfRead(out);
+        return kPerfValueCount;
+#else
+        (void)out;
+        return 0;
+#endif
+    }
+
+    void reset_perf_counters() {
+#if PLANET_PERF_COUNTERS
+        perfReset();
+#endif
+    }
+
+    // --------------------------------------------------------------
+    // planet_create / planet_destroy
+    // --------------------------------------------------------------
+    // 독립적인 행성 생성기를 하나 만들고 그 핸들(포인터)을 돌려준다.
+    // 스레드(또는 Web Worker)마다 핸들을 하나씩 가지면
+    // 서로 잠금 없이 동시에 행성을 만들 수 있다.
+    // 다 쓴 핸들은 반드시 planet_destroy로 해제해야 한다.
+    // --------------------------------------------------------------
+    PlanetGenerator* planet_create(int seed, float scale, float radius) {
+        return new PlanetGenerator(static_cast<uint32_t>(seed), scale, radius);
+    }
+
+    void planet_destroy(PlanetGenerator* planet) {
+        delete planet;
+    }
+
+    // 핸들 버전의 init_planet / get_height / apply_displacement_batch
+    // 핸들 함수들은 공유 스레드 풀을 쓰지 않고 부른 스레드에서 바로 계산한다. (planet.hpp 참고)
+    void planet_init(PlanetGenerator* planet, int seed, float scale, float radius) {
+        planet->init(static_cast<uint32_t>(seed), scale, radius);
+    }
+
+    float planet_get_height(PlanetGenerator* planet, float x, float y, float z) {
+        return planet->height(x, y, z);
+    }
+
+    void planet_apply_displacement_batch(PlanetGenerator* planet, float* buffer, int vertexCount) {
+        if (vertexCount <= 0) return;
+        planet->applyDisplacement(buffer, static_cast<size_t>(vertexCount));
+    }
+
+    float planet_get_height_and_normal(PlanetGenerator* planet, float x, float y, float z, float* normalOut) {
+        return planet->heightAndNormal(x, y, z, normalOut);
+    }
+
+    void planet_apply_displacement_normals_batch(PlanetGenerator* planet, float* buffer, float* normals,
+                                                 int vertexCount) {
+        if (vertexCount <= 0) return;
+        planet->applyDisplacementWithNormals(buffer, normals, static_cast<size_t>(vertexCount));
+    }
+
+    // 핸들 버전의 apply_displacement_soa / apply_displacement_soa_to
+    void planet_apply_displacement_soa(PlanetGenerator* planet, float* xs, float* ys, float* zs, int vertexCount) {
+        if (vertexCount <= 0) return;
+        planet->applyDisplacementSoA(xs, ys, zs, static_cast<size_t>(vertexCount));
+    }
+
+    void planet_apply_displacement_soa_to(PlanetGenerator* planet, const float* xs, const float* ys, const float* zs,
+                                          float* out, float* normals, int vertexCount) {
+        if (vertexCount <= 0) return;
+        planet->applyDisplacementSoA(xs, ys, zs, out, normals, static_cast<size_t>(vertexCount));
+    }
+
+    // --------------------------------------------------------------
+    // planet_set_layer_basis
+    // --------------------------------------------------------------
+    // layer : 0 = macro, 1 = micro, 2 = ridge
+    // basis : 0 = Perlin(기본), 1 = Simplex
+    // 범위를 벗어난 layer는 무시하고, 모르는 basis는 Perlin으로 둔다.
+    // --------------------------------------------------------------
+    void planet_set_layer_basis(PlanetGenerator* planet, int layer, int basis) {
+        if (layer < 0 || layer > 2) return;
+        planet->setLayerBasis(static_cast<TerrainLayer>(layer),
+                              basis == static_cast<int>(NoiseBasis::Simplex)
+                                  ? NoiseBasis::Simplex : NoiseBasis::Perlin);
+    }
+
+    // --------------------------------------------------------------
+    // planet_set_noise_backend
+    // --------------------------------------------------------------
+    // 핸들의 노이즈 방식을 바꾼다. (0 = Table, 1 = Hashed)
+    // 모르는 값이 들어오면 Table로 둔다.
+    // --------------------------------------------------------------
+    void planet_set_noise_backend(PlanetGenerator* planet, int backend) {
+        planet->setNoiseBackend(backend == static_cast<int>(NoiseBackend::Hashed)
+                                    ? NoiseBackend::Hashed : NoiseBackend::Table);
+    }
+
+    // 핸들 버전의 set_noise_param / get_noise_param / clear_noise_params
+    void planet_set_noise_param(PlanetGenerator* planet, int param, float value) {
+        if (param < 0 || param >= kNoiseParamCount) return;
+        planet->setParam(static_cast<NoiseParam>(param), value);
+    }
+
+    float planet_get_noise_param(PlanetGenerator* planet, int param) {
+        if (param < 0 || param >= kNoiseParamCount) return 0.0f;
+        return planet->param(static_cast<NoiseParam>(param));
+    }
+
+    void planet_clear_noise_params(PlanetGenerator* planet) {
+        planet->clearParamOverrides();
+    }
+
+    // 핸들 버전의 set_preview_mode / get_preview_error
+    void planet_set_preview_mode(PlanetGenerator* planet, int resolution) {
+        planet->setPreviewMode(resolution);
+    }
+
+    float planet_get_preview_error(PlanetGenerator* planet) {
+        return planet->previewMaxError();
     }
-} // extern "C"
\ No newline at end of file
+} // extern "C"
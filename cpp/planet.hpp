@@ -0,0 +1,379 @@
+#pragma once
+#include "noise.hpp"
+#include "noise_params.hpp"
+#include "noise_volume.hpp"
+#include "thread_pool.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// planet.hpp
+// -------------------------------------------------------------
+// 행성 생성기(PlanetGenerator) 선언부.
+//
+// 예전에는 노이즈 테이블(noise.cpp)과 PARAMS / GLOBAL_SEED / GLOBAL_SCALE /
+// GLOBAL_RADIUS(planet.cpp)가 모두 파일 안의 전역 변수였다.
+// 그래서 행성 두 개를 동시에 만들거나, 여러 스레드에서 get_height를 부를 수 없었다.
+//
+// PlanetGenerator는 이 상태를 모두 객체 안에 들고 있다.
+//   - 생성기마다 자기 퍼뮤테이션 테이블과 NoiseParams를 가진다.
+//   - 높이 계산 함수들은 모두 const라서, 객체를 바꾸지 않는다.
+//     → 스레드마다 생성기를 하나씩 두면 잠금(lock) 없이 동시에 계산 가능.
+//       (같은 생성기를 여러 스레드가 읽기만 하는 것도 안전하다)
+// -------------------------------------------------------------
+// 지형 노이즈 층 (setLayerBasis / planet_set_layer_basis에서 사용)
+enum class TerrainLayer : int {
+    Macro = 0,
+    Micro = 1,
+    Ridge = 2,
+};
+
+// 사용자가 직접 바꿀 수 있는 NoiseParams 값 (setParam / set_noise_param에서 사용)
+enum class NoiseParam : int {
+    MacroFreq = 0,
+    MacroOctaves = 1,
+    MacroAmp = 2,
+    MicroFreq = 3,
+    MicroOctaves = 4,
+    MicroAmp = 5,
+    RidgeFreq = 6,
+    RidgeOctaves = 7,
+    RidgeAmp = 8,
+    Lacunarity = 9,
+    Gain = 10,
+};
+constexpr int kNoiseParamCount = 11;
+
+// 층 비트 (staleLayers / sampleLayers에서 사용, 1 << TerrainLayer)
+constexpr int kAllTerrainLayers = 0x7;
+
+// 지형 계산 버전: 같은 입력에서 높이 / 위치가 달라지는 변경(노이즈, 섞는 공식, 파라미터 생성 등)을
+// 하면 올린다. 디스크에 남긴 결과(tile_cache.hpp)는 버전이 다르면 쓰지 않는다.
+constexpr uint32_t kTerrainVersion = 1;
+
+// -------------------------------------------------------------
+// TerrainLayerCache: 정점마다 세 노이즈 층(macro / micro / ridge)의 값과 기울기를
+// 강도(amp)를 곱하기 전 상태로 들고 있는 캐시. (MeshBuffers / TerrainLod 패치마다 하나)
+//
+//   층 값  = fbm(n * freq)          (ridge는 ridged_fbm)
+//   기울기 = fbm'(n * freq) * freq   → 정점마다 [v, dx, dy, dz] 4개
+//
+// 층마다 계산했을 때의 layerRevision을 같이 적어 두고, 그 층의 모양(주파수 / 옥타브 / 종류 ...)이
+// 바뀐 층만 다시 계산한다. 강도 / scale / radius는 섞을 때(shapeLayers) 곱하므로
+// 바뀌어도 캐시는 그대로 쓴다.
+// -------------------------------------------------------------
+struct TerrainLayerCache {
+    std::vector<float> layers[3];        // TerrainLayer 순서
+    uint64_t revisions[3] = { 0, 0, 0 }; // 0이면 아직 계산 전
+
+    // 정점 count개 크기로 만들고 내용을 버린다.
+    void resize(size_t count) {
+        for (auto& layer : layers) layer.assign(count * 4, 0.0f);
+        invalidate();
+    }
+    void invalidate() { revisions[0] = revisions[1] = revisions[2] = 0; }
+};
+
+// 정점 색 팔레트 (classifyColors / mesh_displace에서 사용)
+// 색은 RGBA8을 uint32 하나에 담은 값이다. 메모리 순서가 R, G, B, A가 되도록
+// 0xAABBGGRR로 적는다. (WASM / x86은 little-endian)
+struct VertexPalette {
+    uint32_t ocean;    // 바다색
+    uint32_t land;     // 육지색
+    float landHeight;  // |P| > radius * landHeight 이면 육지 (예전 main.js의 seaLevel = radius * 1.1)
+};
+
+class PlanetGenerator {
+public:
+    // seed / scale / radius 의미는 init_planet과 같다.
+    explicit PlanetGenerator(uint32_t seed = 0, float scale = 1.0f, float radius = 1.0f);
+
+    // 생성기를 새 seed / scale / radius로 다시 초기화 (init_planet과 같은 역할)
+    // seed가 그대로면 노이즈 테이블을 다시 만들지 않고 scale / radius만 바꾼다. (terrainRevision도 그대로)
+    void init(uint32_t seed, float scale, float radius);
+
+    // 노이즈 방식(Table / Hashed)을 바꾼다. (noise.hpp의 NoiseBackend)
+    // 같은 seed로 테이블만 다시 만들며, 이후 init을 불러도 방식은 유지된다.
+    void setNoiseBackend(NoiseBackend backend);
+
+    // 층 하나의 기본 노이즈(Perlin / Simplex)를 바꾼다. 이후 init을 불러도 유지된다.
+    void setLayerBasis(TerrainLayer layer, NoiseBasis basis);
+
+    // NoiseParams 값 하나를 직접 정한다. (seed로 만든 값 대신 쓰는 override)
+    // 이후 init을 불러 seed가 바뀌어도 유지되고, clearParamOverrides로 seed 값으로 되돌린다.
+    // 옥타브 수는 1~12, 주파수 / lacunarity는 0보다 크게 맞춘다.
+    // 바뀐 값이 영향을 주는 층만 layerRevision이 바뀐다. (강도만 바꾸면 어느 층도 바뀌지 않음)
+    void setParam(NoiseParam param, float value);
+    float param(NoiseParam param) const;
+    void clearParamOverrides();
+
+    // (x, y, z) 방향의 지형 높이 (get_height와 같은 값)
+    float height(float x, float y, float z) const;
+
+    // height()를 count개의 점에 대해 한 번에 계산 (SIMD 커널 사용)
+    void heightBatch(const float* xs, const float* ys, const float* zs, float* out, size_t count) const;
+
+    // heightBatch와 같지만 (nx, ny, nz)가 이미 단위 방향이라고 보고 정규화를 건너뛴다.
+    void heightBatchUnit(const float* nx, const float* ny, const float* nz, float* out, size_t count) const;
+
+    // [x, y, z, x, y, z, ...] 정점 배열에 높이를 적용 (apply_displacement_batch와 같은 동작)
+    void applyDisplacement(float* buffer, size_t vertexCount) const;
+
+    // height()와 같은 높이를 돌려주고, 해석적 기울기로 구한 지형 법선을 normal[0..2]에 쓴다.
+    float heightAndNormal(float x, float y, float z, float* normal) const;
+
+    // heightAndNormal과 같지만 (x, y, z)가 이미 단위 방향이라고 보고 정규화를 건너뛴다.
+    float heightAndNormalUnit(float x, float y, float z, float* normal) const;
+
+    // applyDisplacement + 정점 법선을 한 번에 (normals: [nx, ny, nz, ...])
+    void applyDisplacementWithNormals(float* buffer, float* normals, size_t vertexCount) const;
+
+    // 위 두 함수의 멀티스레드 버전.
+    // 정점 배열을 kParallelChunk개(캐시 라인 경계에 맞춘 크기)씩 잘라 pool의 스레드들이 나눠 계산한다.
+    // 정점마다 독립적으로 계산하므로 스레드 수와 상관없이 결과는 한 스레드 버전과 같다.
+    void applyDisplacement(float* buffer, size_t vertexCount, ThreadPool& pool) const;
+    void applyDisplacementWithNormals(float* buffer, float* normals, size_t vertexCount, ThreadPool& pool) const;
+
+    // 표면 위치 [x, y, z, ...]를 높이 구간으로 나눠 colors에 RGBA8 색을 쓴다.
+    void classifyColors(const float* positions, uint32_t* colors, size_t count,
+                        const VertexPalette& palette) const;
+
+    // SoA(축별 배열) 버전. xs / ys / zs는 단위 방향 벡터여야 한다. (정규화하지 않는다)
+    //   - 제자리 버전 : xs / ys / zs를 표면 위치로 덮어쓴다.
+    //   - 출력 버전   : 방향 배열은 그대로 두고 out([x, y, z, ...])에 위치를,
+    //                   normals가 nullptr이 아니면 법선도 쓴다. (방향 배열을 계속 다시 쓸 수 있다)
+    void applyDisplacementSoA(float* xs, float* ys, float* zs, size_t count) const;
+    void applyDisplacementSoA(const float* xs, const float* ys, const float* zs,
+                              float* out, float* normals, size_t count) const;
+    void applyDisplacementSoA(float* xs, float* ys, float* zs, size_t count, ThreadPool& pool) const;
+    void applyDisplacementSoA(const float* xs, const float* ys, const float* zs,
+                              float* out, float* normals, size_t count, ThreadPool& pool) const;
+
+    // 층별 지형 캐시 (TerrainLayerCache)
+    // 최종 높이는 층 값 * 강도를 섞은 값 * scale이고 위치는 방향 * (radius + 높이)라서,
+    // 층의 모양이 그대로면 강도 / scale / radius가 바뀌어도 노이즈를 다시 계산할 필요가 없다.
+    //   - staleLayers  : cache에서 다시 계산해야 하는 층 비트 (1 << TerrainLayer)
+    //   - sampleLayers : layers 비트의 층을 정점 [begin, end)에 대해 계산해서 cache에 쓴다.
+    //                    (xs / ys / zs는 cache와 같은 순서의 단위 방향 배열 전체)
+    //   - markLayers   : 모든 정점을 계산한 뒤 불러서 cache의 층 번호를 지금 번호로 적는다.
+    //   - shapeLayers  : cache의 층을 지금 강도 / scale / radius로 섞어 정점 [begin, end)의
+    //                    위치 / 법선(nullptr이면 건너뜀)을 쓴다. applyDisplacementSoA(출력 버전)와 같은 값이다.
+    int staleLayers(const TerrainLayerCache& cache) const;
+    void sampleLayers(int layers, const float* xs, const float* ys, const float* zs,
+                      TerrainLayerCache& cache, size_t begin, size_t end) const;
+    void markLayers(int layers, TerrainLayerCache& cache) const;
+    void shapeLayers(const float* xs, const float* ys, const float* zs, const TerrainLayerCache& cache,
+                     float* out, float* normals, size_t begin, size_t end) const;
+
+    // 단위 방향 count개의 scale = 1 높이 (heightBatchUnit에서 scale만 뺀 값)
+    void sampleTerrainSoA(const float* xs, const float* ys, const float* zs, float* heights, size_t count) const;
+
+    // 층 번호: 그 층의 모양(seed / 노이즈 방식 / 층 종류 / 주파수 / 옥타브 / lacunarity / gain /
+    // 미리보기 모드)이 바뀔 때마다 새 값이 된다.
+    // 지형 번호: 위 + 강도까지, scale = 1 높이가 바뀔 수 있는 모든 변경에서 새 값이 된다.
+    // 둘 다 scale / radius만 바뀌면 그대로이고, 모든 생성기에서 겹치지 않으며 0은 쓰지 않는다.
+    uint64_t layerRevision(TerrainLayer layer) const { return layerRevisions_[static_cast<int>(layer)]; }
+    uint64_t terrainRevision() const { return terrainRevision_; }
+
+    // 미리보기 모드: 세 노이즈 층을 resolution^3 격자(NoiseVolume)에 구워 두고
+    // 높이 / 법선 계산에서 옥타브 대신 격자 보간을 쓴다. (resolution <= 0 이면 끈다)
+    //   - 층 모양(seed / 노이즈 방식 / 층 종류 / 주파수 / 옥타브 ...)이 바뀔 때만 다시 굽는다.
+    //     scale / radius만 바꾸는 init이나 강도만 바꾸는 setParam은 구운 격자를 그대로 쓴다.
+    //   - 구울 때마다 정확한 계산과 비교한 오차를 잰다. (previewMaxError / previewRmsError)
+    void setPreviewMode(int resolution);
+    bool previewEnabled() const { return previewEnabled_; }
+
+    // 미리보기 높이와 정확한 높이의 차이 (현재 scale 기준, 미리보기가 꺼져 있으면 0)
+    // 단위 구 위에 고르게 퍼진 16,384개 방향에서 잰 최대 / RMS 오차
+    float previewMaxError() const { return previewEnabled_ ? previewMaxErr_ * std::fabs(scale_) : 0.0f; }
+    float previewRmsError() const { return previewEnabled_ ? previewRmsErr_ * std::fabs(scale_) : 0.0f; }
+
+    uint32_t seed() const { return seed_; }
+    float scale() const { return scale_; }
+    float radius() const { return radius_; }
+    const NoiseParams& params() const { return params_; }
+    const NoiseTable& noiseTable() const { return table_; }
+    NoiseBackend noiseBackend() const { return table_.backend; }
+
+private:
+    NoiseTable table_;    // 이 행성 전용 퍼뮤테이션 테이블 (+ 노이즈 방식)
+    NoiseParams params_;  // 행성 지형 스타일 전체
+    uint32_t seed_;
+    float scale_;         // 지형 전체 높이 배율
+    float radius_;        // 기본 행성 반지름
+    uint64_t terrainRevision_ = 0; // 0이면 아직 init 전
+    uint64_t layerRevisions_[3] = { 0, 0, 0 };
+
+    // setParam으로 정한 값 (overrideMask_의 비트 1 << NoiseParam인 것만 유효)
+    float overrides_[kNoiseParamCount] = {};
+    uint32_t overrideMask_ = 0;
+
+    // layers 비트의 층 번호와 지형 번호를 새 값으로 바꾼다.
+    void touchLayers(int layers);
+
+    // 단위 방향 (x, y, z)의 scale = 1 높이를 돌려주고 3D 기울기를 grad[0..2]에 쓴다.
+    float terrainUnit(float x, float y, float z, float* grad) const;
+
+    // 층 하나의 값 / 기울기 (강도를 곱하기 전, TerrainLayerCache와 같은 형식)
+    NoiseGrad layerUnit(TerrainLayer layer, float x, float y, float z) const;
+
+    // layerUnit의 배치 버전 (m <= kHeightChunk, 결과는 v / dx / dy / dz 배열)
+    void layerBatch(TerrainLayer layer, const float* xs, const float* ys, const float* zs, size_t m,
+                    float* v, float* dx, float* dy, float* dz) const;
+
+    // 단위 방향들의 위치 + 법선 (applyDisplacementWithNormals / applyDisplacementSoA의 법선 경로)
+    void displaceUnitWithNormals(const float* nx, const float* ny, const float* nz,
+                                 float* out, float* normals, size_t count) const;
+
+    // 세 층(강도 전)을 강도를 곱해 섞은 scale = 1 높이 / 기울기
+    float combineLayers(const NoiseGrad& macro, const NoiseGrad& micro, const NoiseGrad& ridge,
+                        float ny, float* grad) const;
+
+    // 미리보기 격자 값에 강도를 곱한 세 층 (격자는 강도 1로 굽는다)
+    TerrainLayers previewLayers(float x, float y, float z) const;
+
+    // heightBatchUnit과 같지만 scale 대신 주어진 값을 곱한다. (sampleTerrainSoA는 1)
+    void heightBatchScaled(const float* nx, const float* ny, const float* nz,
+                           float* out, size_t count, float scale) const;
+
+    // 미리보기 모드 상태
+    // (volume_은 층 모양이 바뀌면 비우고, 미리보기가 켜져 있으면 바로 다시 굽는다)
+    // 강도만 바뀌면 격자는 그대로 두고 오차만 다시 잰다. (measurePreviewError)
+    void refreshPreview();
+    void measurePreviewError();
+    NoiseVolume volume_;
+    bool previewEnabled_ = false;
+    int previewResolution_ = 0;
+    float previewMaxErr_ = 0.0f;  // scale = 1 기준
+    float previewRmsErr_ = 0.0f;  // scale = 1 기준
+    bool previewErrorStale_ = false; // 미리보기가 꺼진 동안 강도가 바뀌어 오차를 다시 재야 함
+};
+
+// -------------------------------------------------------------
+// C 인터페이스 (WASM / 다른 언어에서 사용)
+// -------------------------------------------------------------
+// init_planet / get_height / apply_displacement_batch 는
+// 모듈 안의 기본 생성기 하나를 사용하는 예전 API이고,
+// planet_* 함수들은 핸들(PlanetGenerator 포인터)마다 따로 동작한다.
+//
+// 스레드 풀
+//   - 기본 생성기 / mesh_* / lod_* 함수는 모듈이 하나 들고 있는 공유 풀(set_thread_count)로 나눠 계산한다.
+//     공유 풀은 한 번에 parallelFor 하나만 돌리므로 이 함수들은 여러 스레드에서 불러도 차례로 처리된다.
+//   - planet_* 핸들 함수는 공유 풀을 쓰지 않고 부른 스레드에서 바로(한 스레드로) 계산한다.
+//     그래서 스레드(Web Worker)마다 핸들을 하나씩 두면 서로 기다리지 않고 동시에 돌아간다.
+//     (핸들마다 풀을 두면 Worker 수 * 풀 크기만큼 스레드가 생겨 PTHREAD_POOL_SIZE를 넘기 쉽다)
+// -------------------------------------------------------------
+extern "C" {
+    void init_planet(int seed, float scale, float radius);
+    float get_height(float x, float y, float z);
+    void apply_displacement_batch(float* buffer, int vertexCount);
+    float get_height_and_normal(float x, float y, float z, float* normalOut);
+    void apply_displacement_normals_batch(float* buffer, float* normals, int vertexCount);
+
+    // SoA 버전 (xs / ys / zs는 단위 방향, normals는 0(NULL)이면 건너뜀)
+    void apply_displacement_soa(float* xs, float* ys, float* zs, int vertexCount);
+    void apply_displacement_soa_to(const float* xs, const float* ys, const float* zs,
+                                   float* out, float* normals, int vertexCount);
+
+    // 모듈이 들고 있는 현재 메쉬 버퍼 (JS는 포인터로 HEAPF32 뷰를 만들어 Three.js에 바로 연결)
+    // 포인터는 mesh_resize 뒤에만 바뀐다. 길이는 색을 빼고 모두 mesh_vertex_count() * 3
+    void mesh_resize(int vertexCount);
+    int mesh_vertex_count();
+    float* mesh_directions();   // 단위 방향 SoA (xs | ys | zs)
+    float* mesh_positions();    // [x, y, z, ...]
+    float* mesh_normals();      // [nx, ny, nz, ...]
+    uint32_t* mesh_colors();    // RGBA8, 정점마다 uint32 하나 (길이 mesh_vertex_count())
+    void mesh_capture_directions(); // positions를 정규화해서 directions에 저장
+    int mesh_displace();            // directions로 positions / normals / colors를 다시 계산
+                                    // (모양이 바뀐 층만 노이즈를 다시 계산, 다시 계산한 층 비트를 돌려줌)
+
+    // 모듈 안에서 단위 구 메쉬를 만든다. (kind : 0 = Icosphere, 1 = CubeSphere, 실제 정점 수를 돌려줌)
+    // mesh_resize처럼 모든 포인터가 바뀐다.
+    int mesh_generate_sphere(int kind, int targetVertices, int tilesPerEdge);
+    int mesh_index_count();
+    uint32_t* mesh_indices();       // 삼각형 [a, b, c, ...] (타일 순서)
+    int mesh_tile_count();
+    uint32_t* mesh_tile_offsets();  // 타일 t = mesh_indices()[offsets[t] .. offsets[t+1])
+
+    // quadtree LOD 지형 (terrain_lod.hpp, 카메라는 행성 좌표계)
+    // lod_update / lod_regenerate 뒤에 visible / created / released 슬롯 목록을 읽는다.
+    void lod_configure(int patchSegments, int maxDepth, float errorPixels, int maxNewPatches, int cacheCapacity);
+    float* lod_frustum();           // 평면 6개 [nx, ny, nz, d] (useFrustum일 때 lod_update 전에 채움)
+    int lod_update(float camX, float camY, float camZ, float fovY, float viewportHeight, int useFrustum);
+    int lod_regenerate();           // 들고 있는 패치를 기본 생성기로 다시 계산
+    int lod_visible_count();
+    const uint32_t* lod_visible();
+    int lod_created_count();
+    const uint32_t* lod_created();
+    int lod_released_count();
+    const uint32_t* lod_released();
+    int lod_resident_count();
+    int lod_patch_vertex_count();
+    int lod_index_count();
+    const uint32_t* lod_indices();  // 모든 패치가 같이 쓰는 삼각형
+    float* lod_patch_positions(int slot);
+    float* lod_patch_normals(int slot);
+    uint32_t* lod_patch_colors(int slot);
+
+    // 정점 색 팔레트 (ocean / land : 0xAABBGGRR, landHeight : 반지름 대비 육지 기준, 기본 1.1)
+    void set_vertex_palette(uint32_t ocean, uint32_t land, float landHeight);
+    // positions([x, y, z, ...])를 분류해서 colors(RGBA8)에 쓴다. (mesh 버퍼가 아닌 배열용)
+    void classify_vertex_colors(const float* positions, uint32_t* colors, int vertexCount);
+
+    // 변형된 위치와 삼각형 index로 넓이 가중 정점 법선을 계산해서 normals([nx, ny, nz, ...])에 쓴다.
+    // (Three.js computeVertexNormals와 같은 결과, 스레드가 2개 이상이면 정점별 gather로 나눠 계산)
+    void compute_vertex_normals(const float* positions, int vertexCount,
+                                const uint32_t* indices, int indexCount, float* normals);
+
+    // resolution : 미리보기 격자 해상도 (예: 64), 0 이하면 정확한 계산으로 돌아감
+    void set_preview_mode(int resolution);
+    // 미리보기 높이의 최대 오차 (현재 scale 기준, 미리보기가 꺼져 있으면 0)
+    float get_preview_error();
+
+    // 기본 생성기의 NoiseParams 값 하나를 바꾸거나 읽는다. (param : NoiseParam, 0 = macroFreq ... 10 = gain)
+    // 바꾼 값은 init_planet으로 seed가 바뀌어도 유지되고, clear_noise_params로 seed 값으로 되돌린다.
+    void set_noise_param(int param, float value);
+    float get_noise_param(int param);
+    void clear_noise_params();
+
+    // apply_displacement_* / mesh_* / lod_* 함수가 쓸 공유 풀의 스레드 수 (planet_* 핸들 함수는 항상 한 스레드)
+    // 1(기본)이면 지금처럼 한 스레드, 0이면 하드웨어 스레드 수.
+    // pthread 없이 빌드한 WASM에서는 항상 1이다.
+    void set_thread_count(int threads);
+    int get_thread_count();
+
+    // 계수기 / 단계별 타이머 (perf_counters.hpp, PLANET_PERF_COUNTERS = 1로 빌드했을 때만 켜짐)
+    // out[22] (double)에 [계수기 6 | 단계별 ns 8 | 단계별 횟수 8]을 쓰고 값 수(22)를 돌려준다.
+    //   계수기 : 노이즈 샘플, macro / micro / ridge 옥타브, 정점, get_height 호출
+    //   단계   : 정규화, macro, micro, ridge, 층(노이즈 외), 섞기, 결과 쓰기, 산맥 마스크
+    // 꺼진 빌드에서는 out을 건드리지 않고 0을 돌려준다.
+    int get_perf_counters(double* out);
+    void reset_perf_counters();
+
+    PlanetGenerator* planet_create(int seed, float scale, float radius);
+    void planet_destroy(PlanetGenerator* planet);
+    void planet_init(PlanetGenerator* planet, int seed, float scale, float radius);
+    float planet_get_height(PlanetGenerator* planet, float x, float y, float z);
+    void planet_apply_displacement_batch(PlanetGenerator* planet, float* buffer, int vertexCount);
+    float planet_get_height_and_normal(PlanetGenerator* planet, float x, float y, float z, float* normalOut);
+    void planet_apply_displacement_normals_batch(PlanetGenerator* planet, float* buffer, float* normals,
+                                                 int vertexCount);
+    void planet_apply_displacement_soa(PlanetGenerator* planet, float* xs, float* ys, float* zs, int vertexCount);
+    void planet_apply_displacement_soa_to(PlanetGenerator* planet, const float* xs, const float* ys, const float* zs,
+                                          float* out, float* normals, int vertexCount);
+
+    // backend : 0 = Table(기본), 1 = Hashed
+    void planet_set_noise_backend(PlanetGenerator* planet, int backend);
+
+    // layer : 0 = macro, 1 = micro, 2 = ridge / basis : 0 = Perlin(기본), 1 = Simplex
+    void planet_set_layer_basis(PlanetGenerator* planet, int layer, int basis);
+
+    // param : NoiseParam (0 = macroFreq ... 10 = gain)
+    void planet_set_noise_param(PlanetGenerator* planet, int param, float value);
+    float planet_get_noise_param(PlanetGenerator* planet, int param);
+    void planet_clear_noise_params(PlanetGenerator* planet);
+
+    void planet_set_preview_mode(PlanetGenerator* planet, int resolution);
+    float planet_get_preview_error(PlanetGenerator* planet);
+}
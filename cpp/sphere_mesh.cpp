@@ -0,0 +1,287 @@
+#include "sphere_mesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+
+// 정이십면체 (Three.js IcosahedronGeometry와 같은 꼭짓점 / 면 순서, 면은 바깥에서 CCW)
+const double kPhi = 1.6180339887498949;
+
+const double kIcoVertices[12][3] = {
+    { -1,  kPhi, 0 }, {  1,  kPhi, 0 }, { -1, -kPhi, 0 }, {  1, -kPhi, 0 },
+    { 0, -1,  kPhi }, { 0,  1,  kPhi }, { 0, -1, -kPhi }, { 0,  1, -kPhi },
+    {  kPhi, 0, -1 }, {  kPhi, 0,  1 }, { -kPhi, 0, -1 }, { -kPhi, 0,  1 }
+};
+
+const int kIcoFaces[20][3] = {
+    { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+    { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+    { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+    { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+};
+
+// 정육면체 면: 바깥 방향 N, 면 위의 가로 R / 세로 U (R x U = N → 격자 순서대로 CCW)
+const int kCubeFaces[6][3][3] = {
+    { {  1, 0, 0 }, { 0, 0, -1 }, { 0, 1,  0 } },
+    { { -1, 0, 0 }, { 0, 0,  1 }, { 0, 1,  0 } },
+    { { 0,  1, 0 }, { 1, 0,  0 }, { 0, 0, -1 } },
+    { { 0, -1, 0 }, { 1, 0,  0 }, { 0, 0,  1 } },
+    { { 0, 0,  1 }, { 1, 0,  0 }, { 0, 1,  0 } },
+    { { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1,  0 } }
+};
+
+const double kQuarterPi = 0.78539816339744831;
+
+// (x, y, z)를 단위 길이로 만들어 positions의 index 자리에 쓴다.
+void storePoint(std::vector<float>& positions, uint32_t index, double x, double y, double z) {
+    double inv = 1.0 / std::sqrt(x * x + y * y + z * z);
+    positions[index * 3] = static_cast<float>(x * inv);
+    positions[index * 3 + 1] = static_cast<float>(y * inv);
+    positions[index * 3 + 2] = static_cast<float>(z * inv);
+}
+
+// 삼각형들(triangles: a, b, c, ...)을 타일 번호(tiles) 순서로 모아 mesh.indices / tileOffsets를 채운다.
+// tileSlots : 타일 번호의 범위. 삼각형이 하나도 없는 번호는 건너뛴다. (같은 타일 안에서는 원래 순서 유지)
+void sortByTile(const std::vector<uint32_t>& triangles, const std::vector<uint32_t>& tiles,
+                size_t tileSlots, SphereMesh& mesh) {
+    std::vector<uint32_t> start(tileSlots + 1, 0u);
+    for (uint32_t tile : tiles) ++start[tile + 1];
+    for (size_t s = 0; s < tileSlots; ++s) start[s + 1] += start[s];
+
+    mesh.tileOffsets.clear();
+    for (size_t s = 0; s < tileSlots; ++s) {
+        if (start[s + 1] != start[s]) mesh.tileOffsets.push_back(start[s] * 3);
+    }
+    mesh.tileOffsets.push_back(static_cast<uint32_t>(triangles.size()));
+
+    mesh.indices.resize(triangles.size());
+    for (size_t t = 0; t < tiles.size(); ++t) {
+        uint32_t dst = start[tiles[t]]++ * 3;
+        mesh.indices[dst] = triangles[t * 3];
+        mesh.indices[dst + 1] = triangles[t * 3 + 1];
+        mesh.indices[dst + 2] = triangles[t * 3 + 2];
+    }
+}
+
+} // namespace
+
+// --------------------------------------------------------------
+// buildIcosphere
+// --------------------------------------------------------------
+// 정점 번호: 꼭짓점 12개 → 모서리 30개의 중간점 (f-1개씩) → 면 20개의 안쪽 점 순서.
+// 모서리 점은 항상 번호가 작은 꼭짓점에서 큰 꼭짓점 방향으로 계산해서
+// 이웃한 두 면이 같은 번호 / 같은 좌표를 쓴다.
+//
+// 면 (v0, v1, v2) 위의 격자점 (i, j) = (v0 * (f-i-j) + v1 * i + v2 * j) / f
+// 작은 삼각형: 위쪽 (i,j) (i+1,j) (i,j+1) / 아래쪽 (i+1,j) (i+1,j+1) (i,j+1)
+// --------------------------------------------------------------
+void buildIcosphere(int frequency, int tilesPerEdge, SphereMesh& mesh) {
+    const int f = std::max(1, frequency);
+    const int t = std::min(std::max(1, tilesPerEdge), f);
+    const uint32_t edgePoints = static_cast<uint32_t>(f - 1);
+    const uint32_t vertexCount = static_cast<uint32_t>(10 * f * f + 2);
+
+    mesh.positions.assign(static_cast<size_t>(vertexCount) * 3, 0.0f);
+
+    for (uint32_t v = 0; v < 12; ++v) {
+        storePoint(mesh.positions, v, kIcoVertices[v][0], kIcoVertices[v][1], kIcoVertices[v][2]);
+    }
+
+    // 모서리 번호 (면 순서대로 처음 만나는 순서)
+    int edgeId[12][12];
+    std::fill(&edgeId[0][0], &edgeId[0][0] + 144, -1);
+    int edges = 0;
+    for (const int* face : kIcoFaces) {
+        for (int k = 0; k < 3; ++k) {
+            int lo = std::min(face[k], face[(k + 1) % 3]);
+            int hi = std::max(face[k], face[(k + 1) % 3]);
+            if (edgeId[lo][hi] >= 0) continue;
+            edgeId[lo][hi] = edges;
+            for (uint32_t s = 1; s <= edgePoints; ++s) {
+                double w = double(s) / f;
+                storePoint(mesh.positions, 12 + edges * edgePoints + (s - 1),
+                           kIcoVertices[lo][0] + (kIcoVertices[hi][0] - kIcoVertices[lo][0]) * w,
+                           kIcoVertices[lo][1] + (kIcoVertices[hi][1] - kIcoVertices[lo][1]) * w,
+                           kIcoVertices[lo][2] + (kIcoVertices[hi][2] - kIcoVertices[lo][2]) * w);
+            }
+            ++edges;
+        }
+    }
+
+    // a → b 방향으로 s번째(1..f-1) 모서리 점의 번호
+    auto edgeVertex = [&](int a, int b, int s) -> uint32_t {
+        int e = edgeId[std::min(a, b)][std::max(a, b)];
+        int along = a < b ? s : f - s;
+        return 12 + static_cast<uint32_t>(e) * edgePoints + static_cast<uint32_t>(along - 1);
+    };
+
+    uint32_t nextInterior = 12 + 30 * edgePoints;
+    const size_t trianglesPerFace = static_cast<size_t>(f) * f;
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> tiles;
+    triangles.reserve(20 * trianglesPerFace * 3);
+    tiles.reserve(20 * trianglesPerFace);
+
+    // 면 하나의 격자점 번호 (행 j마다 f-j+1개)
+    std::vector<uint32_t> lattice(static_cast<size_t>(f + 1) * (f + 2) / 2);
+    std::vector<size_t> rowStart(f + 2);
+    for (int j = 0; j <= f + 1; ++j) rowStart[j] = static_cast<size_t>(j) * (2 * f + 3 - j) / 2;
+    auto at = [&](int i, int j) -> uint32_t& { return lattice[rowStart[j] + i]; };
+
+    const size_t tileSlotsPerFace = static_cast<size_t>(2) * t * t;
+
+    for (int faceIndex = 0; faceIndex < 20; ++faceIndex) {
+        const int v0 = kIcoFaces[faceIndex][0];
+        const int v1 = kIcoFaces[faceIndex][1];
+        const int v2 = kIcoFaces[faceIndex][2];
+
+        for (int j = 0; j <= f; ++j) {
+            for (int i = 0; i <= f - j; ++i) {
+                int k = f - i - j;
+                uint32_t id;
+                if (k == f) id = static_cast<uint32_t>(v0);
+                else if (i == f) id = static_cast<uint32_t>(v1);
+                else if (j == f) id = static_cast<uint32_t>(v2);
+                else if (j == 0) id = edgeVertex(v0, v1, i);
+                else if (k == 0) id = edgeVertex(v1, v2, j);
+                else if (i == 0) id = edgeVertex(v0, v2, j);
+                else {
+                    id = nextInterior++;
+                    storePoint(mesh.positions, id,
+                               (kIcoVertices[v0][0] * k + kIcoVertices[v1][0] * i + kIcoVertices[v2][0] * j) / f,
+                               (kIcoVertices[v0][1] * k + kIcoVertices[v1][1] * i + kIcoVertices[v2][1] * j) / f,
+                               (kIcoVertices[v0][2] * k + kIcoVertices[v1][2] * i + kIcoVertices[v2][2] * j) / f);
+                }
+                at(i, j) = id;
+            }
+        }
+
+        // 작은 삼각형의 무게중심이 들어 있는 타일 (면을 t 격자로 나눈 위 / 아래 삼각형)
+        auto tileOf = [&](double ci, double cj) -> uint32_t {
+            double a = ci * t / f;
+            double b = cj * t / f;
+            int ta = std::min(static_cast<int>(a), t - 1);
+            int tb = std::min(static_cast<int>(b), t - 1);
+            int down = (a - ta) + (b - tb) > 1.0 ? 1 : 0;
+            return static_cast<uint32_t>(faceIndex * tileSlotsPerFace + (static_cast<size_t>(tb) * t + ta) * 2 + down);
+        };
+
+        for (int j = 0; j < f; ++j) {
+            for (int i = 0; i < f - j; ++i) {
+                triangles.insert(triangles.end(), { at(i, j), at(i + 1, j), at(i, j + 1) });
+                tiles.push_back(tileOf(i + 1.0 / 3.0, j + 1.0 / 3.0));
+                if (i + j < f - 1) {
+                    triangles.insert(triangles.end(), { at(i + 1, j), at(i + 1, j + 1), at(i, j + 1) });
+                    tiles.push_back(tileOf(i + 2.0 / 3.0, j + 2.0 / 3.0));
+                }
+            }
+        }
+    }
+
+    sortByTile(triangles, tiles, 20 * tileSlotsPerFace, mesh);
+}
+
+// --------------------------------------------------------------
+// buildCubeSphere
+// --------------------------------------------------------------
+// 면 위의 격자 (i, j)를 등각 배치 tan(π/4 · (2i/n - 1))로 옮긴 뒤 정규화한다.
+// (그냥 정규화하면 면 가운데보다 모서리 근처 간격이 약 1.7배 좁아진다)
+// 이웃 면과 겹치는 정점은 정육면체 위의 정수 격자 좌표로 합친다.
+// --------------------------------------------------------------
+void buildCubeSphere(int segments, int tilesPerEdge, SphereMesh& mesh) {
+    const int n = std::max(1, segments);
+    const int t = std::min(std::max(1, tilesPerEdge), n);
+    const size_t vertexCount = static_cast<size_t>(6) * n * n + 2;
+
+    mesh.positions.assign(vertexCount * 3, 0.0f);
+    std::unordered_map<uint64_t, uint32_t> welded;
+    welded.reserve(vertexCount);
+    uint32_t nextVertex = 0;
+
+    std::vector<double> warp(n + 1);
+    for (int i = 0; i <= n; ++i) warp[i] = std::tan(kQuarterPi * (2.0 * i / n - 1.0));
+
+    std::vector<uint32_t> grid(static_cast<size_t>(n + 1) * (n + 1));
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> tiles;
+    triangles.reserve(static_cast<size_t>(6) * n * n * 6);
+    tiles.reserve(static_cast<size_t>(6) * n * n * 2);
+
+    const uint64_t side = static_cast<uint64_t>(2 * n + 1);
+
+    for (int faceIndex = 0; faceIndex < 6; ++faceIndex) {
+        const int* N = kCubeFaces[faceIndex][0];
+        const int* R = kCubeFaces[faceIndex][1];
+        const int* U = kCubeFaces[faceIndex][2];
+
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                // 정육면체 위의 정수 좌표 (각 축 -n..n)
+                uint64_t key = 0;
+                for (int axis = 0; axis < 3; ++axis) {
+                    int q = N[axis] * n + R[axis] * (2 * i - n) + U[axis] * (2 * j - n);
+                    key = key * side + static_cast<uint64_t>(q + n);
+                }
+
+                auto found = welded.find(key);
+                uint32_t id;
+                if (found != welded.end()) {
+                    id = found->second;
+                } else {
+                    id = nextVertex++;
+                    welded.emplace(key, id);
+                    storePoint(mesh.positions, id,
+                               N[0] + R[0] * warp[i] + U[0] * warp[j],
+                               N[1] + R[1] * warp[i] + U[1] * warp[j],
+                               N[2] + R[2] * warp[i] + U[2] * warp[j]);
+                }
+                grid[static_cast<size_t>(j) * (n + 1) + i] = id;
+            }
+        }
+
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                uint32_t a = grid[static_cast<size_t>(j) * (n + 1) + i];
+                uint32_t b = grid[static_cast<size_t>(j) * (n + 1) + i + 1];
+                uint32_t c = grid[static_cast<size_t>(j + 1) * (n + 1) + i + 1];
+                uint32_t d = grid[static_cast<size_t>(j + 1) * (n + 1) + i];
+                uint32_t tile = static_cast<uint32_t>(
+                    (static_cast<size_t>(faceIndex) * t + static_cast<size_t>(j) * t / n) * t +
+                    static_cast<size_t>(i) * t / n);
+                triangles.insert(triangles.end(), { a, b, c, a, c, d });
+                tiles.push_back(tile);
+                tiles.push_back(tile);
+            }
+        }
+    }
+
+    sortByTile(triangles, tiles, static_cast<size_t>(6) * t * t, mesh);
+}
+
+void cubeSphereDirection(int face, double u, double v, float* out) {
+    const int* N = kCubeFaces[face][0];
+    const int* R = kCubeFaces[face][1];
+    const int* U = kCubeFaces[face][2];
+    double a = std::tan(kQuarterPi * u);
+    double b = std::tan(kQuarterPi * v);
+    double x = N[0] + R[0] * a + U[0] * b;
+    double y = N[1] + R[1] * a + U[1] * b;
+    double z = N[2] + R[2] * a + U[2] * b;
+    double inv = 1.0 / std::sqrt(x * x + y * y + z * z);
+    out[0] = static_cast<float>(x * inv);
+    out[1] = static_cast<float>(y * inv);
+    out[2] = static_cast<float>(z * inv);
+}
+
+void buildSphereMesh(SphereMeshKind kind, size_t targetVertices, int tilesPerEdge, SphereMesh& mesh) {
+    if (kind == SphereMeshKind::CubeSphere) {
+        // 6n² + 2 <= target
+        double n = targetVertices > 2 ? std::sqrt((targetVertices - 2) / 6.0) : 1.0;
+        buildCubeSphere(std::max(1, static_cast<int>(n)), tilesPerEdge, mesh);
+    } else {
+        // 10f² + 2 <= target
+        double f = targetVertices > 2 ? std::sqrt((targetVertices - 2) / 10.0) : 1.0;
+        buildIcosphere(std::max(1, static_cast<int>(f)), tilesPerEdge, mesh);
+    }
+}
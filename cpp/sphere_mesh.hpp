@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// sphere_mesh.hpp
+// -------------------------------------------------------------
+// 행성용 단위 구 메쉬 생성기.
+//
+// Three.js SphereGeometry(UV 구)는 극으로 갈수록 정점이 빽빽해지고
+// 극 / 이음새에 같은 위치의 정점이 겹쳐 있어서, 지형 높이를 계산할 때
+// 화면에 거의 보이지 않는 곳에 노이즈 계산을 많이 쓴다.
+// 여기서는 정점 간격이 거의 고른 두 가지 구를 만든다.
+//
+//   Icosphere  : 정이십면체의 삼각형 20개를 frequency f 격자로 나누고 구에 투영 (정점 10f² + 2개)
+//   CubeSphere : 정육면체의 면 6개를 n x n 격자로 나누고 구에 투영 (정점 6n² + 2개)
+//                격자는 등각(tan) 배치를 써서 면 가운데와 모서리의 간격 차이를 줄인다.
+//
+// 모서리 / 꼭짓점의 정점은 이웃 면과 공유한다. (같은 위치의 정점이 두 번 나오지 않음)
+// 삼각형은 바깥에서 볼 때 반시계 방향(CCW, Three.js 앞면)이다.
+//
+// 타일(tile): 기본 면(이십면체 삼각형 / 정육면체 면)을 다시 tilesPerEdge 단위로 나눈 조각.
+// 삼각형은 타일 순서대로 모여 있어서 tileOffsets로 타일마다 index 범위를 알 수 있다.
+// (컬링 / LOD처럼 메쉬 일부만 그릴 때 사용)
+// -------------------------------------------------------------
+enum class SphereMeshKind : int {
+    Icosphere = 0,
+    CubeSphere = 1
+};
+
+struct SphereMesh {
+    std::vector<float> positions;     // 단위 구 위의 점 [x, y, z, ...]
+    std::vector<uint32_t> indices;    // 삼각형 [a, b, c, ...]
+    std::vector<uint32_t> tileOffsets; // 타일 t의 삼각형 = indices[tileOffsets[t] .. tileOffsets[t+1])
+
+    size_t vertexCount() const { return positions.size() / 3; }
+    size_t tileCount() const { return tileOffsets.empty() ? 0 : tileOffsets.size() - 1; }
+};
+
+// frequency : 이십면체 모서리 하나를 나누는 수 (1이면 정이십면체 그대로)
+void buildIcosphere(int frequency, int tilesPerEdge, SphereMesh& mesh);
+
+// segments : 정육면체 모서리 하나를 나누는 수
+void buildCubeSphere(int segments, int tilesPerEdge, SphereMesh& mesh);
+
+// 정육면체 면 face(0..5: +X, -X, +Y, -Y, +Z, -Z) 위의 (u, v) ∈ [-1, 1]²를
+// buildCubeSphere와 같은 등각 배치로 단위 구에 투영한 방향을 out[0..2]에 쓴다.
+// (u → 면의 가로, v → 세로 방향이고, u / v가 커지는 순서가 바깥에서 볼 때 CCW)
+void cubeSphereDirection(int face, double u, double v, float* out);
+
+// 정점 수가 targetVertices를 넘지 않는 가장 촘촘한 메쉬를 만든다.
+// (최소 크기: 정이십면체 12개 / 정육면체 8개)
+// tilesPerEdge : 기본 면 모서리를 나누는 타일 수 (1이면 기본 면 하나가 타일 하나)
+void buildSphereMesh(SphereMeshKind kind, size_t targetVertices, int tilesPerEdge, SphereMesh& mesh);
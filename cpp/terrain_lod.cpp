@@ -0,0 +1,468 @@
+#include "terrain_lod.hpp"
+#include "sphere_mesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+const float kHalfPi = 1.57079632679489662f;
+const float kPi = 3.14159265358979324f;
+
+// 행성 전체 높이 범위를 어림할 때 쓰는 방향 수 (피보나치 구) / 범위에 더하는 여유 비율
+const size_t kRangeSamples = 4096;
+const float kRangeMargin = 0.1f;
+
+const int kMaxDepth = 20;        // key()에 x / y를 28비트씩 담으므로 충분히 여유 있는 값
+const int kMaxPatchSegments = 128;
+
+inline float dot3(const float* a, const float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+} // namespace
+
+TerrainLod::TerrainLod() {
+    std::fill(frustum_, frustum_ + 24, 0.0f);
+    configure(LodSettings());
+}
+
+uint64_t TerrainLod::key(const Node& node) {
+    return (static_cast<uint64_t>(node.face) << 61) | (static_cast<uint64_t>(node.level) << 56) |
+           (static_cast<uint64_t>(node.x) << 28) | static_cast<uint64_t>(node.y);
+}
+
+void TerrainLod::configure(const LodSettings& settings) {
+    settings_ = settings;
+    settings_.patchSegments = std::min(std::max(2, settings_.patchSegments), kMaxPatchSegments);
+    settings_.maxDepth = std::min(std::max(0, settings_.maxDepth), kMaxDepth);
+    settings_.errorPixels = std::max(0.25f, settings_.errorPixels);
+    settings_.maxNewPatches = std::max(0, settings_.maxNewPatches);
+    settings_.cacheCapacity = std::max(0, settings_.cacheCapacity);
+
+    // 패치 크기가 바뀌므로 슬롯을 모두 새로 만든다. (JS도 모든 패치를 버려야 함)
+    slots_.clear();
+    freeSlots_.clear();
+    resident_.clear();
+    visible_.clear();
+    created_.clear();
+    released_.clear();
+
+    buildIndices();
+}
+
+// --------------------------------------------------------------
+// buildIndices
+// --------------------------------------------------------------
+// 격자 정점 (i, j) = j * (n+1) + i, 그 뒤에 스커트 정점 4n개가 가장자리 순서대로 온다.
+// 가장자리 순서: 아래(j=0) → 오른쪽(i=n) → 위(j=n) → 왼쪽(i=0), 바깥에서 볼 때 CCW.
+// 스커트 사각형 (b_k, b_k+1, s_k+1, s_k)은 패치 바깥쪽에서 볼 때 CCW가 되도록 감는다.
+// --------------------------------------------------------------
+void TerrainLod::buildIndices() {
+    const uint32_t n = static_cast<uint32_t>(settings_.patchSegments);
+    const uint32_t row = n + 1;
+    const uint32_t gridVertices = row * row;
+    patchVertices_ = gridVertices + 4 * n;
+
+    perimeter_.clear();
+    for (uint32_t i = 0; i < n; ++i) perimeter_.push_back(i);
+    for (uint32_t j = 0; j < n; ++j) perimeter_.push_back(j * row + n);
+    for (uint32_t i = n; i > 0; --i) perimeter_.push_back(n * row + i);
+    for (uint32_t j = n; j > 0; --j) perimeter_.push_back(j * row);
+
+    indices_.clear();
+    indices_.reserve(6 * n * n + 6 * perimeter_.size());
+    for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < n; ++i) {
+            uint32_t a = j * row + i;
+            uint32_t b = a + 1;
+            uint32_t c = a + row + 1;
+            uint32_t d = a + row;
+            indices_.insert(indices_.end(), { a, b, c, a, c, d });
+        }
+    }
+
+    const uint32_t ring = static_cast<uint32_t>(perimeter_.size());
+    for (uint32_t k = 0; k < ring; ++k) {
+        uint32_t next = (k + 1) % ring;
+        uint32_t b0 = perimeter_[k], b1 = perimeter_[next];
+        uint32_t s0 = gridVertices + k, s1 = gridVertices + next;
+        indices_.insert(indices_.end(), { b0, s0, s1, b0, s1, b1 });
+    }
+}
+
+// --------------------------------------------------------------
+// updateSurface
+// --------------------------------------------------------------
+// 행성 전체 표면의 높이 범위를 어림한다. (아직 계산하지 않은 패치의 경계 / 지평선 계산용)
+// 고르게 퍼진 방향 kRangeSamples개의 높이를 한 번에 계산하고, 샘플 사이의
+// 봉우리 / 골짜기를 위해 범위를 kRangeMargin만큼 넓힌다.
+// 표본은 지형 번호가 바뀌었을 때만 다시 재고, scale / radius는 매번 적용한다.
+// --------------------------------------------------------------
+void TerrainLod::updateSurface(const PlanetGenerator& planet) {
+    if (surfaceRevision_ != planet.terrainRevision()) {
+        std::vector<float> dirs(kRangeSamples * 3);
+        float* xs = dirs.data();
+        float* ys = xs + kRangeSamples;
+        float* zs = ys + kRangeSamples;
+        for (size_t i = 0; i < kRangeSamples; ++i) {
+            float y = 1.0f - 2.0f * (float(i) + 0.5f) / float(kRangeSamples);
+            float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+            float a = 2.39996323f * float(i);
+            xs[i] = r * std::cos(a);
+            ys[i] = y;
+            zs[i] = r * std::sin(a);
+        }
+        std::vector<float> heights(kRangeSamples);
+        planet.sampleTerrainSoA(xs, ys, zs, heights.data(), kRangeSamples);
+
+        surfaceUnit_ = { heights[0], heights[0] };
+        for (float h : heights) {
+            surfaceUnit_.lo = std::min(surfaceUnit_.lo, h);
+            surfaceUnit_.hi = std::max(surfaceUnit_.hi, h);
+        }
+        surfaceRevision_ = planet.terrainRevision();
+    }
+
+    const float s = planet.scale();
+    float lo = surfaceUnit_.lo * s, hi = surfaceUnit_.hi * s;
+    if (lo > hi) std::swap(lo, hi);
+    float margin = (hi - lo) * kRangeMargin;
+    const float R = planet.radius();
+    surface_ = { std::max(0.0f, R + lo - margin), R + hi + margin };
+}
+
+// --------------------------------------------------------------
+// bounds
+// --------------------------------------------------------------
+// 패치 가운데 방향과, 가장자리 8점(모서리 + 변 가운데)까지의 최대 각으로
+// 높이 범위 [range.lo, range.hi]까지 포함하는 경계 구를 만든다.
+// --------------------------------------------------------------
+TerrainLod::Bounds TerrainLod::bounds(const Node& node, const PlanetGenerator& planet,
+                                      const HeightRange& range) const {
+    const double size = 2.0 / double(1u << node.level);
+    const double u0 = -1.0 + node.x * size;
+    const double v0 = -1.0 + node.y * size;
+
+    Bounds b;
+    cubeSphereDirection(node.face, u0 + size * 0.5, v0 + size * 0.5, b.dir);
+
+    float minCos = 1.0f;
+    for (int j = 0; j <= 2; ++j) {
+        for (int i = 0; i <= 2; ++i) {
+            if (i == 1 && j == 1) continue;
+            float p[3];
+            cubeSphereDirection(node.face, u0 + size * 0.5 * i, v0 + size * 0.5 * j, p);
+            minCos = std::min(minCos, dot3(p, b.dir));
+        }
+    }
+    minCos = std::max(-1.0f, std::min(1.0f, minCos));
+    b.angle = std::acos(minCos);
+
+    const float R = planet.radius();
+    float reach = 0.0f;
+    for (float rho : { range.lo, range.hi }) {
+        reach = std::max(reach, std::sqrt(std::max(0.0f, rho * rho + R * R - 2.0f * rho * R * minCos)));
+    }
+    b.radius = std::max({ reach, std::fabs(range.hi - R), std::fabs(R - range.lo) });
+    b.top = range.hi;
+    for (int k = 0; k < 3; ++k) b.center[k] = b.dir[k] * R;
+    return b;
+}
+
+// 지평선 뒤이거나 frustum 평면 하나라도 완전히 바깥이면 true
+bool TerrainLod::culled(const Bounds& b) const {
+    if (cameraDistance_ > 0.0f) {
+        float camDir[3] = { camera_.x / cameraDistance_, camera_.y / cameraDistance_, camera_.z / cameraDistance_ };
+        float c = std::max(-1.0f, std::min(1.0f, dot3(b.dir, camDir)));
+        if (std::acos(c) - b.angle > horizonAngle_) return true;
+    }
+    if (camera_.useFrustum) {
+        for (int p = 0; p < 6; ++p) {
+            const float* plane = frustum_ + p * 4;
+            if (dot3(plane, b.center) + plane[3] < -b.radius) return true;
+        }
+    }
+    return false;
+}
+
+// 패치 정점 간격이 화면에서 차지하는 픽셀 수 (경계 구에서 가장 가까운 점 기준)
+float TerrainLod::screenError(const Node& node, const Bounds& b, const PlanetGenerator& planet) const {
+    const float R = planet.radius();
+    float spacing = b.top * kHalfPi / (float(settings_.patchSegments) * float(1u << node.level));
+
+    float dx = camera_.x - b.center[0];
+    float dy = camera_.y - b.center[1];
+    float dz = camera_.z - b.center[2];
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - b.radius;
+    distance = std::max(distance, 1e-4f * R);
+    return spacing * pixelsPerUnit_ / distance;
+}
+
+bool TerrainLod::resident(const Node& node) const {
+    return resident_.find(key(node)) != resident_.end();
+}
+
+// 계산해 둔 노드면 자기 높이 범위, 아니면 fallback(부모의 범위)
+TerrainLod::HeightRange TerrainLod::rangeOf(const Node& node, const HeightRange& fallback) const {
+    auto found = resident_.find(key(node));
+    if (found != resident_.end() && slots_[found->second].hasRange) return slots_[found->second].range;
+    return fallback;
+}
+
+// 이번 프레임의 새 패치 예산에서 count개를 뺀다. (모자라면 빼지 않고 false)
+bool TerrainLod::reserve(int count) {
+    if (settings_.maxNewPatches == 0) return true;
+    if (budget_ < count) return false;
+    budget_ -= count;
+    return true;
+}
+
+void TerrainLod::allocate(const Node& node) {
+    uint32_t index;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+        Slot& fresh = slots_.back();
+        const size_t grid = static_cast<size_t>(settings_.patchSegments + 1) * (settings_.patchSegments + 1);
+        fresh.directions.resize(grid * 3);
+        fresh.terrain.resize(grid);
+        fresh.positions.resize(patchVertices_ * 3);
+        fresh.normals.resize(patchVertices_ * 3);
+        fresh.colors.resize(patchVertices_);
+    }
+
+    Slot& slot = slots_[index];
+    slot.node = node;
+    slot.used = true;
+    slot.directionsValid = false;
+    slot.terrain.invalidate();
+    slot.hasRange = false;
+    resident_[key(node)] = index;
+    pending_.push_back(index);
+}
+
+void TerrainLod::emit(const Node& node) {
+    uint32_t index = resident_.find(key(node))->second;
+    slots_[index].lastFrame = frame_;
+    visible_.push_back(index);
+}
+
+// --------------------------------------------------------------
+// visit
+// --------------------------------------------------------------
+// reserved : 부모가 이 노드 몫의 예산을 미리 잡아 둔 경우 true
+// range    : 부모의 높이 범위 (이 노드를 이미 계산했으면 자기 범위를 쓴다)
+//
+// 1) 화면 밖 / 지평선 뒤 → 아무것도 그리지 않는다.
+// 2) 더 나눠야 하고, 없는 자식들을 이번 프레임 예산으로 다 만들 수 있으면 → 자식으로 내려간다.
+//    나누기는 이 노드를 계산해서 자기 높이 범위를 안 뒤에만 한다.
+//    (부모의 넓은 범위로 판단하면 카메라 근처가 한 프레임에 maxDepth까지 나뉜다)
+//    그래서 한 프레임에 한 단계씩 내려간다.
+// 3) 아니면 이 노드를 그린다. 없으면 예산으로 만든다.
+// 4) 예산이 없으면: 자식이 모두 있으면 자식을 계속 그리고(합치기를 미룸),
+//    그것도 안 되면 예산을 넘겨서라도 만든다. (구멍을 내지 않기 위해)
+// --------------------------------------------------------------
+void TerrainLod::visit(const Node& node, const PlanetGenerator& planet, bool reserved, HeightRange range) {
+    auto found = resident_.find(key(node));
+    bool measured = found != resident_.end() && slots_[found->second].hasRange;
+    if (measured) range = slots_[found->second].range;
+
+    Bounds b = bounds(node, planet, range);
+    if (culled(b)) return;
+
+    Node kids[4];
+    bool kidVisible[4] = { false, false, false, false };
+    int missing = 0;
+    bool allKidsResident = node.level < settings_.maxDepth;
+    if (node.level < settings_.maxDepth) {
+        for (int k = 0; k < 4; ++k) {
+            kids[k] = { node.face, node.level + 1, node.x * 2 + (k & 1), node.y * 2 + (k >> 1) };
+            kidVisible[k] = !culled(bounds(kids[k], planet, rangeOf(kids[k], range)));
+            if (kidVisible[k] && !resident(kids[k])) {
+                ++missing;
+                allKidsResident = false;
+            }
+        }
+    }
+
+    bool wantSplit = measured && node.level < settings_.maxDepth &&
+                     screenError(node, b, planet) > settings_.errorPixels;
+    if (wantSplit && reserve(missing)) {
+        for (int k = 0; k < 4; ++k) {
+            if (kidVisible[k]) visit(kids[k], planet, !resident(kids[k]), range);
+        }
+        return;
+    }
+
+    if (resident(node)) {
+        emit(node);
+        return;
+    }
+    if (reserved || reserve(1)) {
+        allocate(node);
+        emit(node);
+        return;
+    }
+    if (allKidsResident) {
+        for (int k = 0; k < 4; ++k) {
+            if (kidVisible[k]) visit(kids[k], planet, false, range);
+        }
+        return;
+    }
+    allocate(node);
+    emit(node);
+}
+
+void TerrainLod::update(const LodCamera& camera, const PlanetGenerator& planet,
+                        const VertexPalette& palette, ThreadPool& pool) {
+    ++frame_;
+    visible_.clear();
+    created_.clear();
+    released_.clear();
+    pending_.clear();
+
+    camera_ = camera;
+    cameraDistance_ = std::sqrt(camera.x * camera.x + camera.y * camera.y + camera.z * camera.z);
+    pixelsPerUnit_ = camera.viewportHeight / (2.0f * std::tan(camera.fovY * 0.5f));
+
+    updateSurface(planet);
+
+    // 행성(가장 낮은 지형 구)에 가려지는 각: 카메라에서 지평선까지 + 지평선에서 가장 높은 지형까지
+    const float rMin = std::max(surface_.lo, 0.01f * planet.radius());
+    const float rMax = surface_.hi;
+    horizonAngle_ = cameraDistance_ > rMin
+        ? std::acos(rMin / cameraDistance_) + std::acos(std::min(1.0f, rMin / rMax))
+        : kPi;
+
+    budget_ = settings_.maxNewPatches;
+    for (int face = 0; face < 6; ++face) visit({ face, 0, 0, 0 }, planet, false, surface_);
+
+    generate(pending_, planet, palette, pool);
+    created_ = pending_;
+    evict();
+}
+
+void TerrainLod::regenerate(const PlanetGenerator& planet, const VertexPalette& palette, ThreadPool& pool) {
+    updateSurface(planet);
+    pending_.clear();
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].used) pending_.push_back(i);
+    }
+    generate(pending_, planet, palette, pool);
+    created_ = pending_;
+    released_.clear();
+}
+
+// 보이지 않는 패치가 cacheCapacity개를 넘으면 가장 오래전에 그린 것부터 버린다.
+void TerrainLod::evict() {
+    size_t hidden = resident_.size() - visible_.size();
+    size_t capacity = static_cast<size_t>(settings_.cacheCapacity);
+    if (hidden <= capacity) return;
+
+    std::vector<std::pair<uint64_t, uint32_t>> candidates;
+    candidates.reserve(hidden);
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].used && slots_[i].lastFrame != frame_) candidates.emplace_back(slots_[i].lastFrame, i);
+    }
+    size_t drop = hidden - capacity;
+    std::nth_element(candidates.begin(), candidates.begin() + (drop - 1), candidates.end());
+    for (size_t k = 0; k < drop; ++k) {
+        uint32_t index = candidates[k].second;
+        Slot& slot = slots_[index];
+        resident_.erase(key(slot.node));
+        slot.used = false;
+        freeSlots_.push_back(index);
+        released_.push_back(index);
+    }
+}
+
+void TerrainLod::generate(const std::vector<uint32_t>& slots, const PlanetGenerator& planet,
+                          const VertexPalette& palette, ThreadPool& pool) {
+    pool.parallelFor(slots.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) generateSlot(slots_[slots[i]], planet, palette);
+    });
+}
+
+// --------------------------------------------------------------
+// generateSlot
+// --------------------------------------------------------------
+// 1) 격자 방향 (처음 한 번, 노드가 바뀔 때만)
+// 2) 배치 높이 + 법선 (applyDisplacementSoA) / 색 (classifyColors)
+// 3) 스커트: 가장자리 정점을 중심 쪽으로 내린다.
+//    깊이 = 가장자리 이웃 정점 사이 높이 차의 2배 + 정점 간격
+//    (깊이가 다른 이웃 패치의 가장자리가 이 범위 안에서 어긋나므로)
+// --------------------------------------------------------------
+void TerrainLod::generateSlot(Slot& slot, const PlanetGenerator& planet, const VertexPalette& palette) const {
+    const int n = settings_.patchSegments;
+    const size_t grid = static_cast<size_t>(n + 1) * (n + 1);
+    float* xs = slot.directions.data();
+    float* ys = xs + grid;
+    float* zs = ys + grid;
+
+    if (!slot.directionsValid) {
+        const Node& node = slot.node;
+        const double size = 2.0 / double(1u << node.level);
+        const double u0 = -1.0 + node.x * size;
+        const double v0 = -1.0 + node.y * size;
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                float d[3];
+                cubeSphereDirection(node.face, u0 + size * i / n, v0 + size * j / n, d);
+                size_t idx = static_cast<size_t>(j) * (n + 1) + i;
+                xs[idx] = d[0];
+                ys[idx] = d[1];
+                zs[idx] = d[2];
+            }
+        }
+        slot.directionsValid = true;
+    }
+
+    float* positions = slot.positions.data();
+    float* normals = slot.normals.data();
+    uint32_t* colors = slot.colors.data();
+    const int stale = planet.staleLayers(slot.terrain);
+    if (stale) {
+        planet.sampleLayers(stale, xs, ys, zs, slot.terrain, 0, grid);
+        planet.markLayers(stale, slot.terrain);
+    }
+    planet.shapeLayers(xs, ys, zs, slot.terrain, positions, normals, 0, grid);
+    planet.classifyColors(positions, colors, grid, palette);
+
+    HeightRange range = { 1e30f, 0.0f };
+    for (size_t v = 0; v < grid; ++v) {
+        const float* p = positions + v * 3;
+        float r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        range.lo = std::min(range.lo, r);
+        range.hi = std::max(range.hi, r);
+    }
+    slot.range = range;
+    slot.hasRange = true;
+
+    const size_t ring = perimeter_.size();
+    auto radiusAt = [&](uint32_t v) {
+        const float* p = positions + v * 3;
+        return std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    };
+    float maxDelta = 0.0f;
+    for (size_t k = 0; k < ring; ++k) {
+        maxDelta = std::max(maxDelta, std::fabs(radiusAt(perimeter_[k]) - radiusAt(perimeter_[(k + 1) % ring])));
+    }
+    const float spacing = planet.radius() * kHalfPi / (float(n) * float(1u << slot.node.level));
+    const float depth = 2.0f * maxDelta + spacing;
+
+    for (size_t k = 0; k < ring; ++k) {
+        uint32_t src = perimeter_[k];
+        size_t dst = grid + k;
+        float r = radiusAt(src);
+        float s = r > depth ? (r - depth) / r : 0.0f;
+        for (int c = 0; c < 3; ++c) {
+            positions[dst * 3 + c] = positions[src * 3 + c] * s;
+            normals[dst * 3 + c] = normals[src * 3 + c];
+        }
+        colors[dst] = colors[src];
+    }
+}
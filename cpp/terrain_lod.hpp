@@ -0,0 +1,171 @@
+#pragma once
+#include "planet.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// terrain_lod.hpp
+// -------------------------------------------------------------
+// TerrainLod: 정육면체 면 6개 위의 quadtree로 행성을 패치(patch) 단위로 나눠 그리는 LOD.
+//
+//   - 면마다 quadtree의 노드 하나 = 패치 하나. 패치는 모두 같은 크기의 격자
+//     (patchSegments x patchSegments 칸)라서 깊이가 1 늘 때마다 정점 간격이 절반이 된다.
+//   - 매 프레임 update(카메라)로 트리를 내려가며
+//       · 지평선 뒤(행성에 가려짐) / 화면 밖(frustum) 노드는 건너뛰고
+//       · 정점 간격이 화면에서 errorPixels보다 크게 보이면 네 자식으로 나눈다(split).
+//     나누지 않은 노드가 이번 프레임에 그릴 패치(visible)이다.
+//     노드는 자기 정점을 계산해 높이 범위를 안 뒤에만 나누므로, 한 프레임에 한 단계씩 내려간다.
+//   - 패치 정점은 PlanetGenerator::applyDisplacementSoA(배치 높이 + 법선)와
+//     classifyColors로 만들고, 새로 만들 패치들은 ThreadPool로 나눠 계산한다.
+//   - 한 프레임에 새로 만드는 패치 수는 maxNewPatches로 제한한다.
+//     자식이 아직 없으면 부모를 계속 그리고, 부모가 없으면 자식을 계속 그린다. (구멍 없음)
+//   - 보이지 않게 된 패치는 cacheCapacity개까지 들고 있다가 오래된 것부터 버린다.
+//     → 메모리 / 계산량은 전체 행성 해상도가 아니라 화면에 보이는 패치 수에 비례한다.
+//
+// 패치 하나의 정점 = 격자 (n+1)² + 가장자리 스커트(skirt) 4n.
+// 스커트는 가장자리 정점을 안쪽(아래)으로 내린 띠로, 깊이가 다른 이웃 패치 사이의 틈을 가린다.
+// 모든 패치가 같은 배치라서 index 버퍼는 하나(indices())를 같이 쓴다.
+//
+// JS에는 슬롯(slot) 번호로 결과를 알려 준다.
+//   visible  : 이번 프레임에 그릴 슬롯
+//   created  : 내용이 새로 계산된 슬롯 (GPU에 다시 올려야 함)
+//   released : 버려진 슬롯 (나중에 다른 패치가 같은 번호를 다시 쓸 수 있음)
+// -------------------------------------------------------------
+struct LodSettings {
+    int patchSegments = 32;   // 패치 한 변의 칸 수
+    int maxDepth = 12;        // quadtree 최대 깊이 (0 = 면 하나가 패치 하나)
+    float errorPixels = 4.0f; // 정점 간격이 화면에서 이보다 크게 보이면 나눈다
+    int maxNewPatches = 32;   // 한 프레임에 새로 만들 패치 수 (0이면 제한 없음)
+    int cacheCapacity = 256;  // 보이지 않아도 들고 있을 패치 수
+};
+
+// 카메라 (행성 좌표계)
+struct LodCamera {
+    float x, y, z;         // 카메라 위치
+    float fovY;            // 세로 시야각 (라디안)
+    float viewportHeight;  // 화면 높이 (픽셀)
+    bool useFrustum;       // true면 frustumPlanes()의 평면 6개로 화면 밖 패치를 뺀다
+};
+
+class TerrainLod {
+public:
+    TerrainLod();
+
+    // 설정을 바꾸고 모든 패치를 버린다. (released에 알리지 않으므로 JS도 모든 패치를 버려야 한다)
+    void configure(const LodSettings& settings);
+    const LodSettings& settings() const { return settings_; }
+
+    // 평면 6개 [nx, ny, nz, d] x 6 (행성 좌표계, 안쪽이 nx*x + ny*y + nz*z + d >= 0)
+    float* frustumPlanes() { return frustum_; }
+
+    // 카메라로 그릴 패치를 다시 정하고, 필요한 패치를 만든다.
+    void update(const LodCamera& camera, const PlanetGenerator& planet,
+                const VertexPalette& palette, ThreadPool& pool);
+
+    // 들고 있는 모든 패치를 planet으로 다시 계산한다. (seed / scale / radius / 노이즈 / 색이 바뀌었을 때)
+    // 다시 계산한 슬롯은 created에 들어간다.
+    // 패치마다 층별 지형 캐시(TerrainLayerCache)를 들고 있어서 모양이 바뀐 층만 다시 계산하고,
+    // 강도 / scale / radius만 바뀌었으면 노이즈 없이 섞기만 다시 한다.
+    void regenerate(const PlanetGenerator& planet, const VertexPalette& palette, ThreadPool& pool);
+
+    const std::vector<uint32_t>& visible() const { return visible_; }
+    const std::vector<uint32_t>& created() const { return created_; }
+    const std::vector<uint32_t>& released() const { return released_; }
+    size_t residentCount() const { return resident_.size(); }
+
+    // 패치 하나의 정점 수 / 공유 index 버퍼
+    size_t patchVertexCount() const { return patchVertices_; }
+    const std::vector<uint32_t>& indices() const { return indices_; }
+
+    // 슬롯의 정점 데이터 ([x, y, z, ...] / [nx, ny, nz, ...] / RGBA8)
+    // 슬롯이 다시 쓰여도 주소는 그대로다.
+    float* positions(uint32_t slot) { return slots_[slot].positions.data(); }
+    float* normals(uint32_t slot) { return slots_[slot].normals.data(); }
+    uint32_t* colors(uint32_t slot) { return slots_[slot].colors.data(); }
+    size_t slotCount() const { return slots_.size(); }
+
+private:
+    struct Node {
+        int face;
+        int level;
+        uint32_t x, y;  // 이 깊이의 격자 안 위치 (0 .. 2^level - 1)
+    };
+
+    // 패치 표면이 중심에서 떨어진 거리의 범위 [lo, hi]
+    // 계산한 패치는 자기 정점에서 재고, 아직 없는 패치는 부모의 범위를 물려받는다.
+    struct HeightRange {
+        float lo, hi;
+    };
+
+    struct Bounds {
+        float center[3];  // 패치 가운데 방향 * radius
+        float radius;     // center에서 패치 전체(지형 높이 포함)를 감싸는 반지름
+        float dir[3];     // 패치 가운데 방향 (단위)
+        float angle;      // 가운데 방향과 모서리 방향 사이의 최대 각
+        float top;        // 가장 높은 지형까지의 거리 (HeightRange::hi)
+    };
+
+    struct Slot {
+        Node node{};
+        bool used = false;
+        bool directionsValid = false;   // directions가 node의 격자와 맞는지
+        bool hasRange = false;          // range를 잰 뒤인지 (계산 전이면 false)
+        HeightRange range{};
+        uint64_t lastFrame = 0;         // 마지막으로 그린 프레임 (캐시에서 버릴 순서)
+        std::vector<float> directions;  // 격자 정점 방향 SoA (xs | ys | zs)
+        TerrainLayerCache terrain;      // 격자 정점의 층별 지형 캐시
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<uint32_t> colors;
+    };
+
+    static uint64_t key(const Node& node);
+    void buildIndices();
+    void updateSurface(const PlanetGenerator& planet);
+    HeightRange rangeOf(const Node& node, const HeightRange& fallback) const;
+    Bounds bounds(const Node& node, const PlanetGenerator& planet, const HeightRange& range) const;
+    bool culled(const Bounds& b) const;
+    float screenError(const Node& node, const Bounds& b, const PlanetGenerator& planet) const;
+
+    void visit(const Node& node, const PlanetGenerator& planet, bool reserved, HeightRange range);
+    bool resident(const Node& node) const;
+    bool reserve(int count);
+    void allocate(const Node& node);
+    void emit(const Node& node);
+    void evict();
+    void generate(const std::vector<uint32_t>& slots, const PlanetGenerator& planet,
+                  const VertexPalette& palette, ThreadPool& pool);
+    void generateSlot(Slot& slot, const PlanetGenerator& planet, const VertexPalette& palette) const;
+
+    LodSettings settings_;
+    size_t patchVertices_ = 0;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> perimeter_;  // 가장자리 격자 정점 (스커트 순서)
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<uint64_t, uint32_t> resident_;  // 노드 key → 슬롯
+
+    std::vector<uint32_t> visible_;
+    std::vector<uint32_t> created_;
+    std::vector<uint32_t> released_;
+    std::vector<uint32_t> pending_;    // 이번에 계산할 슬롯
+
+    // update 한 번 동안 쓰는 값
+    uint64_t frame_ = 0;
+    int budget_ = 0;
+    LodCamera camera_{};
+    float cameraDistance_ = 0.0f;
+    float pixelsPerUnit_ = 0.0f;   // 거리 1에서 길이 1이 화면에서 차지하는 픽셀 수
+    float horizonAngle_ = 0.0f;    // 카메라에서 보이는 최대 각 (이보다 멀면 지평선 뒤)
+    float frustum_[24];
+
+    // 행성 전체 높이 범위 (updateSurface)
+    // 표본 높이는 scale = 1로 지형 번호마다 한 번만 재고(surfaceUnit_),
+    // surface_는 거기에 지금 scale / radius를 적용한 값이다.
+    HeightRange surface_{};
+    HeightRange surfaceUnit_{};
+    uint64_t surfaceRevision_ = 0;
+};
@@ -0,0 +1,130 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    resize(threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+unsigned ThreadPool::hardwareThreads() {
+#if PLANET_HAS_THREADS
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+#else
+    return 1;
+#endif
+}
+
+void ThreadPool::resize(unsigned threadCount) {
+    std::lock_guard<std::mutex> run(runMutex_);
+    stop();
+#if PLANET_HAS_THREADS
+    threadCount_ = std::max(1u, threadCount);
+#ifdef PLANET_MAX_THREADS
+    threadCount_ = std::min(threadCount_, static_cast<unsigned>(PLANET_MAX_THREADS));
+#endif
+#else
+    (void)threadCount;
+    threadCount_ = 1;
+#endif
+    slots_.reset(new Slot[threadCount_]);
+    start();
+}
+
+// 작업 스레드 만들기 (0번 자리는 parallelFor를 부른 스레드가 쓴다)
+// 새 스레드는 지금까지의 작업 번호(generation_)를 이미 본 것으로 시작해야
+// 예전 작업을 다시 실행하지 않는다.
+void ThreadPool::start() {
+    stopping_ = false;
+    for (unsigned i = 1; i < threadCount_; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i, generation_);
+    }
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) t.join();
+    workers_.clear();
+}
+
+void ThreadPool::workerLoop(unsigned self, uint64_t seen) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+
+        runChunks(self);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+}
+
+// --------------------------------------------------------------
+// runChunks
+// --------------------------------------------------------------
+// 자기 자리(self)의 조각을 앞에서부터 하나씩 가져가 계산하고,
+// 다 끝나면 다음 자리들을 차례로 돌며 남은 조각을 가져간다.
+// 조각을 가져가는 것은 next.fetch_add 한 번이라서 잠금이 없고,
+// 같은 조각을 두 스레드가 가져가는 일은 없다.
+// --------------------------------------------------------------
+void ThreadPool::runChunks(unsigned self) {
+    for (unsigned k = 0; k < threadCount_; ++k) {
+        Slot& slot = slots_[(self + k) % threadCount_];
+        for (;;) {
+            size_t chunk = slot.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= slot.end) break;
+            size_t begin = chunk * grain_;
+            size_t end = std::min(begin + grain_, count_);
+            (*job_)(begin, end);
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+    size_t chunks = (count + grain - 1) / grain;
+
+    // 한 스레드이거나 조각이 하나뿐이면 바로 계산
+    if (threadCount_ == 1 || chunks == 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(runMutex_);
+
+    // 조각들을 스레드 수만큼 연속된 덩어리로 나눠 둔다.
+    for (unsigned i = 0; i < threadCount_; ++i) {
+        slots_[i].next.store(chunks * i / threadCount_, std::memory_order_relaxed);
+        slots_[i].end = chunks * (i + 1) / threadCount_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        count_ = count;
+        grain_ = grain;
+        pending_ = threadCount_ - 1;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+    job_ = nullptr;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// thread_pool.hpp
+// -------------------------------------------------------------
+// ThreadPool: 정점 배열처럼 “서로 독립적인 구간”을 여러 스레드로 나눠 계산하는 풀.
+//
+// parallelFor(count, grain, fn)
+//   - [0, count)를 grain 크기의 조각(chunk)으로 자른다.
+//   - 조각들을 스레드마다 연속된 덩어리로 먼저 나눠 주고,
+//     자기 몫을 다 끝낸 스레드는 다른 스레드의 남은 조각을 가져간다(work stealing).
+//     → 지형이 복잡한 구간이 한 스레드에 몰려도 다른 스레드가 도와준다.
+//   - 조각 하나는 항상 한 스레드가 통째로 계산하고, 결과는 그 조각의 입력에만 의존한다.
+//     그래서 스레드 수나 가져가는 순서가 달라도 결과는 항상 같다.
+//
+// 부른 스레드(caller)도 계산에 참여하므로 threadCount = 1이면 스레드를 만들지 않는다.
+// WASM을 pthread 없이 빌드하면 PLANET_HAS_THREADS가 0이 되어 항상 한 스레드로 동작한다.
+// -------------------------------------------------------------
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define PLANET_HAS_THREADS 0
+#else
+#define PLANET_HAS_THREADS 1
+#endif
+
+// WASM pthread 빌드의 최대 스레드 수.
+// 브라우저에서는 미리 만들어 둔 Worker(PTHREAD_POOL_SIZE)보다 많은 스레드를 만들면
+// 메인 스레드가 기다리는 동안 새 Worker가 뜨지 못해 멈춘다.
+// build.sh의 PTHREAD_POOL_SIZE(최대 16)와 맞춰 둔다.
+#if defined(__EMSCRIPTEN_PTHREADS__) && !defined(PLANET_MAX_THREADS)
+#define PLANET_MAX_THREADS 16
+#endif
+
+class ThreadPool {
+public:
+    // fn(begin, end) : [begin, end) 구간을 계산하는 함수
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // threadCount : 계산에 참여할 스레드 수 (부른 스레드 포함, 0이면 1로 본다)
+    explicit ThreadPool(unsigned threadCount = 1);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 스레드 수를 바꾼다. (기존 작업 스레드는 정리하고 새로 만든다)
+    // 다른 스레드가 parallelFor를 부르는 도중에는 부르지 않는다.
+    void resize(unsigned threadCount);
+    unsigned threadCount() const { return threadCount_; }
+
+    // [0, count)를 grain 단위 조각으로 나눠 모든 스레드가 fn을 부른다.
+    // 모든 조각이 끝나야 돌아온다. 여러 스레드가 동시에 불러도 하나씩 차례로 처리한다.
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+    // 기본으로 쓸 스레드 수 (하드웨어 스레드 수, 알 수 없으면 1)
+    static unsigned hardwareThreads();
+
+private:
+    // 스레드 하나가 맡은 조각 범위 [next, end)
+    // 다른 스레드도 next를 가져가므로(steal) atomic이고,
+    // 서로 다른 캐시 라인에 두어 false sharing을 막는다.
+    struct alignas(64) Slot {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    void start();
+    void stop();
+    void workerLoop(unsigned self, uint64_t seen);
+    void runChunks(unsigned self);
+
+    unsigned threadCount_ = 1;
+    std::vector<std::thread> workers_;
+    std::unique_ptr<Slot[]> slots_;
+
+    std::mutex runMutex_;              // parallelFor를 한 번에 하나씩
+    std::mutex mutex_;
+    std::condition_variable wake_;     // 새 작업 알림
+    std::condition_variable done_;     // 작업 스레드가 모두 끝났음 알림
+    uint64_t generation_ = 0;          // 작업 번호 (바뀌면 새 작업)
+    unsigned pending_ = 0;             // 아직 끝나지 않은 작업 스레드 수
+    bool stopping_ = false;
+
+    // 현재 작업
+    const RangeFn* job_ = nullptr;
+    size_t count_ = 0;
+    size_t grain_ = 1;
+};
@@ -0,0 +1,397 @@
+#include "tile_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = { 'M', 'L', 'P', 'T' };
+const uint32_t kFormat = 1;
+const char kSuffix[] = ".tile";
+
+// 타일 파일 앞 64바이트. float 배열이 바로 뒤에 온다. (little-endian)
+struct TileHeader {
+    char magic[4];
+    uint32_t format;
+    uint64_t hash;
+    uint32_t seed;
+    float scale;
+    float radius;
+    uint32_t content;
+    uint32_t topology;
+    uint32_t resolution;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t terrainHash;
+    uint64_t floatCount;
+};
+static_assert(sizeof(TileHeader) == 64, "TileHeader must stay 64 bytes");
+
+// FNV-1a 64
+struct Fnv {
+    uint64_t h = 1469598103934665603ull;
+    void bytes(const void* p, size_t n) {
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 1099511628211ull;
+        }
+    }
+    void u32(uint32_t v) { bytes(&v, sizeof(v)); }
+    void u64(uint64_t v) { bytes(&v, sizeof(v)); }
+    void f32(float v) { bytes(&v, sizeof(v)); } // 비트 그대로 (0.5와 0.50000006은 다른 키)
+};
+
+TileKey keyOf(const TileHeader& h) {
+    TileKey k;
+    k.seed = h.seed;
+    k.scale = h.scale;
+    k.radius = h.radius;
+    k.content = h.content;
+    k.topology = h.topology;
+    k.resolution = h.resolution;
+    k.version = h.version;
+    k.terrainHash = h.terrainHash;
+    return k;
+}
+
+// 같은 디렉터리에 동시에 만드는 .tmp 파일 이름이 겹치지 않게 붙이는 번호
+std::atomic<uint64_t> g_tmpCounter{0};
+
+} // namespace
+
+// --------------------------------------------------------------
+// TileKey
+// --------------------------------------------------------------
+uint64_t TileKey::hash() const {
+    Fnv f;
+    f.u32(seed);
+    f.f32(scale);
+    f.f32(radius);
+    f.u32(content);
+    f.u32(topology);
+    f.u32(resolution);
+    f.u32(version);
+    f.u64(terrainHash);
+    return f.h;
+}
+
+bool TileKey::operator==(const TileKey& o) const {
+    // float도 비트로 비교한다. (hash와 같은 기준)
+    return seed == o.seed && std::memcmp(&scale, &o.scale, sizeof(float)) == 0 &&
+           std::memcmp(&radius, &o.radius, sizeof(float)) == 0 && content == o.content &&
+           topology == o.topology && resolution == o.resolution && version == o.version &&
+           terrainHash == o.terrainHash;
+}
+
+bool makeTileKey(const PlanetGenerator& generator, TileContent content, uint32_t topology,
+                 uint32_t resolution, TileKey& key) {
+    if (generator.previewEnabled()) return false;
+
+    const NoiseParams& p = generator.params();
+    Fnv f;
+    f.f32(p.macroFreq); f.u32(static_cast<uint32_t>(p.macroOctaves)); f.f32(p.macroAmp);
+    f.f32(p.microFreq); f.u32(static_cast<uint32_t>(p.microOctaves)); f.f32(p.microAmp);
+    f.f32(p.ridgeFreq); f.u32(static_cast<uint32_t>(p.ridgeOctaves)); f.f32(p.ridgeAmp);
+    f.f32(p.lacunarity); f.f32(p.gain);
+    f.u32(static_cast<uint32_t>(p.macroBasis));
+    f.u32(static_cast<uint32_t>(p.microBasis));
+    f.u32(static_cast<uint32_t>(p.ridgeBasis));
+    f.u32(static_cast<uint32_t>(generator.noiseBackend()));
+
+    key.seed = generator.seed();
+    key.scale = generator.scale();
+    key.radius = generator.radius();
+    key.content = static_cast<uint32_t>(content);
+    key.topology = topology;
+    key.resolution = resolution;
+    key.version = kTerrainVersion;
+    key.terrainHash = f.h;
+    return true;
+}
+
+// --------------------------------------------------------------
+// MappedTile / TileWriter
+// --------------------------------------------------------------
+MappedTile::~MappedTile() { reset(); }
+
+MappedTile::MappedTile(MappedTile&& other) noexcept
+    : base_(other.base_), mappedBytes_(other.mappedBytes_), floatCount_(other.floatCount_) {
+    other.base_ = nullptr;
+    other.mappedBytes_ = other.floatCount_ = 0;
+}
+
+MappedTile& MappedTile::operator=(MappedTile&& other) noexcept {
+    if (this != &other) {
+        reset();
+        std::swap(base_, other.base_);
+        std::swap(mappedBytes_, other.mappedBytes_);
+        std::swap(floatCount_, other.floatCount_);
+    }
+    return *this;
+}
+
+const float* MappedTile::data() const {
+    return base_ ? reinterpret_cast<const float*>(static_cast<const char*>(base_) + sizeof(TileHeader)) : nullptr;
+}
+
+void MappedTile::reset() {
+    if (base_) munmap(base_, mappedBytes_);
+    base_ = nullptr;
+    mappedBytes_ = floatCount_ = 0;
+}
+
+TileWriter::~TileWriter() { reset(); }
+
+TileWriter::TileWriter(TileWriter&& other) noexcept
+    : base_(other.base_), mappedBytes_(other.mappedBytes_), floatCount_(other.floatCount_),
+      tmpPath_(std::move(other.tmpPath_)), path_(std::move(other.path_)), hash_(other.hash_) {
+    other.base_ = nullptr;
+    other.mappedBytes_ = other.floatCount_ = 0;
+}
+
+TileWriter& TileWriter::operator=(TileWriter&& other) noexcept {
+    if (this != &other) {
+        reset();
+        std::swap(base_, other.base_);
+        std::swap(mappedBytes_, other.mappedBytes_);
+        std::swap(floatCount_, other.floatCount_);
+        std::swap(tmpPath_, other.tmpPath_);
+        std::swap(path_, other.path_);
+        std::swap(hash_, other.hash_);
+    }
+    return *this;
+}
+
+float* TileWriter::data() {
+    return base_ ? reinterpret_cast<float*>(static_cast<char*>(base_) + sizeof(TileHeader)) : nullptr;
+}
+
+// commit하지 않은 타일은 버린다.
+void TileWriter::reset() {
+    if (base_) {
+        munmap(base_, mappedBytes_);
+        unlink(tmpPath_.c_str());
+    }
+    base_ = nullptr;
+    mappedBytes_ = floatCount_ = 0;
+}
+
+// --------------------------------------------------------------
+// TileCache
+// --------------------------------------------------------------
+TileCache::TileCache(const std::string& directory, uint64_t budgetBytes)
+    : directory_(directory), budgetBytes_(budgetBytes) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    ok_ = !ec && std::filesystem::is_directory(directory_, ec);
+    if (ok_) scan();
+}
+
+std::string TileCache::pathFor(uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(hash), kSuffix);
+    return directory_ + "/" + name;
+}
+
+// 타일 파일을 읽기용으로 mmap한다. expected가 있으면 헤더의 키도 비교한다.
+MappedTile TileCache::mapTile(const std::string& path, const TileKey* expected) {
+    MappedTile tile;
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return tile;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(TileHeader)) {
+        close(fd);
+        return tile;
+    }
+    const size_t bytes = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // 매핑은 fd를 닫아도 남는다
+    if (base == MAP_FAILED) return tile;
+
+    const TileHeader* h = static_cast<const TileHeader*>(base);
+    const bool valid = std::memcmp(h->magic, kMagic, 4) == 0 && h->format == kFormat &&
+                       sizeof(TileHeader) + h->floatCount * sizeof(float) == bytes &&
+                       (!expected || keyOf(*h) == *expected);
+    if (!valid) {
+        munmap(base, bytes);
+        return tile;
+    }
+    tile.base_ = base;
+    tile.mappedBytes_ = bytes;
+    tile.floatCount_ = static_cast<size_t>(h->floatCount);
+    return tile;
+}
+
+MappedTile TileCache::lookup(const TileKey& key) {
+    if (!ok_) return MappedTile();
+    const uint64_t hash = key.hash();
+    const std::string path = pathFor(hash);
+    MappedTile tile = mapTile(path, &key);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!tile.valid()) {
+        ++stats_.misses;
+        return tile;
+    }
+    ++stats_.hits;
+    // 다른 프로세스가 넣은 타일이면 여기서 처음 알게 된다.
+    Entry& e = entries_[hash];
+    e.bytes = tile.mappedBytes_;
+    e.lastUse = ++clock_;
+    // 다음 실행의 scan이 사용 순서를 이어받도록 수정 시각을 지금으로 바꾼다.
+    utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    return tile;
+}
+
+TileWriter TileCache::create(const TileKey& key, size_t floatCount) {
+    TileWriter writer;
+    if (!ok_) return writer;
+
+    const uint64_t hash = key.hash();
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), ".%ld.%llu.tmp", static_cast<long>(getpid()),
+                  static_cast<unsigned long long>(g_tmpCounter.fetch_add(1)));
+    const std::string path = pathFor(hash);
+    const std::string tmpPath = path + suffix;
+    const size_t bytes = sizeof(TileHeader) + floatCount * sizeof(float);
+
+    const int fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return writer;
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+        base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) {
+        unlink(tmpPath.c_str());
+        return writer;
+    }
+
+    TileHeader* h = static_cast<TileHeader*>(base);
+    std::memcpy(h->magic, kMagic, 4);
+    h->format = kFormat;
+    h->hash = hash;
+    h->seed = key.seed;
+    h->scale = key.scale;
+    h->radius = key.radius;
+    h->content = key.content;
+    h->topology = key.topology;
+    h->resolution = key.resolution;
+    h->version = key.version;
+    h->reserved = 0;
+    h->terrainHash = key.terrainHash;
+    h->floatCount = floatCount;
+
+    writer.base_ = base;
+    writer.mappedBytes_ = bytes;
+    writer.floatCount_ = floatCount;
+    writer.tmpPath_ = tmpPath;
+    writer.path_ = path;
+    writer.hash_ = hash;
+    return writer;
+}
+
+MappedTile TileCache::commit(TileWriter& writer) {
+    if (!writer.valid()) return MappedTile();
+
+    const uint64_t bytes = writer.mappedBytes_;
+    const uint64_t hash = writer.hash_;
+    const std::string path = writer.path_;
+    munmap(writer.base_, writer.mappedBytes_);
+    writer.base_ = nullptr;
+    const bool renamed = std::rename(writer.tmpPath_.c_str(), path.c_str()) == 0;
+    if (!renamed) unlink(writer.tmpPath_.c_str());
+    writer.reset();
+    if (!renamed) return MappedTile();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& e = entries_[hash];
+        e.bytes = bytes;
+        e.lastUse = ++clock_;
+        ++stats_.stores;
+        evict(&hash);
+    }
+    return mapTile(path, nullptr);
+}
+
+TileCache::Stats TileCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = stats_;
+    s.tiles = entries_.size();
+    s.diskBytes = 0;
+    for (const auto& kv : entries_) s.diskBytes += kv.second.bytes;
+    return s;
+}
+
+// 디렉터리의 타일을 수정 시각이 오래된 순서로 사용 순서에 넣는다.
+void TileCache::scan() {
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) return;
+
+    struct Found {
+        int64_t mtime; // ns
+        uint64_t hash;
+        uint64_t bytes;
+        bool operator<(const Found& o) const { return mtime < o.mtime; }
+    };
+    std::vector<Found> found;
+    const size_t suffixLength = sizeof(kSuffix) - 1;
+    while (dirent* d = readdir(dir)) {
+        const size_t length = std::strlen(d->d_name);
+        if (length != 16 + suffixLength || std::strcmp(d->d_name + 16, kSuffix) != 0) continue;
+        char* end = nullptr;
+        const uint64_t hash = std::strtoull(d->d_name, &end, 16);
+        if (end != d->d_name + 16) continue;
+
+        struct stat st;
+        if (stat((directory_ + "/" + d->d_name).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        const int64_t mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000ll + st.st_mtim.tv_nsec;
+        found.push_back({ mtime, hash, static_cast<uint64_t>(st.st_size) });
+    }
+    closedir(dir);
+
+    std::sort(found.begin(), found.end());
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& f : found) {
+        Entry& e = entries_[f.hash];
+        e.bytes = f.bytes;
+        e.lastUse = ++clock_;
+    }
+    evict(nullptr);
+}
+
+// 전체 크기가 예산을 넘으면 가장 오래전에 쓴 타일부터 지운다. (mutex_를 잡은 채로 부른다)
+void TileCache::evict(const uint64_t* keep) {
+    uint64_t total = 0;
+    for (const auto& kv : entries_) total += kv.second.bytes;
+    if (total <= budgetBytes_) return;
+
+    std::vector<std::pair<uint64_t, uint64_t>> candidates; // (lastUse, hash)
+    candidates.reserve(entries_.size());
+    for (const auto& kv : entries_) {
+        if (!keep || kv.first != *keep) candidates.emplace_back(kv.second.lastUse, kv.first);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& c : candidates) {
+        if (total <= budgetBytes_) break;
+        auto it = entries_.find(c.second);
+        unlink(pathFor(c.second).c_str());
+        total -= it->second.bytes;
+        entries_.erase(it);
+        ++stats_.evictions;
+    }
+}
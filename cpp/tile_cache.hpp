@@ -0,0 +1,156 @@
+#pragma once
+#include "planet.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// tile_cache.hpp
+// -------------------------------------------------------------
+// TileCache: 만들어 둔 높이 / 위치를 디스크에 남겨 두는 캐시. (네이티브 전용, POSIX mmap)
+//
+// init_planet + 배치 변형은 입력이 같으면 결과도 항상 같으므로,
+// 같은 행성을 다시 요청받으면 노이즈를 다시 계산하는 대신 저장해 둔 타일을 mmap해서 읽는다.
+// (자주 찾는 행성은 OS 페이지 캐시에 남아 있어서 메모리를 읽는 것과 같다)
+//
+// 키(TileKey): 결과를 바꿀 수 있는 입력 전부
+//   seed / scale / radius / NoiseParams 전체(override 포함) / 노이즈 방식 /
+//   내용 종류 / 메쉬 토폴로지와 해상도 / kTerrainVersion
+// 파일 이름은 키 해시(<hash>.tile)이고, 헤더에 키 전체를 적어 두어 읽을 때 다시 비교한다.
+// (해시가 겹치거나 다른 버전이 쓴 파일이면 없는 것으로 본다)
+//
+// 타일 파일 = 고정 헤더 64바이트(TileHeader) + float 배열
+// 새 타일은 .tmp 파일을 원래 크기로 만들어 쓰기용으로 mmap한 뒤(TileWriter),
+// 다 채우면 이름을 바꿔 넣는다. → 읽는 쪽은 반쯤 쓴 타일을 보지 않는다.
+//
+// 디스크 예산(budgetBytes)을 넘으면 가장 오래전에 쓴 타일부터 지운다. (LRU)
+//   - 열 때 디렉터리를 훑어 파일 수정 시각 순서로 사용 순서를 정하고,
+//     찾을 때마다(hit) 수정 시각을 지금으로 바꿔 다음 실행에도 순서가 이어지게 한다.
+//   - 지운 타일을 누가 mmap하고 있어도 매핑은 닫을 때까지 유효하다. (POSIX unlink)
+// 한 TileCache 안의 함수들은 여러 스레드에서 불러도 된다. (내부 mutex)
+// 여러 프로세스가 같은 디렉터리를 쓰면 서로의 예산 계산은 모르지만 파일이 깨지지는 않는다.
+// -------------------------------------------------------------
+
+// 타일에 담는 내용
+enum class TileContent : uint32_t {
+    Heights = 0,          // 정점 / 화소마다 높이 1개 (get_height 값)
+    Positions = 1,        // 정점마다 [x, y, z]
+    PositionsNormals = 2, // 정점마다 [x, y, z, nx, ny, nz]
+};
+
+struct TileKey {
+    uint32_t seed = 0;
+    float scale = 0.0f;
+    float radius = 0.0f;
+    uint32_t content = 0;    // TileContent
+    uint32_t topology = 0;   // 메쉬 / 격자 종류 (호출하는 쪽이 정한 번호, 예: SphereMeshKind)
+    uint32_t resolution = 0; // 메쉬 분할 수 / 격자 크기
+    uint32_t version = 0;    // kTerrainVersion
+    uint64_t terrainHash = 0; // NoiseParams 전체 + 노이즈 방식
+
+    uint64_t hash() const;
+    bool operator==(const TileKey& other) const;
+};
+
+// generator의 지금 상태로 키를 만든다.
+// 미리보기 모드(근사값)에서는 캐시하지 않으므로 false를 돌려준다.
+bool makeTileKey(const PlanetGenerator& generator, TileContent content, uint32_t topology,
+                 uint32_t resolution, TileKey& key);
+
+// 읽기용 매핑 (움직일 수만 있고, 사라질 때 munmap)
+class MappedTile {
+public:
+    MappedTile() = default;
+    ~MappedTile();
+    MappedTile(MappedTile&& other) noexcept;
+    MappedTile& operator=(MappedTile&& other) noexcept;
+    MappedTile(const MappedTile&) = delete;
+    MappedTile& operator=(const MappedTile&) = delete;
+
+    bool valid() const { return base_ != nullptr; }
+    const float* data() const;
+    size_t floatCount() const { return floatCount_; }
+
+private:
+    friend class TileCache;
+    void reset();
+    void* base_ = nullptr;
+    size_t mappedBytes_ = 0;
+    size_t floatCount_ = 0;
+};
+
+// 새 타일 쓰기용 매핑 (TileCache::create로 만들고 TileCache::commit으로 넣는다)
+// commit하지 않고 사라지면 .tmp 파일을 지운다.
+class TileWriter {
+public:
+    TileWriter() = default;
+    ~TileWriter();
+    TileWriter(TileWriter&& other) noexcept;
+    TileWriter& operator=(TileWriter&& other) noexcept;
+    TileWriter(const TileWriter&) = delete;
+    TileWriter& operator=(const TileWriter&) = delete;
+
+    bool valid() const { return base_ != nullptr; }
+    float* data();
+    size_t floatCount() const { return floatCount_; }
+
+private:
+    friend class TileCache;
+    void reset();
+    void* base_ = nullptr;
+    size_t mappedBytes_ = 0;
+    size_t floatCount_ = 0;
+    std::string tmpPath_;
+    std::string path_;
+    uint64_t hash_ = 0;
+};
+
+class TileCache {
+public:
+    // directory가 없으면 만들고, 들어 있는 타일을 훑어 사용 순서 / 크기를 읽는다.
+    TileCache(const std::string& directory, uint64_t budgetBytes);
+
+    // 디렉터리를 쓸 수 있으면 true (false면 lookup은 항상 없음, create는 항상 실패)
+    bool ok() const { return ok_; }
+
+    // key의 타일이 있으면 읽기용으로 mmap해서 돌려준다. (없거나 깨졌으면 valid() == false)
+    MappedTile lookup(const TileKey& key);
+
+    // key의 새 타일(float floatCount개)을 만든다. data()를 채운 뒤 commit을 부른다.
+    TileWriter create(const TileKey& key, size_t floatCount);
+
+    // writer의 타일을 캐시에 넣고, 예산을 넘으면 오래된 타일을 지운다.
+    // 성공하면 writer는 비고, 같은 타일을 읽기용으로 다시 열어 돌려준다.
+    MappedTile commit(TileWriter& writer);
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+        uint64_t diskBytes = 0;
+        size_t tiles = 0;
+    };
+    Stats stats() const;
+
+private:
+    struct Entry {
+        uint64_t bytes = 0;
+        uint64_t lastUse = 0; // 클수록 최근 (TerrainLod의 lastFrame과 같은 방식)
+    };
+
+    std::string pathFor(uint64_t hash) const;
+    MappedTile mapTile(const std::string& path, const TileKey* expected);
+    void scan();
+    void evict(const uint64_t* keep); // keep은 방금 넣은 타일 (지우지 않음, nullptr이면 없음)
+
+    std::string directory_;
+    uint64_t budgetBytes_;
+    bool ok_ = false;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    uint64_t clock_ = 0;
+    Stats stats_;
+};
@@ -90,6 +90,13 @@ inline float smoothstep(float edge0, float edge1, float x) {
     return t * t * (3.0f - 2.0f * t);  // 매끄러운 곡선
 }
 
+// smoothstep의 x에 대한 미분 (경계 밖에서는 0)
+inline float smoothstepDeriv(float edge0, float edge1, float x) {
+    float t = (x - edge0) / (edge1 - edge0);
+    if (t <= 0.0f || t >= 1.0f) return 0.0f;
+    return 6.0f * t * (1.0f - t) / (edge1 - edge0);
+}
+
 //
 // ==============================
 // 32비트 정수 해시 함수 (seed → 랜덤값)
@@ -108,6 +115,27 @@ inline uint32_t hash32(uint32_t x) {
     return x;
 }
 
+//
+// ==============================
+// 격자 좌표 해시 (해시 기반 노이즈용)
+// ==============================
+//
+// 정수 격자 점 (X, Y, Z)마다 seed에 따라 정해진 랜덤 값을 만든다.
+// 퍼뮤테이션 테이블을 읽는 대신 곱셈/xor/shift 만으로 계산하므로
+// SIMD로 여러 점을 한꺼번에 계산하기 쉽다.
+//
+// 각 축 좌표에 서로 다른 큰 홀수를 곱한 뒤(hx = X * LATTICE_PRIME_X ...)
+// seed와 섞어서 hash32에 넣는다.
+// (X+1 의 값은 hx + LATTICE_PRIME_X 로 바로 구할 수 있다)
+//
+constexpr uint32_t LATTICE_PRIME_X = 0x8da6b343u;
+constexpr uint32_t LATTICE_PRIME_Y = 0xd8163841u;
+constexpr uint32_t LATTICE_PRIME_Z = 0xcb1ab31fu;
+
+inline uint32_t latticeHash(uint32_t seed, uint32_t hx, uint32_t hy, uint32_t hz) {
+    return hash32(seed ^ hx ^ hy ^ hz);
+}
+
 //
 // ==============================
 // 0~1 사이의 부동소수점 난수 만들기 (seed 기반)
@@ -1,18 +1,82 @@
 // js_planet.js
 // C++ 로직을 JS로 100% 이식하여 성능 비교를 위한 모듈
+//
+// 같은 seed에서 C++(WASM / 네이티브)과 같은 행성을 만든다.
+//   - 퍼뮤테이션 테이블: std::mt19937 + noise.cpp의 shuffle_perm과 같은 순서
+//   - 파라미터: noise_params.cpp의 generateNoiseParams와 같은 값 (float32로 맞춤)
+//   - 높이 / 배치 변형: planet.cpp의 height / applyDisplacement와 같은 공식
+// 계산 자체는 JS 기본(double)으로 하므로 C++(float) 결과와 아주 작은 차이(1e-6 정도)는 난다.
+// (bench/bench_wasm.mjs가 WASM / 네이티브 결과와 비교한다)
+
+const f32 = Math.fround;
+
+// --- 난수 (std::mt19937 대응) ---
+// seed가 같으면 C++ std::mt19937(seed)와 같은 32비트 수열을 만든다.
+class MersenneTwister {
+    constructor(seed) {
+        this.state = new Uint32Array(624);
+        this.index = 624;
+        this.state[0] = seed >>> 0;
+        for (let i = 1; i < 624; i++) {
+            const prev = this.state[i - 1] ^ (this.state[i - 1] >>> 30);
+            this.state[i] = (Math.imul(1812433253, prev) + i) >>> 0;
+        }
+    }
+
+    next() {
+        const s = this.state;
+        if (this.index >= 624) {
+            for (let k = 0; k < 624; k++) {
+                const y = (s[k] & 0x80000000) | (s[(k + 1) % 624] & 0x7fffffff);
+                let v = s[(k + 397) % 624] ^ (y >>> 1);
+                if (y & 1) v ^= 0x9908b0df;
+                s[k] = v >>> 0;
+            }
+            this.index = 0;
+        }
+        let y = s[this.index++];
+        y ^= y >>> 11;
+        y ^= (y << 7) & 0x9d2c5680;
+        y ^= (y << 15) & 0xefc60000;
+        y ^= y >>> 18;
+        return y >>> 0;
+    }
+}
+
+// --- seed 해시 (util.hpp의 hash32 / randomRange 대응) ---
+function hash32(x) {
+    x = ((x ^ 61) ^ (x >>> 16)) >>> 0;
+    x = (x + (x << 3)) >>> 0;
+    x = (x ^ (x >>> 4)) >>> 0;
+    x = Math.imul(x, 0x27d4eb2d) >>> 0;
+    return (x ^ (x >>> 15)) >>> 0;
+}
+
+function randomRange(seed, salt, a, b) {
+    const h = f32((hash32((seed + salt) >>> 0) & 0xffffff) / 0x1000000);
+    a = f32(a);
+    return f32(a + f32(f32(f32(b) - a) * h));
+}
+
+// --- 파라미터 (noise_params.cpp의 generateNoiseParams 대응) ---
+export function generateNoiseParams(seed) {
+    seed >>>= 0;
+    const r = (salt, a, b) => randomRange(seed, salt, a, b);
+    return {
+        macroFreq: r(11, 0.03, 0.18), macroOctaves: Math.trunc(r(12, 2.0, 5.0)), macroAmp: r(13, 0.6, 1.6),
+        microFreq: r(21, 0.8, 3.0), microOctaves: Math.trunc(r(22, 2.0, 6.0)), microAmp: r(23, 0.05, 0.5),
+        ridgeFreq: r(31, 0.6, 2.5), ridgeOctaves: Math.trunc(r(32, 1.0, 4.0)), ridgeAmp: r(33, 0.2, 1.2),
+        lacunarity: r(41, 1.8, 2.2), gain: r(42, 0.35, 0.6)
+    };
+}
 
 export class PlanetGeneratorJS {
     constructor() {
-        this.perm = new Array(512);
+        this.perm = new Int32Array(512);
         this.permInited = false;
 
-        // 파라미터 (C++ 구조체와 동일하게 구성)
-        this.params = {
-            macroFreq: 0.1, macroOctaves: 4, macroAmp: 1.0,
-            microFreq: 2.0, microOctaves: 4, microAmp: 0.2,
-            ridgeFreq: 1.5, ridgeOctaves: 2, ridgeAmp: 0.8,
-            lacunarity: 2.0, gain: 0.5
-        };
+        // 파라미터 (C++ 구조체와 동일하게 구성, init(seed)에서 seed로 다시 만든다)
+        this.params = generateNoiseParams(0);
     }
 
     // --- 유틸리티 함수 (util.hpp 대응) ---
@@ -24,27 +88,35 @@ export class PlanetGeneratorJS {
         return t * t * (3.0 - 2.0 * t);
     }
 
-    // --- 노이즈 초기화 (noise.cpp 대응) ---
+    // --- 노이즈 초기화 (noise.cpp의 initNoiseTable 대응) ---
     init(seed) {
-        // JS는 시드 기반 랜덤이 내장되어 있지 않으므로 단순화된 LCG 사용
-        let val = seed;
-        const random = () => {
-            val = (val * 1664525 + 1013904223) % 4294967296;
-            return val / 4294967296;
-        };
+        const rng = new MersenneTwister(seed);
 
         for(let i=0; i<256; i++) this.perm[i] = i;
-
-        // Shuffle
-        for(let i=255; i>0; i--) {
-            const j = Math.floor(random() * (i + 1));
-            [this.perm[i], this.perm[j]] = [this.perm[j], this.perm[i]];
-        }
+        this.shufflePerm(rng);
         // Duplicate
         for(let i=0; i<256; i++) this.perm[256+i] = this.perm[i];
 
-        // 파라미터도 시드에 따라 랜덤 설정 (비교를 위해 단순화하거나 고정값 사용 가능)
-        // 여기서는 비교 공정성을 위해 고정값 혹은 유사한 랜덤 생성 로직 사용
+        this.params = generateNoiseParams(seed);
+        this.permInited = true;
+    }
+
+    // noise.cpp의 shuffle_perm과 같은 순서로 섞기
+    // k번째 자리를 [k, 255] 중 하나와 바꾸고, [0, d] 난수는 필요한 아래 비트만 남겨 범위를 넘으면 다시 뽑는다.
+    shufflePerm(rng) {
+        for (let k = 0, d = 255; d > 0; k++, d--) {
+            const range = d + 1;
+            const mask = (1 << (32 - Math.clz32(range - 1))) - 1;
+            let u;
+            do {
+                u = rng.next() & mask;
+            } while (u >= range);
+            if (u !== 0) {
+                const t = this.perm[k];
+                this.perm[k] = this.perm[k + u];
+                this.perm[k + u] = t;
+            }
+        }
     }
 
     grad(hash, x, y, z) {
@@ -126,12 +198,8 @@ export class PlanetGeneratorJS {
         return sum;
     }
 
-    // --- 최종 높이 계산 (planet.cpp의 get_height 대응) ---
-    getHeight(x, y, z, scale, radius) {
-        // 정규화 (Normalization)
-        const len = Math.sqrt(x*x + y*y + z*z);
-        const nx = x/len, ny = y/len, nz = z/len;
-
+    // --- 정규화된 방향의 높이 (planet.cpp의 combine_height 대응) ---
+    heightUnit(nx, ny, nz, scale) {
         // 1. Macro
         const macro = this.fbm(nx * this.params.macroFreq, ny * this.params.macroFreq, nz * this.params.macroFreq,
             this.params.macroOctaves, this.params.lacunarity, this.params.gain) * this.params.macroAmp;
@@ -155,4 +223,29 @@ export class PlanetGeneratorJS {
 
         return h;
     }
-}
\ No newline at end of file
+
+    // --- 최종 높이 계산 (planet.cpp의 get_height 대응) ---
+    getHeight(x, y, z, scale, radius) {
+        // 정규화 (Normalization)
+        const len = Math.sqrt(x*x + y*y + z*z);
+        if (len <= 1e-9) return this.heightUnit(0, 0, 0, scale);
+        return this.heightUnit(x/len, y/len, z/len, scale);
+    }
+
+    // --- 배치 변형 (planet.cpp의 apply_displacement_batch 대응) ---
+    // buffer([x, y, z, ...])의 정점을 방향 * (radius + 높이)로 덮어쓴다.
+    applyDisplacementBatch(buffer, vertexCount, scale, radius) {
+        for (let i = 0; i < vertexCount; i++) {
+            const index = i * 3;
+            const x = buffer[index], y = buffer[index + 1], z = buffer[index + 2];
+            const len = Math.sqrt(x*x + y*y + z*z);
+            const inv = len <= 1e-9 ? 0 : 1 / len;
+            const nx = x * inv, ny = y * inv, nz = z * inv;
+
+            const r = radius + this.heightUnit(nx, ny, nz, scale);
+            buffer[index] = nx * r;
+            buffer[index + 1] = ny * r;
+            buffer[index + 2] = nz * r;
+        }
+    }
+}
@@ -8,7 +8,6 @@
  * 사용자의 입력을 받아 C++ 노이즈 알고리즘을 실행하고, 그 결과를 3D 구체(Sphere)의 정점에 적용합니다.
  */
 
-import createModule from './web/planet.js';
 import * as THREE from 'three';
 import { OrbitControls } from 'three/addons/controls/OrbitControls.js';
 
@@ -27,13 +26,48 @@ const CONFIG = {
     },
     /** 행성 기본 설정 */
     planet: {
-        radius: 1,         // 기본 반지름
-        segments: 200,     // 구체의 분할 수 (높을수록 지형이 더 정교해지지만 성능 부하 증가)
+        mesh: 'icosphere', // 구 메쉬 종류 ('icosphere' | 'cubesphere', C++에서 생성)
+        meshVertices: 18000, // 정점 수 상한 (높을수록 지형이 더 정교해지지만 성능 부하 증가)
+                             // icosphere 17,642개 ≈ 예전 UV 구(200x200, 40,401개)의 적도 정점 간격
+        meshTilesPerEdge: 1, // 기본 면을 나누는 타일 수 (삼각형이 타일 순서로 정렬됨)
+        landHeight: 1.1,   // 반지름의 몇 배보다 높으면 육지색으로 칠할지
+        previewResolution: 64, // 슬라이더 미리보기용 노이즈 격자 해상도 (64^3, seed가 바뀔 때만 다시 구움)
         oceanColor: 0x1a5fb4, // 깊은 바다색
         landColor: 0x48a348,  // 육지(숲)색
         roughness: 0.8,    // 재질의 거칠기 (빛 반사 정도)
         rotationSpeed: 0.002 // 행성 자전 속도
     },
+    /** 지형 LOD 설정 (정육면체 면 6개 위의 quadtree 패치, C++ TerrainLod) */
+    lod: {
+        enabled: true,       // false면 planet.mesh의 고정 메쉬 하나로 그림
+        patchSegments: 32,   // 패치 한 변의 칸 수 (패치 하나 = 33x33 정점 + 스커트)
+        maxDepth: 12,        // quadtree 최대 깊이
+        errorPixels: 4,      // 정점 간격이 화면에서 이 픽셀보다 크게 보이면 패치를 나눔
+        maxNewPatches: 24,   // 한 프레임에 새로 계산할 패치 수 (카메라를 빨리 움직여도 프레임이 튀지 않게)
+        cacheCapacity: 256   // 화면에서 벗어나도 들고 있을 패치 수 (돌아왔을 때 다시 계산하지 않음)
+    },
+    /**
+     * 노이즈 세부 설정 슬라이더 (C++ NoiseParam 번호 순서)
+     * 값을 바꾸면 그 값이 모양을 바꾸는 층(macro / micro / ridge)만 다시 계산하고,
+     * 강도(amp)만 바꾸면 노이즈 계산 없이 섞기만 다시 한다.
+     */
+    noiseParams: [
+        { id: 0, label: '대륙 주파수', min: 0.01, max: 0.5, step: 0.01 },
+        { id: 1, label: '대륙 옥타브', min: 1, max: 12, step: 1 },
+        { id: 2, label: '대륙 강도', min: 0, max: 3, step: 0.05 },
+        { id: 3, label: '지형 주파수', min: 0.2, max: 6, step: 0.1 },
+        { id: 4, label: '지형 옥타브', min: 1, max: 12, step: 1 },
+        { id: 5, label: '지형 강도', min: 0, max: 1, step: 0.01 },
+        { id: 6, label: '산맥 주파수', min: 0.2, max: 5, step: 0.1 },
+        { id: 7, label: '산맥 옥타브', min: 1, max: 12, step: 1 },
+        { id: 8, label: '산맥 강도', min: 0, max: 2, step: 0.05 },
+        { id: 9, label: 'lacunarity', min: 1.2, max: 3, step: 0.05 },
+        { id: 10, label: 'gain', min: 0.1, max: 0.9, step: 0.01 }
+    ],
+    /** 멀티스레드(WASM pthread) 설정 */
+    threads: {
+        max: 16            // 최대 스레드 수 (build.sh의 PTHREAD_POOL_SIZE와 맞춤)
+    },
     /** 조명 설정 */
     light: {
         sunColor: 0xffffff,     // 태양광 색상
@@ -54,6 +88,139 @@ let wasmModule;
 let scene, camera, renderer, controls;
 let planetMesh;
 
+/**
+ * @type {ArrayBuffer|SharedArrayBuffer|null}
+ * @description 메쉬 속성(위치 / 법선 / 색)이 감싸고 있는 WASM 메모리 버퍼입니다.
+ * WASM 메모리가 늘어나면 HEAPF32.buffer가 바뀌므로, 이 값과 다르면 뷰를 다시 만듭니다.
+ */
+let meshHeapBuffer = null;
+
+/**
+ * @type {number|null}
+ * @description 마지막으로 정확하게(미리보기 없이) 계산한 seed입니다.
+ * 이 seed에서 scale / radius만 바꾸면 C++의 높이 캐시만 다시 쓰므로 미리보기가 필요 없습니다.
+ */
+let exactSeed = null;
+
+/**
+ * @type {Map<number, THREE.Mesh>}
+ * @description LOD 슬롯 번호 → 그 슬롯의 패치 메쉬. (CONFIG.lod.enabled일 때 planetMesh는 이 메쉬들을 담은 Group)
+ */
+const lodPatches = new Map();
+
+/** @type {THREE.BufferAttribute|null} 모든 LOD 패치가 같이 쓰는 index (HEAPU32 뷰) */
+let lodIndex = null;
+
+/** @type {ArrayBuffer|SharedArrayBuffer|null} LOD 패치 속성이 감싸고 있는 WASM 메모리 버퍼 (meshHeapBuffer와 같은 용도) */
+let lodHeapBuffer = null;
+
+// 매 프레임 LOD 갱신에 쓰는 임시 객체 (프레임마다 새로 만들지 않음)
+const lodCamera = new THREE.Vector3();
+const lodFrustum = new THREE.Frustum();
+const lodMatrix = new THREE.Matrix4();
+const lodViewport = new THREE.Vector2();
+
+/**
+ * @constant
+ * @type {Uint8Array}
+ * @description WASM SIMD128 지원 여부를 확인하기 위한 아주 작은 WASM 모듈입니다.
+ * (v128 상수를 만드는 함수 하나만 들어 있어서, SIMD를 모르는 브라우저에서는 검증에 실패합니다.)
+ */
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+    10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+]);
+
+/**
+ * @constant
+ * @type {string[]}
+ * @description main.js가 호출하는 WASM export 목록입니다. (build.sh의 EXPORTED_FUNCTIONS에 모두 들어 있어야 합니다)
+ * 예전에 만든 빌드가 web/에 남아 있으면 이 중 일부가 없으므로, 불러온 직후 한 번 확인해 바로 알려 줍니다.
+ */
+const REQUIRED_EXPORTS = [
+    '_init_planet', '_apply_displacement_batch', '_set_vertex_palette',
+    '_set_preview_mode', '_get_preview_error',
+    '_set_noise_param', '_get_noise_param', '_clear_noise_params',
+    '_mesh_vertex_count', '_mesh_positions', '_mesh_normals', '_mesh_colors',
+    '_mesh_displace', '_mesh_generate_sphere', '_mesh_index_count', '_mesh_indices',
+    '_lod_configure', '_lod_frustum', '_lod_update', '_lod_regenerate',
+    '_lod_visible_count', '_lod_visible', '_lod_created_count', '_lod_created',
+    '_lod_released_count', '_lod_released',
+    '_lod_patch_vertex_count', '_lod_index_count', '_lod_indices',
+    '_lod_patch_positions', '_lod_patch_normals', '_lod_patch_colors',
+    '_malloc', '_free'
+];
+
+/**
+ * @function checkWasmExports
+ * @description 불러온 WASM 모듈에 REQUIRED_EXPORTS가 모두 있는지 확인합니다.
+ * 하나라도 없으면 C++ 쪽 변경 뒤에 ./build.sh를 다시 돌리지 않은 것이므로, JS로 대신하지 않고 바로 실패합니다.
+ * @param {Object} module - 초기화가 끝난 WASM 모듈 인스턴스
+ * @param {string} file - 불러온 빌드 파일 이름 (오류 메시지용)
+ * @returns {Object} 확인이 끝난 module
+ * @throws {Error} 빠진 export가 있을 때
+ */
+function checkWasmExports(module, file) {
+    const missing = REQUIRED_EXPORTS.filter((name) => typeof module[name] !== 'function');
+    if (missing.length > 0) {
+        throw new Error(`Stale WASM build web/${file} (missing ${missing.join(', ')}), run ./build.sh`);
+    }
+    return module;
+}
+
+/**
+ * @async
+ * @function loadWasmModule
+ * @description 브라우저 환경에 맞는 WASM 빌드를 불러옵니다.
+ * 1. cross-origin isolated(SharedArrayBuffer 사용 가능) + SIMD 지원 + 코어 2개 이상이면
+ *    멀티스레드 빌드(planet_mt.js)를 불러오고, 배치 함수가 쓸 스레드 수를 설정합니다.
+ * 2. 아니면 SIMD 빌드(planet_simd.js), 그것도 안 되면 기본 빌드(planet.js)를 불러옵니다.
+ * 앞 단계의 빌드 파일을 불러오지 못하면(./build.sh로 만들지 않아 파일이 없는 경우 포함) 다음 단계로 다시 시도하고,
+ * 실제로 불러온 빌드는 콘솔에 남깁니다. 불러온 빌드가 오래되어 export가 빠져 있으면 checkWasmExports에서 실패합니다.
+ * (GitHub Pages처럼 COOP/COEP 헤더를 줄 수 없는 곳에서는 항상 2번으로 동작합니다)
+ * @returns {Promise<Object>} 초기화가 끝난 WASM 모듈 인스턴스
+ */
+async function loadWasmModule() {
+    const simd = WebAssembly.validate(SIMD_PROBE);
+    const threads = Math.min(navigator.hardwareConcurrency || 1, CONFIG.threads.max);
+
+    if (simd && threads > 1 && self.crossOriginIsolated && typeof SharedArrayBuffer !== 'undefined') {
+        let module = null;
+        try {
+            const { default: createMtModule } = await import('./web/planet_mt.js');
+            module = await createMtModule();
+        } catch (error) {
+            console.warn("Threaded module unavailable (web/planet_mt.js missing? run ./build.sh), " +
+                "falling back to single-threaded build:", error);
+        }
+        if (module) {
+            checkWasmExports(module, 'planet_mt.js');
+            module._set_thread_count(threads);
+            console.info(`WASM build: planet_mt.js (SIMD128, ${module._get_thread_count()} threads)`);
+            return module;
+        }
+    }
+    if (simd) {
+        let module = null;
+        try {
+            const { default: createSimdModule } = await import('./web/planet_simd.js');
+            module = await createSimdModule();
+        } catch (error) {
+            console.warn("SIMD module unavailable (web/planet_simd.js missing? run ./build.sh), " +
+                "falling back to scalar build:", error);
+        }
+        if (module) {
+            checkWasmExports(module, 'planet_simd.js');
+            console.info("WASM build: planet_simd.js (SIMD128)");
+            return module;
+        }
+    }
+    const { default: createModule } = await import('./web/planet.js');
+    const module = checkWasmExports(await createModule(), 'planet.js');
+    console.info("WASM build: planet.js (scalar)");
+    return module;
+}
+
 /**
  * @type {Object}
  * @description HTML UI 요소들에 대한 참조를 저장하는 객체입니다.
@@ -62,7 +229,11 @@ const ui = {
     btn: document.getElementById("generate-btn"),
     seed: document.getElementById("seed"),
     scale: document.getElementById("scale"),
-    radius: document.getElementById("radius")
+    radius: document.getElementById("radius"),
+    noiseParamList: document.getElementById("noise-param-list"),
+    noiseReset: document.getElementById("noise-reset"),
+    /** @type {HTMLInputElement[]} CONFIG.noiseParams 순서의 슬라이더 (setupNoiseParamControls에서 생성) */
+    noiseParams: []
 };
 
 /**
@@ -75,8 +246,8 @@ const ui = {
  */
 async function init() {
     try {
-        // WASM 모듈 비동기 로드 (완료될 때까지 대기)
-        wasmModule = await createModule();
+        // WASM 모듈 비동기 로드 (SIMD 지원 시 SIMD 빌드 우선, 완료될 때까지 대기)
+        wasmModule = await loadWasmModule();
 
         // 로드 완료 후 UI 활성화
         ui.btn.disabled = false;
@@ -97,6 +268,10 @@ async function init() {
             // [Latency 비교] 화면 갱신이 완료된 후 측정을 시작하기 위해 약간의 지연을 줍니다.
             // setTimeout(measureLatency, 50);
         });
+        // scale / radius 슬라이더를 움직이는 동안에는 미리보기(구워 둔 노이즈 격자)로 빠르게 갱신
+        ui.scale.addEventListener("input", () => updatePlanet(true));
+        ui.radius.addEventListener("input", () => updatePlanet(true));
+        setupNoiseParamControls();
         window.addEventListener("resize", onWindowResize);
 
         // 렌더링 루프 시작
@@ -105,6 +280,7 @@ async function init() {
     } catch (error) {
         console.error("Failed to initialize application:", error);
         ui.btn.textContent = "Error Loading";
+        ui.btn.title = error.message;
     }
 }
 
@@ -168,28 +344,12 @@ function setupLights() {
  * @function createPlanetMesh
  * @description 행성의 뼈대(Geometry)와 피부(Material)를 생성하여 씬에 추가합니다.
  * 초기에는 지형 굴곡이 없는 완벽한 구 형태로 생성됩니다.
+ * CONFIG.lod.enabled면 빈 Group을 만들고, 패치 메쉬는 매 프레임 updateLod가 채웁니다.
  */
 function createPlanetMesh() {
-    // 구체 지오메트리(뼈대) 생성 (반지름, 가로 분할 수, 세로 분할 수)
-    const geometry = new THREE.SphereGeometry(
-        CONFIG.planet.radius,   // 반지름
-        CONFIG.planet.segments, // 가로/세로 분할 수: 숫자가 높으면 표면이 매끈해짐 (낮으면 다각항 면들이 드러나 보임)
-        CONFIG.planet.segments
-    );
-
-    // 1. 버텍스 컬러 버퍼 생성
-    // 점(Vertex)마다 색상 정보를 저장할 공간을 만듭니다. (점 개수 * 3 (R,G,B))
-    const count = geometry.attributes.position.count;
-    const colors = new Float32Array(count * 3);
-
-    // 초기에는 모두 바다색으로 채웁니다.
-    for (let i = 0; i < count; i++) {
-        colors[i * 3] = oceanColorObj.r;
-        colors[i * 3 + 1] = oceanColorObj.g;
-        colors[i * 3 + 2] = oceanColorObj.b;
-    }
-    // 지오메트리에 색상 속성 추가 (3개씩 끊어 읽음)
-    geometry.setAttribute('color', new THREE.BufferAttribute(colors, 3));
+    // 구체 지오메트리(뼈대): 정점 / 삼각형은 C++이 만들어 모듈 메모리에 두고, 속성은 그 뷰를 감쌉니다.
+    // (UV 구와 달리 극 / 이음새에 정점이 몰리거나 겹치지 않아 같은 정밀도에 높이 계산이 훨씬 적음)
+    const geometry = new THREE.BufferGeometry();
 
     // 재질 생성 (빛에 반응하는 Standard Material)
     const material = new THREE.MeshStandardMaterial({   // 물리 기반 렌더링: 빛을 받았을 때 현실적으로 반응
@@ -200,16 +360,209 @@ function createPlanetMesh() {
         roughness: CONFIG.planet.roughness  // 거칠기(1에 가까울수록 매트하고 거친 느낌)
     });
 
+    if (CONFIG.lod.enabled) {
+        planetMesh = new THREE.Group();
+        planetMesh.userData.material = material; // 패치 메쉬들이 같이 쓰는 재질
+        scene.add(planetMesh);
+        setupLod();
+        return;
+    }
+
     planetMesh = new THREE.Mesh(geometry, material);    // 지오메트리에 재절 입히기
     scene.add(planetMesh);
+
+    setupMeshBuffers(geometry);
+}
+
+/**
+ * @function setupLod
+ * @description C++ TerrainLod를 CONFIG.lod로 설정하고 정점 색 팔레트를 넘깁니다.
+ * 설정을 바꾸면 C++이 모든 패치를 버리므로 JS 쪽 패치 메쉬도 모두 버립니다.
+ */
+function setupLod() {
+    const lod = CONFIG.lod;
+    wasmModule._lod_configure(lod.patchSegments, lod.maxDepth, lod.errorPixels, lod.maxNewPatches, lod.cacheCapacity);
+    for (const mesh of lodPatches.values()) {
+        planetMesh.remove(mesh);
+        mesh.geometry.dispose();
+    }
+    lodPatches.clear();
+    lodHeapBuffer = null;
+
+    wasmModule._set_vertex_palette(packRGBA8(oceanColorObj), packRGBA8(landColorObj), CONFIG.planet.landHeight);
+}
+
+/**
+ * @function updateLod
+ * @description 카메라에 맞춰 그릴 LOD 패치를 C++에서 다시 정하고 패치 메쉬에 반영합니다. (매 프레임)
+ * 1. 카메라 위치와 시야 절두체(frustum)를 행성 좌표계(자전 포함)로 바꿔 넘깁니다.
+ * 2. C++이 화면 오차로 패치를 나누거나 합치고, 새로 필요한 패치만 계산합니다.
+ * 3. syncLodPatches로 버려진 / 새로 계산된 / 보이는 패치를 메쉬에 반영합니다.
+ */
+function updateLod() {
+    planetMesh.updateMatrixWorld();
+    camera.updateMatrixWorld();
+    planetMesh.worldToLocal(camera.getWorldPosition(lodCamera));
+
+    // 평면은 안쪽을 향하고 정규화되어 있음 (normal · p + constant >= 0 이면 안쪽)
+    lodMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse).multiply(planetMesh.matrixWorld);
+    lodFrustum.setFromProjectionMatrix(lodMatrix);
+    const planes = wasmModule.HEAPF32.subarray(wasmModule._lod_frustum() >> 2, (wasmModule._lod_frustum() >> 2) + 24);
+    lodFrustum.planes.forEach((plane, i) => {
+        planes[i * 4] = plane.normal.x;
+        planes[i * 4 + 1] = plane.normal.y;
+        planes[i * 4 + 2] = plane.normal.z;
+        planes[i * 4 + 3] = plane.constant;
+    });
+
+    renderer.getDrawingBufferSize(lodViewport);
+    wasmModule._lod_update(lodCamera.x, lodCamera.y, lodCamera.z,
+        THREE.MathUtils.degToRad(camera.fov), lodViewport.y, 1);
+    syncLodPatches();
+}
+
+/**
+ * @function syncLodPatches
+ * @description lod_update / lod_regenerate 결과(슬롯 목록)를 패치 메쉬에 반영합니다.
+ * - released: 메쉬를 빼고 GPU 버퍼를 버립니다. (같은 슬롯 번호는 나중에 다른 패치로 다시 쓰임)
+ * - created : 슬롯의 위치 / 법선 / 색 뷰를 연결하거나, 이미 연결되어 있으면 needsUpdate만 켭니다.
+ * - visible : 이번 프레임에 그릴 패치만 보이게 합니다.
+ * WASM 메모리가 늘어나 HEAPF32.buffer가 바뀌었으면 모든 패치의 뷰를 다시 연결합니다.
+ */
+function syncLodPatches() {
+    const slots = (ptrFn, countFn) => {
+        const ptr = ptrFn() >> 2;
+        return wasmModule.HEAPU32.subarray(ptr, ptr + countFn());
+    };
+
+    for (const slot of slots(wasmModule._lod_released, wasmModule._lod_released_count)) {
+        const mesh = lodPatches.get(slot);
+        if (!mesh) continue;
+        planetMesh.remove(mesh);
+        mesh.geometry.dispose();
+        lodPatches.delete(slot);
+    }
+
+    const rebind = lodHeapBuffer !== wasmModule.HEAPF32.buffer;
+    if (rebind) {
+        const indexPtr = wasmModule._lod_indices() >> 2;
+        lodIndex = new THREE.BufferAttribute(
+            wasmModule.HEAPU32.subarray(indexPtr, indexPtr + wasmModule._lod_index_count()), 1);
+        for (const [slot, mesh] of lodPatches) bindLodPatch(mesh.geometry, slot);
+        lodHeapBuffer = wasmModule.HEAPF32.buffer;
+    }
+
+    for (const slot of slots(wasmModule._lod_created, wasmModule._lod_created_count)) {
+        let mesh = lodPatches.get(slot);
+        if (!mesh) {
+            mesh = new THREE.Mesh(new THREE.BufferGeometry(), planetMesh.userData.material);
+            mesh.frustumCulled = false; // 화면 밖 / 지평선 뒤 패치는 C++이 이미 뺌
+            bindLodPatch(mesh.geometry, slot);
+            lodPatches.set(slot, mesh);
+            planetMesh.add(mesh);
+        } else if (!rebind) {
+            const geometry = mesh.geometry;
+            geometry.getAttribute('position').needsUpdate = true;
+            geometry.getAttribute('normal').needsUpdate = true;
+            geometry.getAttribute('color').needsUpdate = true;
+        }
+    }
+
+    for (const mesh of lodPatches.values()) mesh.visible = false;
+    for (const slot of slots(wasmModule._lod_visible, wasmModule._lod_visible_count)) {
+        const mesh = lodPatches.get(slot);
+        if (mesh) mesh.visible = true;
+    }
+}
+
+/**
+ * @function bindLodPatch
+ * @description 패치 지오메트리의 속성을 슬롯의 HEAPF32 / HEAPU8 뷰로, index를 공유 index로 연결합니다.
+ * @param {THREE.BufferGeometry} geometry - 패치 지오메트리
+ * @param {number} slot - LOD 슬롯 번호
+ */
+function bindLodPatch(geometry, slot) {
+    const count = wasmModule._lod_patch_vertex_count();
+    const view = (ptr) => wasmModule.HEAPF32.subarray(ptr >> 2, (ptr >> 2) + count * 3);
+    const colorPtr = wasmModule._lod_patch_colors(slot);
+
+    geometry.setAttribute('position', new THREE.BufferAttribute(view(wasmModule._lod_patch_positions(slot)), 3));
+    geometry.setAttribute('normal', new THREE.BufferAttribute(view(wasmModule._lod_patch_normals(slot)), 3));
+    geometry.setAttribute('color', new THREE.BufferAttribute(
+        wasmModule.HEAPU8.subarray(colorPtr, colorPtr + count * 4), 4, true));
+    geometry.setIndex(lodIndex);
+}
+
+/**
+ * @function setupMeshBuffers
+ * @description C++(WASM) 모듈 안에 행성 메쉬 버퍼를 만들고 지오메트리에 연결합니다.
+ * 1. C++이 정점 간격이 고른 단위 구(icosphere / cube-sphere)를 만들고 단위 방향을 저장합니다.
+ * 2. 위치 / 법선 / 색 / index 속성이 HEAPF32 / HEAPU8 / HEAPU32 뷰를 직접 감싸도록 바꿉니다. (복사 없음)
+ * 3. 정점 색 팔레트(바다 / 육지)를 C++에 넘깁니다.
+ * @param {THREE.BufferGeometry} geometry - 속성이 비어 있는 지오메트리
+ */
+function setupMeshBuffers(geometry) {
+    const kind = CONFIG.planet.mesh === 'cubesphere' ? 1 : 0;
+    wasmModule._mesh_generate_sphere(kind, CONFIG.planet.meshVertices, CONFIG.planet.meshTilesPerEdge);
+    meshHeapBuffer = null; // 버퍼 주소가 바뀌었으므로 반드시 다시 연결
+    bindMeshViews(geometry);
+
+    // 바다 / 육지 색은 C++이 RGBA8로 칠하므로 팔레트만 넘겨 둡니다.
+    wasmModule._set_vertex_palette(packRGBA8(oceanColorObj), packRGBA8(landColorObj), CONFIG.planet.landHeight);
+}
+
+/**
+ * @function packRGBA8
+ * @description THREE.Color를 C++ 정점 색 형식(0xAABBGGRR, 메모리 순서 R, G, B, A)으로 바꿉니다.
+ * THREE.Color의 r/g/b는 렌더링에 쓰는 선형(linear) 값이므로 그대로 0~255로 옮깁니다.
+ * @param {THREE.Color} color - 변환할 색
+ * @returns {number} 부호 없는 32비트 정수
+ */
+function packRGBA8(color) {
+    const r = Math.round(color.r * 255);
+    const g = Math.round(color.g * 255);
+    const b = Math.round(color.b * 255);
+    return (r | (g << 8) | (b << 16) | (255 << 24)) >>> 0;
+}
+
+/**
+ * @function bindMeshViews
+ * @description 지오메트리의 위치 / 법선 / 색 / index를 모듈 메쉬 버퍼의 HEAPF32 / HEAPU8 / HEAPU32 뷰로 연결합니다.
+ * 색은 정점마다 Uint8 4개(RGBA)이고, normalized 속성이라 셰이더에서는 0~1로 읽힙니다.
+ * WASM 메모리가 늘어나면(ALLOW_MEMORY_GROWTH) 예전 뷰는 더 이상 쓸 수 없으므로,
+ * C++ 함수를 부른 뒤에는 항상 이 함수를 불러 필요할 때만 다시 연결합니다.
+ * @param {THREE.BufferGeometry} geometry - 행성 지오메트리
+ */
+function bindMeshViews(geometry) {
+    const heap = wasmModule.HEAPF32;
+    if (meshHeapBuffer === heap.buffer) return;
+
+    const count = wasmModule._mesh_vertex_count();
+    const view = (ptr) => heap.subarray(ptr >> 2, (ptr >> 2) + count * 3);
+    const colorPtr = wasmModule._mesh_colors();
+    const colorView = wasmModule.HEAPU8.subarray(colorPtr, colorPtr + count * 4);
+
+    geometry.setAttribute('position', new THREE.BufferAttribute(view(wasmModule._mesh_positions()), 3));
+    geometry.setAttribute('normal', new THREE.BufferAttribute(view(wasmModule._mesh_normals()), 3));
+    geometry.setAttribute('color', new THREE.BufferAttribute(colorView, 4, true));
+
+    const indexPtr = wasmModule._mesh_indices() >> 2;
+    const indexView = wasmModule.HEAPU32.subarray(indexPtr, indexPtr + wasmModule._mesh_index_count());
+    geometry.setIndex(new THREE.BufferAttribute(indexView, 1));
+    meshHeapBuffer = heap.buffer;
 }
 
 /**
  * @function updatePlanet
  * @description UI 입력값을 읽어와 WASM(C++) 함수를 호출하고, 계산된 지형을 적용합니다.
  * 'Generate' 버튼을 누를 때마다 실행됩니다.
+ * @param {boolean} [preview=false] - true면 미리보기 모드(노이즈 격자 보간)로 계산합니다.
+ * 같은 seed에서는 격자를 다시 굽지 않으므로 scale / radius 변경이 훨씬 빠릅니다.
+ * 버튼에는 정확한 계산과 비교한 최대 높이 오차를 표시합니다.
+ * 단, 정확하게 계산해 둔 seed와 같으면 미리보기를 쓰지 않습니다.
+ * (C++이 정점마다 scale = 1 높이를 캐시해 두고 scale / radius만 다시 적용하므로 정확하면서 더 빠름)
  */
-function updatePlanet() {
+function updatePlanet(preview = false) {
     // 모듈이나 메쉬가 준비되지 않았으면 중단
     if (!wasmModule || !planetMesh) return;
 
@@ -217,91 +570,98 @@ function updatePlanet() {
     const seed = parseInt(ui.seed.value);
     const scale = parseFloat(ui.scale.value) / 100.0; // 0~100 값을 0.0~1.0 단위로 변환
     const radius = parseFloat(ui.radius.value);
+    if (seed === exactSeed) preview = false;
+    if (!preview) exactSeed = seed;
 
     // 1. C++(WASM) 내부 상태 초기화 (노이즈 맵 생성 등)
+    // 미리보기를 끌 때는 init 전에 꺼서, seed가 바뀌어도 격자를 굽지 않게 합니다.
+    // 켤 때는 init 뒤에 켜서, 새 seed의 격자를 한 번만 굽습니다.
+    if (!preview) wasmModule._set_preview_mode(0);
     wasmModule._init_planet(seed, scale, radius);
+    if (preview) wasmModule._set_preview_mode(CONFIG.planet.previewResolution);
+
+    ui.btn.textContent = preview
+        ? `Generate (preview ±${wasmModule._get_preview_error().toFixed(3)})`
+        : "Generate";
+    syncNoiseParamControls();
 
     // 2. 계산된 노이즈 값을 이용해 3D 지오메트리 변형
-    applyDisplacement(planetMesh.geometry, radius);
+    // LOD면 지금 들고 있는 패치만 다시 계산 (새 패치는 다음 프레임부터 새 값으로 만들어짐)
+    if (CONFIG.lod.enabled) {
+        wasmModule._lod_regenerate();
+        syncLodPatches();
+        return;
+    }
+    applyDisplacement(planetMesh.geometry);
 }
 
 /**
- * @function applyDisplacement
- * @description 구체의 모든 정점(Vertex)을 순회하며 C++에서 계산한 높이 값을 적용합니다.
- * @param {THREE.BufferGeometry} geometry - 변형할 행성의 지오메트리
- * @param {number} radius - 행성의 기본 반지름
+ * @function setupNoiseParamControls
+ * @description CONFIG.noiseParams로 노이즈 세부 설정 슬라이더를 만들고 이벤트를 연결합니다.
+ * 슬라이더 값은 C++에 덮어쓰기 값(override)으로 저장되어 seed를 바꿔도 유지되고,
+ * 'seed 값으로 되돌리기'를 누르면 모두 지워집니다.
+ * 같은 seed에서는 바뀐 층만 다시 계산하므로 미리보기 없이 정확하게 갱신합니다.
  */
-function applyDisplacement(geometry, radius) {
-    const posAttribute = geometry.getAttribute('position'); // 점들의 위치를 숫자 배열로 관리
-    const vertexCount = posAttribute.count;
-
-    // 1. TypedArray 가져오기 (Float32Array)
-    // Three.js의 BufferAttribute는 이미 Float32Array를 가지고 있습니다.
-    const jsArray = posAttribute.array;
-
-    // 2. 메모리(바이트) 크기 계산 (float는 4바이트)
-    const byteSize = jsArray.length * jsArray.BYTES_PER_ELEMENT;
-
-    // 3. WASM 힙(Heap) 메모리 할당 (malloc)
-    // WASM의 메모리 공간에서 byteSize만큼 자리 빌림 (ptr: 빌린 메모리 공간의 시작 주소 번지)
-    const ptr = wasmModule._malloc(byteSize);
-
-    // 4. JS 데이터 -> WASM 힙으로 복사
-    // HEAPF32는 WASM 메모리를 float(32bit) 단위로 바라보는 뷰입니다. 4바이트씩 묶어서 인덱스 셈
-    // ptr은 바이트 단위 주소이므로, float 인덱스로 쓰려면 4로 나눠야(>>2) 합니다.
-    wasmModule.HEAPF32.set(jsArray, ptr >> 2);  // JS배열을 WASM 메모리 공간에 복사
-
-    // 5. C++ 배치 함수 호출
-    // 파라미터: 메모리 주소와 점의 개수
-    wasmModule._apply_displacement_batch(ptr, vertexCount); // 포인터가 가르키는 배열의 값 변경
-
-    // 6. 결과 데이터 회수 (WASM 힙 -> JS 데이터)
-    // 계산된 결과가 담긴 메모리 구간을 가져와서 원본 배열에 덮어씁니다.
-    const calculatedArray = wasmModule.HEAPF32.subarray(ptr >> 2, (ptr >> 2) + jsArray.length);
-    jsArray.set(calculatedArray);   // jsArray로 복사
-
-    // 7. 메모리 해제 (안 하면 메모리 누수 발생)
-    wasmModule._free(ptr);
-
-    // 7-1. 높이에 따른 색상 적용 (바다 vs 육지)
-    // 색상 버퍼를 가져옵니다.
-    const colorAttribute = geometry.getAttribute('color');
-    const colors = colorAttribute.array;
-
-    // 기준 높이: 반지름보다 높으면 육지로 판정
-    const seaLevel = radius * 1.1;
-
-    // 대신 "비교할 기준값(seaLevel)을 미리 제곱"해두고, 거리의 제곱값(x*x + y*y + z*z)과 비교합니다.
-    const seaLevelSq = seaLevel * seaLevel;
-
-    for (let i = 0; i < vertexCount; i++) {
-        // 현재 점의 좌표
-        const x = jsArray[i * 3];
-        const y = jsArray[i * 3 + 1];
-        const z = jsArray[i * 3 + 2];
-
-        // 원점에서의 거리 제곱 계산 (sqrt 제거)
-        const magnitudeSq = x*x + y*y + z*z;
-
-        // 높이에 따라 색상 결정 (제곱된 값끼리 비교)
-        if (magnitudeSq > seaLevelSq) {
-            // 육지
-            colors[i * 3] = landColorObj.r;
-            colors[i * 3 + 1] = landColorObj.g;
-            colors[i * 3 + 2] = landColorObj.b;
-        } else {
-            // 바다
-            colors[i * 3] = oceanColorObj.r;
-            colors[i * 3 + 1] = oceanColorObj.g;
-            colors[i * 3 + 2] = oceanColorObj.b;
-        }
+function setupNoiseParamControls() {
+    for (const param of CONFIG.noiseParams) {
+        const group = document.createElement("div");
+        group.className = "control-group";
+        const label = document.createElement("label");
+        label.textContent = param.label;
+        const input = document.createElement("input");
+        input.type = "range";
+        input.min = param.min;
+        input.max = param.max;
+        input.step = param.step;
+        const output = document.createElement("output");
+        group.append(label, input, output);
+        ui.noiseParamList.appendChild(group);
+        ui.noiseParams.push(input);
+
+        input.addEventListener("input", () => {
+            wasmModule._set_noise_param(param.id, parseFloat(input.value));
+            updatePlanet();
+        });
     }
-    // 색상이 변경되었음을 알림
-    colorAttribute.needsUpdate = true;
+    ui.noiseReset.addEventListener("click", () => {
+        wasmModule._clear_noise_params();
+        updatePlanet();
+    });
+    syncNoiseParamControls();
+}
 
-    // 8. 업데이트 알림
-    posAttribute.needsUpdate = true;
-    geometry.computeVertexNormals();    // 지형이 변경되었으니, 빛 반사 각도 다시 계산
+/**
+ * @function syncNoiseParamControls
+ * @description 슬라이더를 C++이 지금 쓰는 노이즈 값으로 맞춥니다. (seed가 바뀌면 덮어쓰지 않은 값도 바뀜)
+ */
+function syncNoiseParamControls() {
+    CONFIG.noiseParams.forEach((param, i) => {
+        const input = ui.noiseParams[i];
+        if (!input) return;
+        const value = wasmModule._get_noise_param(param.id);
+        input.value = value;
+        input.nextSibling.textContent = param.step >= 1 ? String(value) : value.toFixed(2);
+    });
+}
+
+/**
+ * @function applyDisplacement
+ * @description C++에서 모든 정점의 위치 / 법선 / 색(바다 vs 육지)을 한 번에 계산하고 지오메트리에 알립니다.
+ * 결과는 지오메트리 속성이 감싸고 있는 WASM 메모리에 바로 쓰이므로 복사가 없습니다.
+ * @param {THREE.BufferGeometry} geometry - 변형할 행성의 지오메트리
+ */
+function applyDisplacement(geometry) {
+    // 1. C++ 호출: 모듈에 저장해 둔 단위 방향으로 위치 / 법선 / 색을 모듈 버퍼에 바로 계산
+    // (malloc / 복사 / free 없음. 색은 반지름 * landHeight를 기준으로 바다 / 육지를 나눔)
+    wasmModule._mesh_displace();
+
+    // 2. 메모리가 늘어났다면(init / 미리보기 격자 할당 등) 뷰를 다시 연결
+    bindMeshViews(geometry);
+
+    // 3. 업데이트 알림
+    geometry.getAttribute('position').needsUpdate = true;
+    geometry.getAttribute('normal').needsUpdate = true; // 법선은 C++에서 이미 계산됨 (computeVertexNormals 불필요)
+    geometry.getAttribute('color').needsUpdate = true;
 }
 
 /**
@@ -331,6 +691,11 @@ function animate() {
     // 컨트롤 관성 효과 업데이트
     controls.update();
 
+    // 카메라 / 자전에 맞춰 LOD 패치 갱신
+    if (CONFIG.lod.enabled && planetMesh) {
+        updateLod();
+    }
+
     // 최종 렌더링
     renderer.render(scene, camera);
 }
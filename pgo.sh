@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+set -e
+
+# 네이티브 릴리스 프로파일 세 가지를 만들고 bench_suite로 비교한다. (CMakeLists.txt)
+#   build-native : 기본 Release (-O3, 비교 기준)
+#   build-lto    : + LTO
+#   build-pgo    : + LTO + PGO (bench_suite의 seed 여러 개 측정으로 학습)
+# 결과는 build-<이름>/bench_suite.json에 남고, node가 있으면 bench/compare_suite.mjs로 표를 출력한다.
+# 인자는 비교용 bench_suite에 그대로 넘긴다. (예: ./pgo.sh --quick)
+# WASM 프로파일은 build.sh (BUILD_PROFILE=release)
+JOBS="$(nproc 2>/dev/null || echo 4)"
+
+configure_build() {
+  local DIR=$1
+  shift
+  cmake -S . -B ${DIR} -DCMAKE_BUILD_TYPE=Release "$@"
+  cmake --build ${DIR} -j"${JOBS}"
+}
+
+configure_build build-native -DPLANET_LTO=OFF -DPLANET_PGO=OFF
+configure_build build-lto -DPLANET_LTO=ON -DPLANET_PGO=OFF
+
+# PGO: 학습용 빌드 → 학습 → 같은 디렉터리에서 프로파일을 읽어 다시 빌드
+PGO_DIR="$(pwd)/build-pgo/pgo-profile"
+rm -rf "${PGO_DIR}"
+configure_build build-pgo -DPLANET_LTO=ON -DPLANET_PGO=GENERATE -DPLANET_PGO_DIR="${PGO_DIR}"
+# 학습: seed 4개 x 작은 버퍼 두 개의 perlin / fbm / ridged_fbm / get_height / 배치
+build-pgo/bench_suite --quick > /dev/null
+if "${CXX:-c++}" --version 2>/dev/null | grep -qi clang; then
+  llvm-profdata merge -o "${PGO_DIR}/default.profdata" "${PGO_DIR}"/*.profraw
+fi
+configure_build build-pgo -DPLANET_LTO=ON -DPLANET_PGO=USE -DPLANET_PGO_DIR="${PGO_DIR}"
+
+for B in native lto pgo; do
+  build-${B}/bench_suite --json build-${B}/bench_suite.json "$@" > /dev/null
+done
+
+if command -v node >/dev/null 2>&1; then
+  node bench/compare_suite.mjs base=build-native/bench_suite.json lto=build-lto/bench_suite.json \
+                               pgo=build-pgo/bench_suite.json
+fi
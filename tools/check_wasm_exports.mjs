@@ -0,0 +1,57 @@
+// check_wasm_exports.mjs
+// -------------------------------------------------------------
+// web/ 아래 emscripten 빌드가 main.js가 부르는 export(REQUIRED_EXPORTS)를 모두 갖고 있는지 확인한다.
+// C++ 쪽에 export를 추가하고 ./build.sh를 다시 돌리지 않은 채 web/을 커밋하는 일을 막기 위한 것으로,
+// build.sh가 모듈을 다 만든 뒤 이 스크립트를 부르고, 빌드 없이 따로 돌려 커밋된 파일을 확인할 수도 있다.
+//
+// 모듈을 불러오지는 않고(pthread 빌드는 Node에서 Worker를 띄워야 함) 글루 JS에서
+// export 래퍼 이름(Module["_이름"])을 찾는다. 목록은 main.js의 REQUIRED_EXPORTS를 그대로 읽는다.
+//
+// 사용법: node tools/check_wasm_exports.mjs [FILE]...
+//   FILE : emscripten 글루 JS (기본 web/planet.js, web/planet_simd.js, web/planet_mt.js)
+// 하나라도 없거나 빠진 export가 있으면 exit 1.
+// -------------------------------------------------------------
+
+import { existsSync, readFileSync } from 'node:fs';
+import { dirname, join, relative, resolve } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+const ROOT = resolve(dirname(fileURLToPath(import.meta.url)), '..');
+
+// build.sh가 만드는 빌드 변형 (bench/bench_wasm.mjs의 WASM_VARIANTS와 같음)
+const WASM_VARIANTS = ['web/planet.js', 'web/planet_simd.js', 'web/planet_mt.js'];
+
+// main.js의 `const REQUIRED_EXPORTS = [ ... ];`에서 이름만 뽑는다.
+function readRequiredExports() {
+  const source = readFileSync(join(ROOT, 'main.js'), 'utf8');
+  const match = source.match(/const REQUIRED_EXPORTS = \[([^\]]*)\]/);
+  if (!match) {
+    console.error('REQUIRED_EXPORTS not found in main.js');
+    process.exit(2);
+  }
+  return [...match[1].matchAll(/'(_\w+)'/g)].map((m) => m[1]);
+}
+
+const files = process.argv.length > 2
+  ? process.argv.slice(2).map((file) => resolve(file))
+  : WASM_VARIANTS.map((file) => join(ROOT, file));
+const required = readRequiredExports();
+
+let failed = false;
+for (const file of files) {
+  const name = relative(ROOT, file);
+  if (!existsSync(file)) {
+    console.error(`${name}: not found (run ./build.sh)`);
+    failed = true;
+    continue;
+  }
+  const glue = readFileSync(file, 'utf8');
+  const missing = required.filter((fn) => !glue.includes(`Module["${fn}"]`));
+  if (missing.length > 0) {
+    console.error(`${name}: stale build, missing ${missing.join(', ')} (run ./build.sh)`);
+    failed = true;
+  } else {
+    console.log(`${name}: ok (${required.length} exports)`);
+  }
+}
+process.exit(failed ? 1 : 0);
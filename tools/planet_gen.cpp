@@ -0,0 +1,505 @@
+// planet_gen.cpp
+// -------------------------------------------------------------
+// 서버에서 행성을 미리 만들어 두기 위한 네이티브 명령줄 도구.
+// (브라우저의 main.js + WASM 대신 같은 C++ 코드로 여러 행성을 한꺼번에 만든다)
+//
+// seed 범위의 행성마다 변형된 메쉬(PLY) 또는 높이 지도(PFM)를 디스크에 쓴다.
+//   - 작업 스레드마다 PlanetGenerator를 하나씩 두고, 다음 seed를 atomic 번호로 가져간다.
+//     (높이 계산은 const 함수라서 스레드끼리 잠금이 없다)
+//   - 메쉬의 단위 방향 / 삼각형은 모든 행성이 같으므로 처음에 한 번만 만들어 공유한다.
+//   - 정점 / 행을 조각(kChunkVertices개)씩 계산해서 바로 파일에 쓴다.
+//     → 메모리는 (공유 메쉬 + 스레드 수 x 조각 버퍼)로, 행성 수와 상관없이 일정하다.
+//   - 파일은 .tmp로 쓴 뒤 이름을 바꾼다. (중간에 멈춰도 반쯤 쓴 파일이 남지 않는다)
+// 행성이 끝날 때마다 시간(계산 / 쓰기 ms)을 표준 출력과 <out>/timings.csv에 한 줄씩 쓴다.
+//
+// --cache DIR을 주면 계산한 정점 / 높이를 TileCache(tile_cache.hpp)에 남기고,
+// 같은 입력(seed / scale / radius / 형식 / 해상도)을 다시 요청받으면 노이즈 대신 타일을 mmap해서 쓴다.
+// 계산하면서 타일 매핑에 바로 쓰므로 캐시를 켜도 따로 버퍼가 늘지 않는다.
+//
+// 출력 형식
+//   mesh      : planet_<seed>.ply (binary little-endian, 정점 위치 + 법선, 삼각형)
+//               --resolution N = 정육면체 모서리 분할 수 (정점 6N² + 2개)
+//                                --kind ico이면 이십면체 분할 수 (정점 10N² + 2개)
+//   heightmap : planet_<seed>.pfm (Portable Float Map, 흑백 float32)
+//               --resolution N = 위도 N행 x 경도 2N열 (등장방형)
+//               값은 get_height와 같은 높이(scale 적용, radius 제외)
+//               방향 = (cos(위도) cos(경도), sin(위도), cos(위도) sin(경도)), PFM 규칙대로 아래 행(남극)부터
+//
+// 사용법: planet_gen --seeds FIRST[-LAST] [--format mesh|heightmap] [--resolution N]
+//                    [--scale S] [--radius R] [--kind cube|ico] [--threads N] [--out DIR]
+//                    [--cache DIR] [--cache-mb N]
+//   --threads : 동시에 만들 행성 수 (기본 하드웨어 스레드 수)
+//   --out     : 출력 디렉터리 (기본 planets, 없으면 만든다)
+//   --cache   : 타일 캐시 디렉터리 (없으면 캐시를 쓰지 않는다)
+//   --cache-mb: 타일 캐시 디스크 예산 (MB, 기본 1024, 넘으면 오래 안 쓴 타일부터 지운다)
+//
+// 빌드: CMake (build-native/planet_gen)
+// -------------------------------------------------------------
+
+#include "../cpp/planet.hpp"
+#include "../cpp/sphere_mesh.hpp"
+#include "../cpp/tile_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 한 번에 계산해서 파일에 쓰는 정점 수 (스레드마다 버퍼 하나: 위치 + 법선 + PLY 레코드 ≈ 2.3MB)
+constexpr size_t kChunkVertices = 65536;
+// 파일 쓰기 버퍼 크기
+constexpr size_t kFileBuffer = 1 << 20;
+
+enum class OutputFormat { Mesh, Heightmap };
+
+struct Options {
+    uint32_t firstSeed = 0;
+    uint32_t lastSeed = 0;
+    bool hasSeeds = false;
+    OutputFormat format = OutputFormat::Mesh;
+    int resolution = 256;
+    float scale = 0.5f;
+    float radius = 1.0f;
+    SphereMeshKind kind = SphereMeshKind::CubeSphere;
+    unsigned threads = 0;
+    std::string out = "planets";
+    std::string cache;         // 비어 있으면 캐시 없음
+    uint64_t cacheMegabytes = 1024;
+};
+
+// 모든 행성이 같이 쓰는 단위 구 메쉬
+struct SharedMesh {
+    std::vector<float> directions;   // SoA: xs | ys | zs
+    std::vector<uint8_t> faceRecords; // PLY 삼각형 레코드 [uchar 3, uint32 a, b, c]를 미리 이어 붙인 것
+    size_t vertexCount = 0;
+    size_t faceCount = 0;
+};
+
+// 행성 하나의 결과
+struct PlanetTiming {
+    uint32_t seed;
+    size_t elements; // 정점 수 (mesh) / 화소 수 (heightmap)
+    double generateMs;
+    double writeMs;
+    uint64_t bytes;
+    bool ok;
+    const char* cache; // "-" (캐시 없음) / "hit" / "miss"
+};
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s --seeds FIRST[-LAST] [--format mesh|heightmap] [--resolution N]\n"
+                 "          [--scale S] [--radius R] [--kind cube|ico] [--threads N] [--out DIR]\n"
+                 "          [--cache DIR] [--cache-mb N]\n", argv0);
+}
+
+bool parseSeeds(const char* s, Options& opt) {
+    char* end = nullptr;
+    const unsigned long first = std::strtoul(s, &end, 10);
+    unsigned long last = first;
+    if (end == s) return false;
+    if (*end == '-') {
+        const char* lastText = end + 1;
+        last = std::strtoul(lastText, &end, 10);
+        if (end == lastText) return false;
+    }
+    if (*end != '\0' || last < first || last > 0xffffffffUL) return false;
+    opt.firstSeed = static_cast<uint32_t>(first);
+    opt.lastSeed = static_cast<uint32_t>(last);
+    opt.hasSeeds = true;
+    return true;
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        bool ok = hasValue;
+        if (std::strcmp(a, "--seeds") == 0 && hasValue) ok = parseSeeds(argv[++i], opt);
+        else if (std::strcmp(a, "--format") == 0 && hasValue) {
+            const char* v = argv[++i];
+            if (std::strcmp(v, "mesh") == 0) opt.format = OutputFormat::Mesh;
+            else if (std::strcmp(v, "heightmap") == 0) opt.format = OutputFormat::Heightmap;
+            else ok = false;
+        }
+        else if (std::strcmp(a, "--resolution") == 0 && hasValue) {
+            opt.resolution = std::atoi(argv[++i]);
+            ok = opt.resolution >= 1;
+        }
+        else if (std::strcmp(a, "--scale") == 0 && hasValue) opt.scale = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(a, "--radius") == 0 && hasValue) opt.radius = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(a, "--kind") == 0 && hasValue) {
+            const char* v = argv[++i];
+            if (std::strcmp(v, "cube") == 0) opt.kind = SphereMeshKind::CubeSphere;
+            else if (std::strcmp(v, "ico") == 0) opt.kind = SphereMeshKind::Icosphere;
+            else ok = false;
+        }
+        else if (std::strcmp(a, "--threads") == 0 && hasValue) opt.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(a, "--out") == 0 && hasValue) opt.out = argv[++i];
+        else if (std::strcmp(a, "--cache") == 0 && hasValue) opt.cache = argv[++i];
+        else if (std::strcmp(a, "--cache-mb") == 0 && hasValue) {
+            const long long mb = std::atoll(argv[++i]);
+            opt.cacheMegabytes = static_cast<uint64_t>(mb);
+            ok = mb > 0;
+        }
+        else ok = false;
+        if (!ok) {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    if (!opt.hasSeeds) {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+void buildSharedMesh(const Options& opt, SharedMesh& shared) {
+    SphereMesh mesh;
+    if (opt.kind == SphereMeshKind::CubeSphere) buildCubeSphere(opt.resolution, 1, mesh);
+    else buildIcosphere(opt.resolution, 1, mesh);
+
+    const size_t n = mesh.vertexCount();
+    shared.vertexCount = n;
+    shared.directions.resize(n * 3);
+    for (size_t i = 0; i < n; ++i) {
+        shared.directions[i] = mesh.positions[i * 3];
+        shared.directions[n + i] = mesh.positions[i * 3 + 1];
+        shared.directions[2 * n + i] = mesh.positions[i * 3 + 2];
+    }
+
+    shared.faceCount = mesh.indices.size() / 3;
+    shared.faceRecords.resize(shared.faceCount * 13);
+    uint8_t* rec = shared.faceRecords.data();
+    for (size_t f = 0; f < shared.faceCount; ++f, rec += 13) {
+        rec[0] = 3;
+        std::memcpy(rec + 1, &mesh.indices[f * 3], 3 * sizeof(uint32_t));
+    }
+}
+
+// .tmp 파일을 열고 닫을 때 이름을 바꾸는 출력 파일
+class OutputFile {
+public:
+    explicit OutputFile(const std::string& path) : path_(path), tmpPath_(path + ".tmp") {
+        file_ = std::fopen(tmpPath_.c_str(), "wb");
+        if (file_) std::setvbuf(file_, nullptr, _IOFBF, kFileBuffer);
+    }
+    ~OutputFile() {
+        if (file_) {
+            std::fclose(file_);
+            std::remove(tmpPath_.c_str());
+        }
+    }
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    bool ok() const { return file_ && !failed_; }
+    uint64_t bytes() const { return bytes_; }
+
+    void write(const void* data, size_t size) {
+        if (!ok()) return;
+        if (std::fwrite(data, 1, size, file_) != size) failed_ = true;
+        bytes_ += size;
+    }
+    void print(const std::string& text) { write(text.data(), text.size()); }
+
+    // 다 썼으면 닫고 원래 이름으로 바꾼다.
+    bool commit() {
+        if (!file_) return false;
+        const bool closed = std::fclose(file_) == 0;
+        file_ = nullptr;
+        if (failed_ || !closed || std::rename(tmpPath_.c_str(), path_.c_str()) != 0) {
+            std::remove(tmpPath_.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::string path_;
+    std::string tmpPath_;
+    FILE* file_ = nullptr;
+    bool failed_ = false;
+    uint64_t bytes_ = 0;
+};
+
+// 작업 스레드 하나의 생성기와 조각 버퍼 (행성마다 다시 쓴다)
+struct Worker {
+    PlanetGenerator generator;
+    TerrainLayerCache terrain;  // 조각 하나의 층 값 (kChunkVertices개, 조각마다 다시 채운다)
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> records; // PLY 정점 레코드 [x, y, z, nx, ny, nz, ...]
+    std::vector<float> rowX, rowY, rowZ, rowHeights;
+};
+
+// cache가 있으면 key의 타일을 찾는다. 없으면 floatCount개짜리 새 타일을 writer에 연다.
+// (찾으면 tile, 못 찾으면 writer가 valid, 캐시를 못 쓰면 둘 다 비어 있다)
+void openTile(TileCache* cache, const PlanetGenerator& generator, TileContent content, uint32_t topology,
+              uint32_t resolution, size_t floatCount, MappedTile& tile, TileWriter& writer, PlanetTiming& t) {
+    TileKey key;
+    if (!cache || !makeTileKey(generator, content, topology, resolution, key)) return;
+    tile = cache->lookup(key);
+    if (tile.valid() && tile.floatCount() == floatCount) {
+        t.cache = "hit";
+        return;
+    }
+    tile = MappedTile();
+    t.cache = "miss";
+    writer = cache->create(key, floatCount);
+}
+
+PlanetTiming writeMesh(const Options& opt, const SharedMesh& shared, Worker& w, TileCache* cache,
+                       uint32_t seed, const std::string& path) {
+    PlanetTiming t{ seed, shared.vertexCount, 0.0, 0.0, 0, false, "-" };
+    OutputFile file(path);
+    const size_t n = shared.vertexCount;
+
+    // 타일 = PLY 정점 레코드 그대로 [x, y, z, nx, ny, nz, ...]
+    auto t0 = std::chrono::steady_clock::now();
+    w.generator.init(seed, opt.scale, opt.radius);
+    MappedTile tile;
+    TileWriter writer;
+    openTile(cache, w.generator, TileContent::PositionsNormals, static_cast<uint32_t>(opt.kind),
+             static_cast<uint32_t>(opt.resolution), n * 6, tile, writer, t);
+    t.generateMs += msSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    file.print("ply\nformat binary_little_endian 1.0\n"
+               "comment my little planet seed " + std::to_string(seed) + "\n"
+               "element vertex " + std::to_string(shared.vertexCount) + "\n"
+               "property float x\nproperty float y\nproperty float z\n"
+               "property float nx\nproperty float ny\nproperty float nz\n"
+               "element face " + std::to_string(shared.faceCount) + "\n"
+               "property list uchar uint vertex_indices\nend_header\n");
+    t.writeMs += msSince(t0);
+
+    if (tile.valid()) {
+        t0 = std::chrono::steady_clock::now();
+        file.write(tile.data(), n * 6 * sizeof(float));
+        file.write(shared.faceRecords.data(), shared.faceRecords.size());
+        t.bytes = file.bytes();
+        t.ok = file.commit();
+        t.writeMs += msSince(t0);
+        return t;
+    }
+
+    const float* xs = shared.directions.data();
+    const float* ys = xs + n;
+    const float* zs = ys + n;
+    for (size_t begin = 0; begin < n && file.ok(); begin += kChunkVertices) {
+        const size_t count = std::min(kChunkVertices, n - begin);
+
+        // 세 층을 배치 커널로 채운 뒤 섞는다. (TerrainLod::generateSlot과 같은 순서)
+        t0 = std::chrono::steady_clock::now();
+        w.generator.sampleLayers(kAllTerrainLayers, xs + begin, ys + begin, zs + begin, w.terrain, 0, count);
+        w.generator.shapeLayers(xs + begin, ys + begin, zs + begin, w.terrain,
+                                w.positions.data(), w.normals.data(), 0, count);
+        t.generateMs += msSince(t0);
+
+        // 새 타일이 있으면 레코드를 타일 매핑에 바로 만든다.
+        t0 = std::chrono::steady_clock::now();
+        float* records = writer.valid() ? writer.data() + begin * 6 : w.records.data();
+        float* rec = records;
+        for (size_t i = 0; i < count; ++i, rec += 6) {
+            std::memcpy(rec, &w.positions[i * 3], 3 * sizeof(float));
+            std::memcpy(rec + 3, &w.normals[i * 3], 3 * sizeof(float));
+        }
+        file.write(records, count * 6 * sizeof(float));
+        t.writeMs += msSince(t0);
+    }
+
+    t0 = std::chrono::steady_clock::now();
+    if (writer.valid() && file.ok()) cache->commit(writer);
+    file.write(shared.faceRecords.data(), shared.faceRecords.size());
+    t.bytes = file.bytes();
+    t.ok = file.commit();
+    t.writeMs += msSince(t0);
+    return t;
+}
+
+// 높이 지도 타일의 topology 번호 (메쉬는 SphereMeshKind)
+constexpr uint32_t kEquirectTopology = 0x100;
+
+PlanetTiming writeHeightmap(const Options& opt, Worker& w, TileCache* cache, uint32_t seed,
+                            const std::string& path) {
+    const size_t rows = static_cast<size_t>(opt.resolution);
+    const size_t cols = rows * 2;
+    PlanetTiming t{ seed, rows * cols, 0.0, 0.0, 0, false, "-" };
+    OutputFile file(path);
+
+    // 타일 = PFM 본문 그대로 (아래 행부터 rows x cols 높이)
+    auto t0 = std::chrono::steady_clock::now();
+    w.generator.init(seed, opt.scale, opt.radius);
+    MappedTile tile;
+    TileWriter writer;
+    openTile(cache, w.generator, TileContent::Heights, kEquirectTopology,
+             static_cast<uint32_t>(opt.resolution), rows * cols, tile, writer, t);
+    t.generateMs += msSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    // 배율이 음수면 little-endian
+    file.print("Pf\n" + std::to_string(cols) + " " + std::to_string(rows) + "\n-1.0\n");
+    if (tile.valid()) {
+        file.write(tile.data(), rows * cols * sizeof(float));
+        t.bytes = file.bytes();
+        t.ok = file.commit();
+        t.writeMs += msSince(t0);
+        return t;
+    }
+    t.writeMs += msSince(t0);
+
+    const double pi = 3.14159265358979323846;
+    for (size_t r = 0; r < rows && file.ok(); ++r) {
+        t0 = std::chrono::steady_clock::now();
+        const double lat = -0.5 * pi + (static_cast<double>(r) + 0.5) / static_cast<double>(rows) * pi;
+        const double cosLat = std::cos(lat);
+        const float y = static_cast<float>(std::sin(lat));
+        for (size_t c = 0; c < cols; ++c) {
+            const double lon = -pi + (static_cast<double>(c) + 0.5) / static_cast<double>(cols) * 2.0 * pi;
+            w.rowX[c] = static_cast<float>(cosLat * std::cos(lon));
+            w.rowY[c] = y;
+            w.rowZ[c] = static_cast<float>(cosLat * std::sin(lon));
+        }
+        float* heights = writer.valid() ? writer.data() + r * cols : w.rowHeights.data();
+        w.generator.heightBatchUnit(w.rowX.data(), w.rowY.data(), w.rowZ.data(), heights, cols);
+        t.generateMs += msSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        file.write(heights, cols * sizeof(float));
+        t.writeMs += msSince(t0);
+    }
+
+    t0 = std::chrono::steady_clock::now();
+    if (writer.valid() && file.ok()) cache->commit(writer);
+    t.bytes = file.bytes();
+    t.ok = file.commit();
+    t.writeMs += msSince(t0);
+    return t;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    std::error_code ec;
+    std::filesystem::create_directories(opt.out, ec);
+    if (ec) {
+        std::fprintf(stderr, "cannot create %s: %s\n", opt.out.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    std::unique_ptr<TileCache> cache;
+    if (!opt.cache.empty()) {
+        cache.reset(new TileCache(opt.cache, opt.cacheMegabytes * 1024 * 1024));
+        if (!cache->ok()) {
+            std::fprintf(stderr, "cannot use cache directory %s\n", opt.cache.c_str());
+            return 1;
+        }
+    }
+
+    FILE* csv = std::fopen((opt.out + "/timings.csv").c_str(), "w");
+    if (!csv) {
+        std::fprintf(stderr, "cannot write %s/timings.csv\n", opt.out.c_str());
+        return 1;
+    }
+    std::fprintf(csv, "seed,file,elements,generate_ms,write_ms,bytes,cache,ok\n");
+
+    const uint64_t planetCount = static_cast<uint64_t>(opt.lastSeed) - opt.firstSeed + 1;
+    unsigned threads = opt.threads ? opt.threads : ThreadPool::hardwareThreads();
+    threads = static_cast<unsigned>(std::min<uint64_t>(threads, planetCount));
+
+    const bool mesh = opt.format == OutputFormat::Mesh;
+    auto t0 = std::chrono::steady_clock::now();
+    SharedMesh shared;
+    if (mesh) buildSharedMesh(opt, shared);
+    const double setupMs = msSince(t0);
+
+    std::printf("%llu planets, %s, resolution %d (%zu %s), scale %g, radius %g, %u threads\n",
+                static_cast<unsigned long long>(planetCount), mesh ? "mesh" : "heightmap", opt.resolution,
+                mesh ? shared.vertexCount : static_cast<size_t>(opt.resolution) * opt.resolution * 2,
+                mesh ? "vertices" : "pixels", opt.scale, opt.radius, threads);
+    if (mesh) std::printf("shared mesh: %zu vertices, %zu triangles (%.1f ms)\n",
+                          shared.vertexCount, shared.faceCount, setupMs);
+    if (cache) {
+        const TileCache::Stats s = cache->stats();
+        std::printf("tile cache: %s, %zu tiles, %.1f / %llu MB\n", opt.cache.c_str(), s.tiles,
+                    static_cast<double>(s.diskBytes) / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(opt.cacheMegabytes));
+    }
+    std::printf("%10s %12s %12s %10s %10s %6s\n", "seed", "elements", "generate ms", "write ms", "MB", "cache");
+
+    std::atomic<uint64_t> next{0};
+    std::atomic<uint64_t> failures{0};
+    std::mutex reportMutex;
+    const auto start = std::chrono::steady_clock::now();
+
+    auto work = [&] {
+        Worker w;
+        if (mesh) {
+            w.terrain.resize(kChunkVertices);
+            w.positions.resize(kChunkVertices * 3);
+            w.normals.resize(kChunkVertices * 3);
+            w.records.resize(kChunkVertices * 6);
+        } else {
+            const size_t cols = static_cast<size_t>(opt.resolution) * 2;
+            w.rowX.resize(cols);
+            w.rowY.resize(cols);
+            w.rowZ.resize(cols);
+            w.rowHeights.resize(cols);
+        }
+        for (uint64_t i = next.fetch_add(1); i < planetCount; i = next.fetch_add(1)) {
+            const uint32_t seed = static_cast<uint32_t>(opt.firstSeed + i);
+            const std::string name = "planet_" + std::to_string(seed) + (mesh ? ".ply" : ".pfm");
+            const std::string path = opt.out + "/" + name;
+            const PlanetTiming t = mesh ? writeMesh(opt, shared, w, cache.get(), seed, path)
+                                        : writeHeightmap(opt, w, cache.get(), seed, path);
+            if (!t.ok) failures.fetch_add(1);
+
+            std::lock_guard<std::mutex> lock(reportMutex);
+            std::printf("%10u %12zu %12.2f %10.2f %10.2f %6s%s\n", t.seed, t.elements, t.generateMs, t.writeMs,
+                        static_cast<double>(t.bytes) / (1024.0 * 1024.0), t.cache, t.ok ? "" : "  FAILED");
+            std::fprintf(csv, "%u,%s,%zu,%.3f,%.3f,%llu,%s,%d\n", t.seed, name.c_str(), t.elements,
+                         t.generateMs, t.writeMs, static_cast<unsigned long long>(t.bytes), t.cache, t.ok ? 1 : 0);
+            std::fflush(stdout);
+            std::fflush(csv);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) pool.emplace_back(work);
+    work();
+    for (auto& th : pool) th.join();
+
+    const double totalMs = msSince(start);
+    std::fclose(csv);
+    std::printf("done: %llu planets in %.1f ms (%.2f planets / s), %llu failed\n",
+                static_cast<unsigned long long>(planetCount), totalMs,
+                static_cast<double>(planetCount) * 1000.0 / totalMs,
+                static_cast<unsigned long long>(failures.load()));
+    if (cache) {
+        const TileCache::Stats s = cache->stats();
+        std::printf("tile cache: %llu hits, %llu misses, %llu stored, %llu evicted, %zu tiles, %.1f MB\n",
+                    static_cast<unsigned long long>(s.hits), static_cast<unsigned long long>(s.misses),
+                    static_cast<unsigned long long>(s.stores), static_cast<unsigned long long>(s.evictions),
+                    s.tiles, static_cast<double>(s.diskBytes) / (1024.0 * 1024.0));
+    }
+    return failures.load() == 0 ? 0 : 1;
+}